@@ -0,0 +1,20 @@
+# slang_add_native_executable(<target> <script>)
+#
+# Translates <script> to C++ with `slang --emit-cpp` at build time and
+# builds the result into the native executable <target>, linked against
+# the slangrt runtime library.
+function(slang_add_native_executable target script)
+  get_filename_component(script_path ${script} ABSOLUTE)
+  set(cpp_path ${CMAKE_CURRENT_BINARY_DIR}/${target}.slang.cpp)
+
+  add_custom_command(
+    OUTPUT ${cpp_path}
+    COMMAND slang --emit-cpp ${script_path} ${cpp_path}
+    DEPENDS slang ${script_path}
+    COMMENT "Translating ${script} to C++"
+    VERBATIM
+  )
+
+  add_executable(${target} ${cpp_path})
+  target_link_libraries(${target} PRIVATE slangrt)
+endfunction()
@@ -0,0 +1,590 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ArrayKernels.hpp"
+
+namespace slang {
+
+namespace bulk {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/// Combines the 8 partial sums of a float64 reduction the way the
+/// vector versions do, lane i with lane i + 4, then the halves crosswise.
+static double combine(const double (&lanes)[8]) {
+  double s0 = lanes[0] + lanes[4];
+  double s1 = lanes[1] + lanes[5];
+  double s2 = lanes[2] + lanes[6];
+  double s3 = lanes[3] + lanes[7];
+  return (s0 + s2) + (s1 + s3);
+}
+
+#if defined(__SSE2__)
+/// Sum of the two lanes of @v.
+static double horizontal_sum(__m128d v) {
+  return _mm_cvtsd_f64(v) + _mm_cvtsd_f64(_mm_unpackhi_pd(v, v));
+}
+
+/// 1 in the lanes of @mask that are all ones, 0 in the others.
+static __m128i to_flags(__m128d mask) {
+  return _mm_and_si128(_mm_castpd_si128(mask), _mm_set1_epi64x(1));
+}
+#endif
+
+} // namespace helpers
+
+// ------------------------ | SCALAR |
+namespace scalar {
+
+double sum_f64(const double* values, std::size_t count) {
+  double lanes[8] = {};
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    for (std::size_t lane = 0; lane < 8; ++lane) {
+      lanes[lane] += values[i + lane];
+    }
+  }
+
+  double total = helpers::combine(lanes);
+  for (; i < count; ++i) total += values[i];
+  return total;
+}
+
+bool sum_i64(const std::int64_t* values, std::size_t count, std::int64_t& result) {
+  // the wrapped total is exact once the wraps are counted,
+  // whatever the order of the elements
+  std::int64_t total = 0;
+  std::int64_t wraps = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (__builtin_add_overflow(total, values[i], &total)) {
+      wraps += values[i] < 0 ? -1 : 1;
+    }
+  }
+
+  result = total;
+  return wraps == 0;
+}
+
+double min_f64(const double* values, std::size_t count) {
+  double best = values[0];
+  bool nan = false;
+  for (std::size_t i = 0; i < count; ++i) {
+    nan |= std::isnan(values[i]);
+    best = values[i] < best ? values[i] : best;
+  }
+
+  return nan ? helpers::NaN : best;
+}
+
+double max_f64(const double* values, std::size_t count) {
+  double best = values[0];
+  bool nan = false;
+  for (std::size_t i = 0; i < count; ++i) {
+    nan |= std::isnan(values[i]);
+    best = values[i] > best ? values[i] : best;
+  }
+
+  return nan ? helpers::NaN : best;
+}
+
+std::int64_t min_i64(const std::int64_t* values, std::size_t count) {
+  std::int64_t best = values[0];
+  for (std::size_t i = 1; i < count; ++i) {
+    best = values[i] < best ? values[i] : best;
+  }
+
+  return best;
+}
+
+std::int64_t max_i64(const std::int64_t* values, std::size_t count) {
+  std::int64_t best = values[0];
+  for (std::size_t i = 1; i < count; ++i) {
+    best = values[i] > best ? values[i] : best;
+  }
+
+  return best;
+}
+
+double dot_f64(const double* left, const double* right, std::size_t count) {
+  double lanes[8] = {};
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    for (std::size_t lane = 0; lane < 8; ++lane) {
+      lanes[lane] += left[i + lane] * right[i + lane];
+    }
+  }
+
+  double total = helpers::combine(lanes);
+  for (; i < count; ++i) total += left[i] * right[i];
+  return total;
+}
+
+void add_f64(const double* left, const double* right, double* out, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) out[i] = left[i] + right[i];
+}
+
+bool add_i64(const std::int64_t* left, const std::int64_t* right, std::int64_t* out,
+             std::size_t count) {
+  bool overflow = false;
+  for (std::size_t i = 0; i < count; ++i) {
+    overflow |= __builtin_add_overflow(left[i], right[i], &out[i]);
+  }
+
+  return !overflow;
+}
+
+void mul_f64(const double* left, const double* right, double* out, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) out[i] = left[i] * right[i];
+}
+
+void scale_f64(const double* values, double factor, double* out, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) out[i] = values[i] * factor;
+}
+
+void greater_f64(const double* values, double bound, std::int64_t* out, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) out[i] = values[i] > bound;
+}
+
+void greater_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+                 std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) out[i] = values[i] > bound;
+}
+
+void less_f64(const double* values, double bound, std::int64_t* out, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) out[i] = values[i] < bound;
+}
+
+void less_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+              std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) out[i] = values[i] < bound;
+}
+
+std::size_t filter_f64(const double* values, const std::int64_t* mask, double* out,
+                       std::size_t count) {
+  // writes every element and keeps the masked ones, so there is no branch to mispredict
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    out[kept] = values[i];
+    kept += mask[i] != 0;
+  }
+
+  return kept;
+}
+
+std::size_t filter_i64(const std::int64_t* values, const std::int64_t* mask,
+                       std::int64_t* out, std::size_t count) {
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    out[kept] = values[i];
+    kept += mask[i] != 0;
+  }
+
+  return kept;
+}
+
+} // namespace scalar
+
+// ------------------------ | SSE2 |
+#if defined(__SSE2__)
+namespace sse2 {
+
+static double sum_f64(const double* values, std::size_t count) {
+  // lanes 0-1, 2-3, 4-5 and 6-7 of the scalar version
+  __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+  __m128d acc2 = _mm_setzero_pd(), acc3 = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    acc0 = _mm_add_pd(acc0, _mm_loadu_pd(values + i));
+    acc1 = _mm_add_pd(acc1, _mm_loadu_pd(values + i + 2));
+    acc2 = _mm_add_pd(acc2, _mm_loadu_pd(values + i + 4));
+    acc3 = _mm_add_pd(acc3, _mm_loadu_pd(values + i + 6));
+  }
+
+  double total = helpers::horizontal_sum(
+      _mm_add_pd(_mm_add_pd(acc0, acc2), _mm_add_pd(acc1, acc3)));
+  for (; i < count; ++i) total += values[i];
+  return total;
+}
+
+static bool sum_i64(const std::int64_t* values, std::size_t count, std::int64_t& result) {
+  __m128i acc = _mm_setzero_si128();
+  __m128i overflow = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+    __m128i next = _mm_add_epi64(acc, v);
+    // the sign flips away from both operands only on an overflow
+    overflow = _mm_or_si128(overflow, _mm_and_si128(_mm_xor_si128(acc, next),
+                                                    _mm_xor_si128(v, next)));
+    acc = next;
+  }
+
+  std::int64_t lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+  std::int64_t total = 0;
+  bool wrapped = _mm_movemask_pd(_mm_castsi128_pd(overflow)) != 0
+                 || __builtin_add_overflow(lanes[0], lanes[1], &total);
+  for (; i < count && !wrapped; ++i) {
+    wrapped = __builtin_add_overflow(total, values[i], &total);
+  }
+
+  // a partial sum can overflow while the whole one fits
+  if (wrapped) return scalar::sum_i64(values, count, result);
+
+  result = total;
+  return true;
+}
+
+static double min_f64(const double* values, std::size_t count) {
+  __m128d best = _mm_set1_pd(values[0]);
+  __m128d nan = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m128d v = _mm_loadu_pd(values + i);
+    nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+    best = _mm_min_pd(v, best);
+  }
+
+  double lanes[2];
+  _mm_storeu_pd(lanes, best);
+  double result = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+  if (_mm_movemask_pd(nan) != 0) return helpers::NaN;
+
+  for (; i < count; ++i) {
+    if (std::isnan(values[i])) return helpers::NaN;
+    result = values[i] < result ? values[i] : result;
+  }
+
+  return result;
+}
+
+static double max_f64(const double* values, std::size_t count) {
+  __m128d best = _mm_set1_pd(values[0]);
+  __m128d nan = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m128d v = _mm_loadu_pd(values + i);
+    nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+    best = _mm_max_pd(v, best);
+  }
+
+  double lanes[2];
+  _mm_storeu_pd(lanes, best);
+  double result = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+  if (_mm_movemask_pd(nan) != 0) return helpers::NaN;
+
+  for (; i < count; ++i) {
+    if (std::isnan(values[i])) return helpers::NaN;
+    result = values[i] > result ? values[i] : result;
+  }
+
+  return result;
+}
+
+static double dot_f64(const double* left, const double* right, std::size_t count) {
+  __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+  __m128d acc2 = _mm_setzero_pd(), acc3 = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(left + i), _mm_loadu_pd(right + i)));
+    acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(left + i + 2),
+                                       _mm_loadu_pd(right + i + 2)));
+    acc2 = _mm_add_pd(acc2, _mm_mul_pd(_mm_loadu_pd(left + i + 4),
+                                       _mm_loadu_pd(right + i + 4)));
+    acc3 = _mm_add_pd(acc3, _mm_mul_pd(_mm_loadu_pd(left + i + 6),
+                                       _mm_loadu_pd(right + i + 6)));
+  }
+
+  double total = helpers::horizontal_sum(
+      _mm_add_pd(_mm_add_pd(acc0, acc2), _mm_add_pd(acc1, acc3)));
+  for (; i < count; ++i) total += left[i] * right[i];
+  return total;
+}
+
+static void add_f64(const double* left, const double* right, double* out, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(left + i), _mm_loadu_pd(right + i)));
+  }
+
+  scalar::add_f64(left + i, right + i, out + i, count - i);
+}
+
+static bool add_i64(const std::int64_t* left, const std::int64_t* right, std::int64_t* out,
+                    std::size_t count) {
+  __m128i overflow = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i));
+    __m128i sum = _mm_add_epi64(a, b);
+    overflow = _mm_or_si128(overflow, _mm_and_si128(_mm_xor_si128(a, sum),
+                                                    _mm_xor_si128(b, sum)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), sum);
+  }
+
+  return _mm_movemask_pd(_mm_castsi128_pd(overflow)) == 0
+         && scalar::add_i64(left + i, right + i, out + i, count - i);
+}
+
+static void mul_f64(const double* left, const double* right, double* out, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(left + i), _mm_loadu_pd(right + i)));
+  }
+
+  scalar::mul_f64(left + i, right + i, out + i, count - i);
+}
+
+static void scale_f64(const double* values, double factor, double* out, std::size_t count) {
+  __m128d f = _mm_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(values + i), f));
+  }
+
+  scalar::scale_f64(values + i, factor, out + i, count - i);
+}
+
+static void greater_f64(const double* values, double bound, std::int64_t* out,
+                        std::size_t count) {
+  __m128d b = _mm_set1_pd(bound);
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     helpers::to_flags(_mm_cmpgt_pd(_mm_loadu_pd(values + i), b)));
+  }
+
+  scalar::greater_f64(values + i, bound, out + i, count - i);
+}
+
+static void less_f64(const double* values, double bound, std::int64_t* out,
+                     std::size_t count) {
+  __m128d b = _mm_set1_pd(bound);
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     helpers::to_flags(_mm_cmplt_pd(_mm_loadu_pd(values + i), b)));
+  }
+
+  scalar::less_f64(values + i, bound, out + i, count - i);
+}
+
+} // namespace sse2
+#endif
+
+// ------------------------ | DISPATCH |
+namespace helpers {
+
+struct Kernels {
+  const char* m_name;
+  double (*m_sum_f64)(const double*, std::size_t);
+  bool (*m_sum_i64)(const std::int64_t*, std::size_t, std::int64_t&);
+  double (*m_min_f64)(const double*, std::size_t);
+  double (*m_max_f64)(const double*, std::size_t);
+  std::int64_t (*m_min_i64)(const std::int64_t*, std::size_t);
+  std::int64_t (*m_max_i64)(const std::int64_t*, std::size_t);
+  double (*m_dot_f64)(const double*, const double*, std::size_t);
+  void (*m_add_f64)(const double*, const double*, double*, std::size_t);
+  bool (*m_add_i64)(const std::int64_t*, const std::int64_t*, std::int64_t*, std::size_t);
+  void (*m_mul_f64)(const double*, const double*, double*, std::size_t);
+  void (*m_scale_f64)(const double*, double, double*, std::size_t);
+  void (*m_greater_f64)(const double*, double, std::int64_t*, std::size_t);
+  void (*m_greater_i64)(const std::int64_t*, std::int64_t, std::int64_t*, std::size_t);
+  void (*m_less_f64)(const double*, double, std::int64_t*, std::size_t);
+  void (*m_less_i64)(const std::int64_t*, std::int64_t, std::int64_t*, std::size_t);
+  std::size_t (*m_filter_f64)(const double*, const std::int64_t*, double*, std::size_t);
+  std::size_t (*m_filter_i64)(const std::int64_t*, const std::int64_t*, std::int64_t*,
+                              std::size_t);
+};
+
+static const Kernels SCALAR = {
+  "scalar", scalar::sum_f64, scalar::sum_i64, scalar::min_f64, scalar::max_f64,
+  scalar::min_i64, scalar::max_i64, scalar::dot_f64, scalar::add_f64, scalar::add_i64,
+  scalar::mul_f64, scalar::scale_f64, scalar::greater_f64, scalar::greater_i64,
+  scalar::less_f64, scalar::less_i64, scalar::filter_f64, scalar::filter_i64
+};
+
+/// Picks the widest kernels the CPU runs, unless SLANG_ARRAY_KERNELS
+/// asks for narrower ones ("sse2" or "scalar") to compare them.
+static Kernels select_kernels() {
+  const char* requested = std::getenv("SLANG_ARRAY_KERNELS");
+  std::string_view name = requested != nullptr ? requested : "";
+
+  if (name == "scalar") return SCALAR;
+
+#ifdef SLANG_HAVE_AVX2
+  // runs from a static initializer
+  __builtin_cpu_init();
+  if (name != "sse2" && __builtin_cpu_supports("avx2")) {
+    return { "avx2", avx2::sum_f64, avx2::sum_i64, avx2::min_f64, avx2::max_f64,
+             avx2::min_i64, avx2::max_i64, avx2::dot_f64, avx2::add_f64, avx2::add_i64,
+             avx2::mul_f64, avx2::scale_f64, avx2::greater_f64, avx2::greater_i64,
+             avx2::less_f64, avx2::less_i64, avx2::filter_f64, avx2::filter_i64 };
+  }
+#endif
+
+#if defined(__SSE2__)
+  // SSE2 has no 64-bit integer compare, those stay scalar
+  return { "sse2", sse2::sum_f64, sse2::sum_i64, sse2::min_f64, sse2::max_f64,
+           scalar::min_i64, scalar::max_i64, sse2::dot_f64, sse2::add_f64, sse2::add_i64,
+           sse2::mul_f64, sse2::scale_f64, sse2::greater_f64, scalar::greater_i64,
+           sse2::less_f64, scalar::less_i64, scalar::filter_f64, scalar::filter_i64 };
+#else
+  return SCALAR;
+#endif
+}
+
+static const Kernels s_kernels = select_kernels();
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+double sum_f64(const double* values, std::size_t count) {
+  return helpers::s_kernels.m_sum_f64(values, count);
+}
+
+bool sum_i64(const std::int64_t* values, std::size_t count, std::int64_t& result) {
+  return helpers::s_kernels.m_sum_i64(values, count, result);
+}
+
+double min_f64(const double* values, std::size_t count) {
+  return helpers::s_kernels.m_min_f64(values, count);
+}
+
+double max_f64(const double* values, std::size_t count) {
+  return helpers::s_kernels.m_max_f64(values, count);
+}
+
+std::int64_t min_i64(const std::int64_t* values, std::size_t count) {
+  return helpers::s_kernels.m_min_i64(values, count);
+}
+
+std::int64_t max_i64(const std::int64_t* values, std::size_t count) {
+  return helpers::s_kernels.m_max_i64(values, count);
+}
+
+double dot_f64(const double* left, const double* right, std::size_t count) {
+  return helpers::s_kernels.m_dot_f64(left, right, count);
+}
+
+bool dot_i64(const std::int64_t* left, const std::int64_t* right, std::size_t count,
+             std::int64_t& result) {
+  // there is no 64-bit vector multiply before AVX-512
+  std::int64_t total = 0;
+  std::int64_t wraps = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::int64_t product;
+    if (__builtin_mul_overflow(left[i], right[i], &product)) return false;
+
+    if (__builtin_add_overflow(total, product, &total)) {
+      wraps += product < 0 ? -1 : 1;
+    }
+  }
+
+  result = total;
+  return wraps == 0;
+}
+
+void add_f64(const double* left, const double* right, double* out, std::size_t count) {
+  helpers::s_kernels.m_add_f64(left, right, out, count);
+}
+
+bool add_i64(const std::int64_t* left, const std::int64_t* right, std::int64_t* out,
+             std::size_t count) {
+  return helpers::s_kernels.m_add_i64(left, right, out, count);
+}
+
+void mul_f64(const double* left, const double* right, double* out, std::size_t count) {
+  helpers::s_kernels.m_mul_f64(left, right, out, count);
+}
+
+bool mul_i64(const std::int64_t* left, const std::int64_t* right, std::int64_t* out,
+             std::size_t count) {
+  bool overflow = false;
+  for (std::size_t i = 0; i < count; ++i) {
+    overflow |= __builtin_mul_overflow(left[i], right[i], &out[i]);
+  }
+
+  return !overflow;
+}
+
+void scale_f64(const double* values, double factor, double* out, std::size_t count) {
+  helpers::s_kernels.m_scale_f64(values, factor, out, count);
+}
+
+bool scale_i64(const std::int64_t* values, std::int64_t factor, std::int64_t* out,
+               std::size_t count) {
+  bool overflow = false;
+  for (std::size_t i = 0; i < count; ++i) {
+    overflow |= __builtin_mul_overflow(values[i], factor, &out[i]);
+  }
+
+  return !overflow;
+}
+
+void prefix_sum_f64(const double* values, double* out, std::size_t count) {
+  // a vector scan would round the totals differently from a loop
+  double total = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    total += values[i];
+    out[i] = total;
+  }
+}
+
+bool prefix_sum_i64(const std::int64_t* values, std::int64_t* out, std::size_t count) {
+  std::int64_t total = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (__builtin_add_overflow(total, values[i], &total)) return false;
+    out[i] = total;
+  }
+
+  return true;
+}
+
+void greater_f64(const double* values, double bound, std::int64_t* out, std::size_t count) {
+  helpers::s_kernels.m_greater_f64(values, bound, out, count);
+}
+
+void greater_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+                 std::size_t count) {
+  helpers::s_kernels.m_greater_i64(values, bound, out, count);
+}
+
+void less_f64(const double* values, double bound, std::int64_t* out, std::size_t count) {
+  helpers::s_kernels.m_less_f64(values, bound, out, count);
+}
+
+void less_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+              std::size_t count) {
+  helpers::s_kernels.m_less_i64(values, bound, out, count);
+}
+
+std::size_t filter_f64(const double* values, const std::int64_t* mask, double* out,
+                       std::size_t count) {
+  return helpers::s_kernels.m_filter_f64(values, mask, out, count);
+}
+
+std::size_t filter_i64(const std::int64_t* values, const std::int64_t* mask,
+                       std::int64_t* out, std::size_t count) {
+  return helpers::s_kernels.m_filter_i64(values, mask, out, count);
+}
+
+const char* kernel_name() {
+  return helpers::s_kernels.m_name;
+}
+
+} // namespace bulk
+
+} // namespace slang
@@ -0,0 +1,136 @@
+#ifndef __SLANG_ARRAY_KERNELS_HPP__
+#define __SLANG_ARRAY_KERNELS_HPP__
+
+#include <cstddef>
+#include <cstdint>
+
+namespace slang {
+
+/// Bulk operations over the elements of typed arrays, 4 at a time with
+/// AVX2 or 2 with SSE2 when the CPU has them, one at a time otherwise.
+///
+/// Every version adds the elements of a float64 sum or dot product in the
+/// same order, in 8 interleaved partial sums, so results do not depend on
+/// the CPU. The int64 versions report an overflow instead of wrapping
+/// around, the caller then redoes the operation in doubles.
+namespace bulk {
+
+/// Sum of the @count elements of @values.
+double sum_f64(const double* values, std::size_t count);
+/// False if the sum does not fit in 64 bits.
+bool sum_i64(const std::int64_t* values, std::size_t count, std::int64_t& result);
+
+/// Smallest and largest element of @count > 0 elements,
+/// NaN if any of them is NaN.
+double min_f64(const double* values, std::size_t count);
+double max_f64(const double* values, std::size_t count);
+std::int64_t min_i64(const std::int64_t* values, std::size_t count);
+std::int64_t max_i64(const std::int64_t* values, std::size_t count);
+
+/// Sum of the products of the elements of @left and @right.
+double dot_f64(const double* left, const double* right, std::size_t count);
+/// False if a product or the sum does not fit in 64 bits.
+bool dot_i64(const std::int64_t* left, const std::int64_t* right, std::size_t count,
+             std::int64_t& result);
+
+/// Elementwise @left + @right, @left * @right and @values * @factor into @out,
+/// which may be one of the inputs. The int64 versions return false if an
+/// element does not fit in 64 bits, leaving @out partly written.
+void add_f64(const double* left, const double* right, double* out, std::size_t count);
+bool add_i64(const std::int64_t* left, const std::int64_t* right, std::int64_t* out,
+             std::size_t count);
+void mul_f64(const double* left, const double* right, double* out, std::size_t count);
+bool mul_i64(const std::int64_t* left, const std::int64_t* right, std::int64_t* out,
+             std::size_t count);
+void scale_f64(const double* values, double factor, double* out, std::size_t count);
+bool scale_i64(const std::int64_t* values, std::int64_t factor, std::int64_t* out,
+               std::size_t count);
+
+/// Running totals of @values into @out, in the order of the elements.
+/// The int64 version returns false if a total does not fit in 64 bits.
+void prefix_sum_f64(const double* values, double* out, std::size_t count);
+bool prefix_sum_i64(const std::int64_t* values, std::int64_t* out, std::size_t count);
+
+/// 1 into @out for the elements of @values greater, or less, than @bound,
+/// 0 for the others.
+void greater_f64(const double* values, double bound, std::int64_t* out, std::size_t count);
+void greater_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+                 std::size_t count);
+void less_f64(const double* values, double bound, std::int64_t* out, std::size_t count);
+void less_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+              std::size_t count);
+
+/// Copies the elements of @values whose @mask element is not 0 to @out,
+/// in order, and returns how many it copied.
+std::size_t filter_f64(const double* values, const std::int64_t* mask, double* out,
+                       std::size_t count);
+std::size_t filter_i64(const std::int64_t* values, const std::int64_t* mask,
+                       std::int64_t* out, std::size_t count);
+
+/// Instruction set the operations use: "avx2", "sse2" or "scalar".
+const char* kernel_name();
+
+/// Element at a time versions, also used for the tails shorter than a block
+/// and for the operations no instruction set speeds up.
+namespace scalar {
+
+double sum_f64(const double* values, std::size_t count);
+bool sum_i64(const std::int64_t* values, std::size_t count, std::int64_t& result);
+double min_f64(const double* values, std::size_t count);
+double max_f64(const double* values, std::size_t count);
+std::int64_t min_i64(const std::int64_t* values, std::size_t count);
+std::int64_t max_i64(const std::int64_t* values, std::size_t count);
+double dot_f64(const double* left, const double* right, std::size_t count);
+void add_f64(const double* left, const double* right, double* out, std::size_t count);
+bool add_i64(const std::int64_t* left, const std::int64_t* right, std::int64_t* out,
+             std::size_t count);
+void mul_f64(const double* left, const double* right, double* out, std::size_t count);
+void scale_f64(const double* values, double factor, double* out, std::size_t count);
+void greater_f64(const double* values, double bound, std::int64_t* out, std::size_t count);
+void greater_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+                 std::size_t count);
+void less_f64(const double* values, double bound, std::int64_t* out, std::size_t count);
+void less_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+              std::size_t count);
+std::size_t filter_f64(const double* values, const std::int64_t* mask, double* out,
+                       std::size_t count);
+std::size_t filter_i64(const std::int64_t* values, const std::int64_t* mask,
+                       std::int64_t* out, std::size_t count);
+
+} // namespace scalar
+
+#ifdef SLANG_HAVE_AVX2
+/// Built with -mavx2, only called when the CPU supports it.
+namespace avx2 {
+
+double sum_f64(const double* values, std::size_t count);
+bool sum_i64(const std::int64_t* values, std::size_t count, std::int64_t& result);
+double min_f64(const double* values, std::size_t count);
+double max_f64(const double* values, std::size_t count);
+std::int64_t min_i64(const std::int64_t* values, std::size_t count);
+std::int64_t max_i64(const std::int64_t* values, std::size_t count);
+double dot_f64(const double* left, const double* right, std::size_t count);
+void add_f64(const double* left, const double* right, double* out, std::size_t count);
+bool add_i64(const std::int64_t* left, const std::int64_t* right, std::int64_t* out,
+             std::size_t count);
+void mul_f64(const double* left, const double* right, double* out, std::size_t count);
+void scale_f64(const double* values, double factor, double* out, std::size_t count);
+void greater_f64(const double* values, double bound, std::int64_t* out, std::size_t count);
+void greater_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+                 std::size_t count);
+void less_f64(const double* values, double bound, std::int64_t* out, std::size_t count);
+void less_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+              std::size_t count);
+std::size_t filter_f64(const double* values, const std::int64_t* mask, double* out,
+                       std::size_t count);
+std::size_t filter_i64(const std::int64_t* values, const std::int64_t* mask,
+                       std::int64_t* out, std::size_t count);
+
+} // namespace avx2
+#endif
+
+} // namespace bulk
+
+} // namespace slang
+
+#endif // !__SLANG_ARRAY_KERNELS_HPP__
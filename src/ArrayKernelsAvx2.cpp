@@ -0,0 +1,341 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <immintrin.h>
+
+#include "ArrayKernels.hpp"
+
+namespace slang {
+
+namespace bulk {
+
+namespace avx2 {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+static constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/// Sum of the four lanes of @v, the low half plus the high half first,
+/// as in the scalar version.
+static double horizontal_sum(__m256d v) {
+  __m128d halves = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(halves) + _mm_cvtsd_f64(_mm_unpackhi_pd(halves, halves));
+}
+
+static bool any_sign(__m256i v) {
+  return _mm256_movemask_pd(_mm256_castsi256_pd(v)) != 0;
+}
+
+/// 1 in the lanes of @mask that are all ones, 0 in the others.
+static __m256i to_flags(__m256i mask) {
+  return _mm256_and_si256(mask, _mm256_set1_epi64x(1));
+}
+
+/// For each 4-bit mask of lanes to keep, the 32-bit permutation
+/// that moves those lanes to the front.
+struct Compaction {
+  alignas(32) std::int32_t m_indexes[16][8];
+
+  Compaction() : m_indexes{} {
+    for (int keep = 0; keep < 16; ++keep) {
+      int to = 0;
+      for (int lane = 0; lane < 4; ++lane) {
+        if ((keep & (1 << lane)) == 0) continue;
+
+        m_indexes[keep][2 * to] = 2 * lane;
+        m_indexes[keep][2 * to + 1] = 2 * lane + 1;
+        ++to;
+      }
+    }
+  }
+};
+
+static const Compaction s_compaction{};
+
+/// Copies the lanes of the 4 values at @values whose @mask is not 0 to @out,
+/// and returns how many. Writes all 4 lanes of @out.
+static int compact(const void* values, const std::int64_t* mask, void* out) {
+  __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask));
+  int dropped = _mm256_movemask_pd(_mm256_castsi256_pd(
+      _mm256_cmpeq_epi64(m, _mm256_setzero_si256())));
+  int keep = ~dropped & 0xF;
+
+  __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+  __m256i indexes = _mm256_load_si256(
+      reinterpret_cast<const __m256i*>(s_compaction.m_indexes[keep]));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                      _mm256_permutevar8x32_epi32(v, indexes));
+  return __builtin_popcount(keep);
+}
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+double sum_f64(const double* values, std::size_t count) {
+  // lanes 0-3 and 4-7 of the scalar version
+  __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(values + i));
+    acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(values + i + 4));
+  }
+
+  double total = helpers::horizontal_sum(_mm256_add_pd(acc0, acc1));
+  for (; i < count; ++i) total += values[i];
+  return total;
+}
+
+bool sum_i64(const std::int64_t* values, std::size_t count, std::int64_t& result) {
+  __m256i acc = _mm256_setzero_si256();
+  __m256i overflow = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    __m256i next = _mm256_add_epi64(acc, v);
+    // the sign flips away from both operands only on an overflow
+    overflow = _mm256_or_si256(overflow, _mm256_and_si256(_mm256_xor_si256(acc, next),
+                                                          _mm256_xor_si256(v, next)));
+    acc = next;
+  }
+
+  alignas(32) std::int64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+  std::int64_t total = 0;
+  bool wrapped = helpers::any_sign(overflow);
+  for (int lane = 0; lane < 4 && !wrapped; ++lane) {
+    wrapped = __builtin_add_overflow(total, lanes[lane], &total);
+  }
+  for (; i < count && !wrapped; ++i) {
+    wrapped = __builtin_add_overflow(total, values[i], &total);
+  }
+
+  // a partial sum can overflow while the whole one fits
+  if (wrapped) return scalar::sum_i64(values, count, result);
+
+  result = total;
+  return true;
+}
+
+double min_f64(const double* values, std::size_t count) {
+  __m256d best = _mm256_set1_pd(values[0]);
+  __m256d nan = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256d v = _mm256_loadu_pd(values + i);
+    nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+    best = _mm256_min_pd(v, best);
+  }
+
+  if (_mm256_movemask_pd(nan) != 0) return helpers::NaN;
+
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, best);
+  double result = lanes[0];
+  for (double lane : lanes) result = lane < result ? lane : result;
+  for (; i < count; ++i) {
+    if (std::isnan(values[i])) return helpers::NaN;
+    result = values[i] < result ? values[i] : result;
+  }
+
+  return result;
+}
+
+double max_f64(const double* values, std::size_t count) {
+  __m256d best = _mm256_set1_pd(values[0]);
+  __m256d nan = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256d v = _mm256_loadu_pd(values + i);
+    nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+    best = _mm256_max_pd(v, best);
+  }
+
+  if (_mm256_movemask_pd(nan) != 0) return helpers::NaN;
+
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, best);
+  double result = lanes[0];
+  for (double lane : lanes) result = lane > result ? lane : result;
+  for (; i < count; ++i) {
+    if (std::isnan(values[i])) return helpers::NaN;
+    result = values[i] > result ? values[i] : result;
+  }
+
+  return result;
+}
+
+std::int64_t min_i64(const std::int64_t* values, std::size_t count) {
+  __m256i best = _mm256_set1_epi64x(values[0]);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    best = _mm256_blendv_epi8(best, v, _mm256_cmpgt_epi64(best, v));
+  }
+
+  alignas(32) std::int64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+  std::int64_t result = lanes[0];
+  for (std::int64_t lane : lanes) result = lane < result ? lane : result;
+  for (; i < count; ++i) result = values[i] < result ? values[i] : result;
+  return result;
+}
+
+std::int64_t max_i64(const std::int64_t* values, std::size_t count) {
+  __m256i best = _mm256_set1_epi64x(values[0]);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    best = _mm256_blendv_epi8(best, v, _mm256_cmpgt_epi64(v, best));
+  }
+
+  alignas(32) std::int64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+  std::int64_t result = lanes[0];
+  for (std::int64_t lane : lanes) result = lane > result ? lane : result;
+  for (; i < count; ++i) result = values[i] > result ? values[i] : result;
+  return result;
+}
+
+double dot_f64(const double* left, const double* right, std::size_t count) {
+  // separate multiplies and adds, a fused one would round differently
+  __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(left + i),
+                                             _mm256_loadu_pd(right + i)));
+    acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(left + i + 4),
+                                             _mm256_loadu_pd(right + i + 4)));
+  }
+
+  double total = helpers::horizontal_sum(_mm256_add_pd(acc0, acc1));
+  for (; i < count; ++i) total += left[i] * right[i];
+  return total;
+}
+
+void add_f64(const double* left, const double* right, double* out, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(left + i),
+                                            _mm256_loadu_pd(right + i)));
+  }
+
+  scalar::add_f64(left + i, right + i, out + i, count - i);
+}
+
+bool add_i64(const std::int64_t* left, const std::int64_t* right, std::int64_t* out,
+             std::size_t count) {
+  __m256i overflow = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i));
+    __m256i sum = _mm256_add_epi64(a, b);
+    overflow = _mm256_or_si256(overflow, _mm256_and_si256(_mm256_xor_si256(a, sum),
+                                                          _mm256_xor_si256(b, sum)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), sum);
+  }
+
+  return !helpers::any_sign(overflow)
+         && scalar::add_i64(left + i, right + i, out + i, count - i);
+}
+
+void mul_f64(const double* left, const double* right, double* out, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(left + i),
+                                            _mm256_loadu_pd(right + i)));
+  }
+
+  scalar::mul_f64(left + i, right + i, out + i, count - i);
+}
+
+void scale_f64(const double* values, double factor, double* out, std::size_t count) {
+  __m256d f = _mm256_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(values + i), f));
+  }
+
+  scalar::scale_f64(values + i, factor, out + i, count - i);
+}
+
+void greater_f64(const double* values, double bound, std::int64_t* out, std::size_t count) {
+  __m256d b = _mm256_set1_pd(bound);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256d mask = _mm256_cmp_pd(_mm256_loadu_pd(values + i), b, _CMP_GT_OQ);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        helpers::to_flags(_mm256_castpd_si256(mask)));
+  }
+
+  scalar::greater_f64(values + i, bound, out + i, count - i);
+}
+
+void greater_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+                 std::size_t count) {
+  __m256i b = _mm256_set1_epi64x(bound);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        helpers::to_flags(_mm256_cmpgt_epi64(v, b)));
+  }
+
+  scalar::greater_i64(values + i, bound, out + i, count - i);
+}
+
+void less_f64(const double* values, double bound, std::int64_t* out, std::size_t count) {
+  __m256d b = _mm256_set1_pd(bound);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256d mask = _mm256_cmp_pd(_mm256_loadu_pd(values + i), b, _CMP_LT_OQ);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        helpers::to_flags(_mm256_castpd_si256(mask)));
+  }
+
+  scalar::less_f64(values + i, bound, out + i, count - i);
+}
+
+void less_i64(const std::int64_t* values, std::int64_t bound, std::int64_t* out,
+              std::size_t count) {
+  __m256i b = _mm256_set1_epi64x(bound);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        helpers::to_flags(_mm256_cmpgt_epi64(b, v)));
+  }
+
+  scalar::less_i64(values + i, bound, out + i, count - i);
+}
+
+std::size_t filter_f64(const double* values, const std::int64_t* mask, double* out,
+                       std::size_t count) {
+  std::size_t kept = 0;
+  std::size_t i = 0;
+  // the 4 lanes written past the kept ones stay below i + 4
+  for (; i + 4 <= count; i += 4) {
+    kept += helpers::compact(values + i, mask + i, out + kept);
+  }
+
+  return kept + scalar::filter_f64(values + i, mask + i, out + kept, count - i);
+}
+
+std::size_t filter_i64(const std::int64_t* values, const std::int64_t* mask,
+                       std::int64_t* out, std::size_t count) {
+  std::size_t kept = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    kept += helpers::compact(values + i, mask + i, out + kept);
+  }
+
+  return kept + scalar::filter_i64(values + i, mask + i, out + kept, count - i);
+}
+
+} // namespace avx2
+
+} // namespace bulk
+
+} // namespace slang
@@ -0,0 +1,692 @@
+#include <cstring>
+
+#include "AstSerializer.hpp"
+
+namespace slang {
+
+// ------------------------ | HELPERS |
+enum NodeKind : std::uint8_t {
+  NODE_NULL,
+
+  EXPR_ASSIGN, EXPR_BINARY, EXPR_CALL, EXPR_GET, EXPR_GROUPING,
+  EXPR_INDEX, EXPR_LIST, EXPR_LITERAL, EXPR_LOGICAL, EXPR_MAP,
+  EXPR_SET, EXPR_SET_INDEX, EXPR_SLICE, EXPR_UNARY, EXPR_VARIABLE,
+
+  STMT_BLOCK, STMT_CLASS, STMT_BREAK, STMT_EXPRESSION, STMT_IF,
+  STMT_IMPORT, STMT_FN, STMT_PRINT, STMT_RETURN, STMT_VAR, STMT_WHILE
+};
+
+enum ObjectKind : std::uint8_t {
+  OBJECT_NONE, OBJECT_FALSE, OBJECT_TRUE, OBJECT_INT, OBJECT_DOUBLE, OBJECT_STRING
+};
+
+namespace helpers {
+
+static bool is_binary_operator(TokenType type) {
+  switch (type) {
+    case MINUS: case PLUS: case SLASH: case STAR:
+    case BANG_EQ: case EQ_EQ:
+    case GREATER: case GREATER_EQ: case LESS: case LESS_EQ:
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace helpers
+
+// ------------------------ | WRITER |
+AstWriter::AstWriter(Interpreter& interpreter)
+  : m_interpreter(interpreter)
+{}
+
+void AstWriter::write(vector<shared_ptr<stmt::Stmt>>& statements, string& out) {
+  m_out = &out;
+  put(statements);
+  m_out = nullptr;
+}
+
+std::optional<std::uint32_t> AstWriter::function_index(const stmt::Fn& fn) const {
+  auto found = m_functions.find(&fn);
+  if (found == m_functions.end()) {
+    return std::nullopt;
+  }
+
+  return found->second;
+}
+
+void AstWriter::visitAssignExpr(expr::Assign &expr) {
+  put_kind(EXPR_ASSIGN, expr);
+  put_depth(expr);
+  put_token(expr.m_name);
+  put(expr.m_value.get());
+}
+
+void AstWriter::visitBinaryExpr(expr::Binary &expr) {
+  put_kind(EXPR_BINARY, expr);
+  put(expr.m_left.get());
+  put_token(expr.m_oper);
+  put(expr.m_right.get());
+}
+
+void AstWriter::visitCallExpr(expr::Call &expr) {
+  put_kind(EXPR_CALL, expr);
+  put(expr.m_callee.get());
+  put_token(expr.m_paren);
+  put_u32(expr.m_args.size());
+  for (auto& arg : expr.m_args) {
+    put(arg.get());
+  }
+}
+
+void AstWriter::visitGetExpr(expr::Get &expr) {
+  put_kind(EXPR_GET, expr);
+  put(expr.m_object.get());
+  put_token(expr.m_name);
+}
+
+void AstWriter::visitGroupingExpr(expr::Grouping &expr) {
+  put_kind(EXPR_GROUPING, expr);
+  put(expr.m_expression.get());
+}
+
+void AstWriter::visitLiteralExpr(expr::Literal &expr) {
+  put_kind(EXPR_LITERAL, expr);
+  put_object(expr.m_value);
+}
+
+void AstWriter::visitLogicalExpr(expr::Logical &expr) {
+  put_kind(EXPR_LOGICAL, expr);
+  put(expr.m_left.get());
+  put_token(expr.m_oper);
+  put(expr.m_right.get());
+}
+
+void AstWriter::visitSetExpr(expr::Set &expr) {
+  put_kind(EXPR_SET, expr);
+  put(expr.m_object.get());
+  put_token(expr.m_name);
+  put(expr.m_value.get());
+}
+
+void AstWriter::visitListExpr(expr::List &expr) {
+  put_kind(EXPR_LIST, expr);
+  put_token(expr.m_bracket);
+  put_u32(expr.m_elements.size());
+  for (auto& element : expr.m_elements) {
+    put(element.get());
+  }
+}
+
+void AstWriter::visitMapExpr(expr::Map &expr) {
+  put_kind(EXPR_MAP, expr);
+  put_token(expr.m_brace);
+  put_u32(expr.m_keys.size());
+  for (std::size_t i = 0; i < expr.m_keys.size(); ++i) {
+    put(expr.m_keys[i].get());
+    put(expr.m_values[i].get());
+  }
+}
+
+void AstWriter::visitIndexExpr(expr::Index &expr) {
+  put_kind(EXPR_INDEX, expr);
+  put(expr.m_object.get());
+  put_token(expr.m_bracket);
+  put(expr.m_index.get());
+}
+
+void AstWriter::visitSetIndexExpr(expr::SetIndex &expr) {
+  put_kind(EXPR_SET_INDEX, expr);
+  put(expr.m_object.get());
+  put_token(expr.m_bracket);
+  put(expr.m_index.get());
+  put(expr.m_value.get());
+}
+
+void AstWriter::visitSliceExpr(expr::Slice &expr) {
+  put_kind(EXPR_SLICE, expr);
+  put(expr.m_object.get());
+  put_token(expr.m_bracket);
+  put(expr.m_start.get());
+  put(expr.m_end.get());
+}
+
+void AstWriter::visitUnaryExpr(expr::Unary &expr) {
+  put_kind(EXPR_UNARY, expr);
+  put_token(expr.m_oper);
+  put(expr.m_right.get());
+}
+
+void AstWriter::visitVariableExpr(expr::Variable &expr) {
+  put_kind(EXPR_VARIABLE, expr);
+  put_depth(expr);
+  put_token(expr.m_name);
+}
+
+void AstWriter::visitBlockStmt(stmt::Block &stmt) {
+  put_u8(STMT_BLOCK);
+  put(stmt.m_statements);
+}
+
+void AstWriter::visitClassStmt(stmt::Class &stmt) {
+  put_u8(STMT_CLASS);
+  put_token(stmt.m_name);
+  put_u32(stmt.m_methods.size());
+  for (auto& method : stmt.m_methods) {
+    put_fn(*method);
+  }
+}
+
+void AstWriter::visitBreakStmt(stmt::Break &stmt) {
+  put_u8(STMT_BREAK);
+  put_token(stmt.m_keyword);
+}
+
+void AstWriter::visitExpressionStmt(stmt::Expression &stmt) {
+  put_u8(STMT_EXPRESSION);
+  put(stmt.m_expression.get());
+}
+
+void AstWriter::visitIfStmt(stmt::If &stmt) {
+  put_u8(STMT_IF);
+  put(stmt.m_condition.get());
+  put(stmt.m_then_branch.get());
+  put(stmt.m_else_branch.get());
+}
+
+void AstWriter::visitFnStmt(stmt::Fn &stmt) {
+  put_u8(STMT_FN);
+  put_fn(stmt);
+}
+
+void AstWriter::visitImportStmt(stmt::Import &stmt) {
+  put_u8(STMT_IMPORT);
+  put_token(stmt.m_keyword);
+  put_token(stmt.m_path);
+}
+
+void AstWriter::visitPrintStmt(stmt::Print &stmt) {
+  put_u8(STMT_PRINT);
+  put(stmt.m_expression.get());
+}
+
+void AstWriter::visitReturnStmt(stmt::Return &stmt) {
+  put_u8(STMT_RETURN);
+  put_u8(m_interpreter.is_tail_call(stmt));
+  put_token(stmt.m_keyword);
+  put(stmt.m_value.get());
+}
+
+void AstWriter::visitVarStmt(stmt::Var &stmt) {
+  put_u8(STMT_VAR);
+  put_token(stmt.m_name);
+  put(stmt.m_initializer.get());
+}
+
+void AstWriter::visitWhileStmt(stmt::While &stmt) {
+  put_u8(STMT_WHILE);
+  put(stmt.m_condition.get());
+  put(stmt.m_then_branch.get());
+  put(stmt.m_else_branch.get());
+}
+
+void AstWriter::put(expr::Expr* expr) {
+  if (expr == nullptr) {
+    put_u8(NODE_NULL);
+  } else {
+    expr->accept(*this);
+  }
+}
+
+void AstWriter::put(stmt::Stmt* stmt) {
+  if (stmt == nullptr) {
+    put_u8(NODE_NULL);
+  } else {
+    stmt->accept(*this);
+  }
+}
+
+void AstWriter::put(vector<shared_ptr<stmt::Stmt>>& statements) {
+  put_u32(statements.size());
+  for (auto& s : statements) {
+    put(s.get());
+  }
+}
+
+void AstWriter::put_kind(std::uint8_t kind, expr::Expr& expr) {
+  put_u8(kind);
+  put_u8(expr.m_static_type);
+}
+
+void AstWriter::put_depth(expr::Expr& expr) {
+  put_i64(m_interpreter.local_depth(expr));
+}
+
+void AstWriter::put_fn(stmt::Fn& fn) {
+  // numbered before the body, like AstReader::get_fn() does
+  m_functions.insert({&fn, static_cast<std::uint32_t>(m_functions.size())});
+
+  put_token(fn.m_name);
+  put_u32(fn.m_params.size());
+  for (auto& param : fn.m_params) {
+    put_token(param);
+  }
+  put(fn.m_body);
+}
+
+void AstWriter::put_token(const Token& token) {
+  put_u8(token.m_type);
+  put_string(token.m_lexeme);
+  put_object(token.m_literal);
+  put_u32(token.m_line);
+}
+
+void AstWriter::put_object(const Object& value) {
+  if (auto pint = std::get_if<std::int64_t>(&value)) {
+    put_u8(OBJECT_INT);
+    put_i64(*pint);
+  } else if (auto pdouble = std::get_if<double>(&value)) {
+    put_u8(OBJECT_DOUBLE);
+    put_f64(*pdouble);
+  } else if (auto pbool = std::get_if<bool>(&value)) {
+    put_u8(*pbool ? OBJECT_TRUE : OBJECT_FALSE);
+  } else if (auto pstr = std::get_if<SlangString>(&value)) {
+    put_u8(OBJECT_STRING);
+    put_string(pstr->view());
+  } else {
+    // literals are never callables or instances
+    put_u8(OBJECT_NONE);
+  }
+}
+
+void AstWriter::put_string(std::string_view str) {
+  put_u32(str.size());
+  m_out->append(str);
+}
+
+void AstWriter::put_u8(std::uint8_t value) {
+  m_out->push_back(static_cast<char>(value));
+}
+
+void AstWriter::put_u32(std::uint32_t value) {
+  m_out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AstWriter::put_i64(std::int64_t value) {
+  m_out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AstWriter::put_f64(double value) {
+  m_out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// ------------------------ | READER |
+AstReader::AstReader(Interpreter& interpreter, const char* data, std::size_t size)
+  : m_interpreter(interpreter),
+    m_current(data),
+    m_end(data + size)
+{}
+
+vector<shared_ptr<stmt::Stmt>> AstReader::read() {
+  auto statements = get_statements();
+  if (m_current != m_end) {
+    throw CorruptImage();
+  }
+
+  // only a complete program may leave traces in the interpreter
+  for (auto& [expr, depth] : m_locals) {
+    m_interpreter.resolve(*expr, depth);
+  }
+  for (auto ret : m_tail_calls) {
+    m_interpreter.mark_tail_call(*ret);
+  }
+
+  return statements;
+}
+
+shared_ptr<expr::Expr> AstReader::get_optional_expr() {
+  auto kind = get_u8();
+  if (kind == NODE_NULL) {
+    return nullptr;
+  }
+
+  auto type = static_cast<StaticType>(get_u8());
+  if (type > TYPE_ANY) {
+    throw CorruptImage();
+  }
+
+  shared_ptr<expr::Expr> result;
+  std::int64_t depth = -1;
+
+  switch (kind) {
+    case EXPR_ASSIGN: {
+      depth = get_i64();
+      auto name = get_token();
+      auto value = get_expr();
+      result = std::make_shared<expr::Assign>(expr::Assign(name, value));
+      break;
+    }
+    case EXPR_BINARY: {
+      auto left = get_expr();
+      auto oper = get_token();
+      auto right = get_expr();
+      if (!helpers::is_binary_operator(oper.m_type)) {
+        throw CorruptImage();
+      }
+      result = std::make_shared<expr::Binary>(expr::Binary(left, oper, right));
+      break;
+    }
+    case EXPR_CALL: {
+      auto callee = get_expr();
+      auto paren = get_token();
+      vector<shared_ptr<expr::Expr>> args(get_count());
+      for (auto& arg : args) {
+        arg = get_expr();
+      }
+      result = std::make_shared<expr::Call>(expr::Call(callee, paren, args));
+      break;
+    }
+    case EXPR_GET: {
+      auto object = get_expr();
+      auto name = get_token();
+      result = std::make_shared<expr::Get>(expr::Get(object, name));
+      break;
+    }
+    case EXPR_GROUPING: {
+      auto expression = get_expr();
+      result = std::make_shared<expr::Grouping>(expr::Grouping(expression));
+      break;
+    }
+    case EXPR_LITERAL: {
+      result = std::make_shared<expr::Literal>(expr::Literal(get_object()));
+      break;
+    }
+    case EXPR_LOGICAL: {
+      auto left = get_expr();
+      auto oper = get_token();
+      auto right = get_expr();
+      if (oper.m_type != AND && oper.m_type != OR) {
+        throw CorruptImage();
+      }
+      result = std::make_shared<expr::Logical>(expr::Logical(left, oper, right));
+      break;
+    }
+    case EXPR_SET: {
+      auto object = get_expr();
+      auto name = get_token();
+      auto value = get_expr();
+      result = std::make_shared<expr::Set>(expr::Set(object, name, value));
+      break;
+    }
+    case EXPR_INDEX: {
+      auto object = get_expr();
+      auto bracket = get_token();
+      auto index = get_expr();
+      result = std::make_shared<expr::Index>(expr::Index(object, bracket, index));
+      break;
+    }
+    case EXPR_LIST: {
+      auto bracket = get_token();
+      vector<shared_ptr<expr::Expr>> elements(get_count());
+      for (auto& element : elements) {
+        element = get_expr();
+      }
+      result = std::make_shared<expr::List>(expr::List(bracket, elements));
+      break;
+    }
+    case EXPR_MAP: {
+      auto brace = get_token();
+      std::uint32_t count = get_count();
+      vector<shared_ptr<expr::Expr>> keys(count);
+      vector<shared_ptr<expr::Expr>> values(count);
+      for (std::uint32_t i = 0; i < count; ++i) {
+        keys[i] = get_expr();
+        values[i] = get_expr();
+      }
+      result = std::make_shared<expr::Map>(expr::Map(brace, keys, values));
+      break;
+    }
+    case EXPR_SET_INDEX: {
+      auto object = get_expr();
+      auto bracket = get_token();
+      auto index = get_expr();
+      auto value = get_expr();
+      result = std::make_shared<expr::SetIndex>(expr::SetIndex(object, bracket, index, value));
+      break;
+    }
+    case EXPR_SLICE: {
+      auto object = get_expr();
+      auto bracket = get_token();
+      auto start = get_optional_expr();
+      auto end = get_optional_expr();
+      result = std::make_shared<expr::Slice>(expr::Slice(object, bracket, start, end));
+      break;
+    }
+    case EXPR_UNARY: {
+      auto oper = get_token();
+      auto right = get_expr();
+      if (oper.m_type != MINUS && oper.m_type != BANG) {
+        throw CorruptImage();
+      }
+      result = std::make_shared<expr::Unary>(expr::Unary(oper, right));
+      break;
+    }
+    case EXPR_VARIABLE: {
+      depth = get_i64();
+      result = std::make_shared<expr::Variable>(expr::Variable(get_token()));
+      break;
+    }
+    default:
+      throw CorruptImage();
+  }
+
+  if (depth < -1 || depth >= static_cast<std::int64_t>(m_scope_depth)) {
+    throw CorruptImage();
+  }
+
+  result->m_static_type = type;
+  if (depth >= 0) {
+    m_locals.push_back({result.get(), static_cast<int>(depth)});
+  }
+
+  return result;
+}
+
+shared_ptr<stmt::Stmt> AstReader::get_optional_stmt() {
+  switch (get_u8()) {
+    case NODE_NULL:
+      return nullptr;
+    case STMT_BLOCK: {
+      ++m_scope_depth;
+      auto statements = get_statements();
+      --m_scope_depth;
+      return std::make_shared<stmt::Block>(stmt::Block(statements));
+    }
+    case STMT_CLASS: {
+      auto name = get_token();
+      vector<shared_ptr<stmt::Fn>> methods(get_count());
+      for (auto& method : methods) {
+        method = get_fn();
+      }
+      return std::make_shared<stmt::Class>(stmt::Class(name, methods));
+    }
+    case STMT_BREAK:
+      if (m_loop_depth == 0) {
+        throw CorruptImage();
+      }
+      return std::make_shared<stmt::Break>(stmt::Break(get_token()));
+    case STMT_EXPRESSION:
+      return std::make_shared<stmt::Expression>(stmt::Expression(get_expr()));
+    case STMT_IF: {
+      auto condition = get_expr();
+      auto then_branch = get_stmt();
+      auto else_branch = get_optional_stmt();
+      return std::make_shared<stmt::If>(stmt::If(condition, then_branch, else_branch));
+    }
+    case STMT_IMPORT: {
+      auto keyword = get_token();
+      auto path = get_token();
+      return std::make_shared<stmt::Import>(stmt::Import(keyword, path));
+    }
+    case STMT_FN:
+      return get_fn();
+    case STMT_PRINT:
+      return std::make_shared<stmt::Print>(stmt::Print(get_expr()));
+    case STMT_RETURN: {
+      bool is_tail_call = get_u8() != 0;
+      auto keyword = get_token();
+      auto value = get_optional_expr();
+      if (m_fn_depth == 0
+          || (is_tail_call && dynamic_cast<expr::Call*>(value.get()) == nullptr)) {
+        throw CorruptImage();
+      }
+
+      auto ret = std::make_shared<stmt::Return>(stmt::Return(keyword, value));
+      if (is_tail_call) {
+        m_tail_calls.push_back(ret.get());
+      }
+      return ret;
+    }
+    case STMT_VAR: {
+      auto name = get_token();
+      auto initializer = get_optional_expr();
+      return std::make_shared<stmt::Var>(stmt::Var(name, initializer));
+    }
+    case STMT_WHILE: {
+      auto condition = get_expr();
+      ++m_loop_depth;
+      auto then_branch = get_stmt();
+      --m_loop_depth;
+      auto else_branch = get_optional_stmt();
+      return std::make_shared<stmt::While>(stmt::While(condition, then_branch, else_branch));
+    }
+    default:
+      throw CorruptImage();
+  }
+}
+
+shared_ptr<expr::Expr> AstReader::get_expr() {
+  auto expr = get_optional_expr();
+  if (expr == nullptr) {
+    throw CorruptImage();
+  }
+
+  return expr;
+}
+
+shared_ptr<stmt::Stmt> AstReader::get_stmt() {
+  auto stmt = get_optional_stmt();
+  if (stmt == nullptr) {
+    throw CorruptImage();
+  }
+
+  return stmt;
+}
+
+vector<shared_ptr<stmt::Stmt>> AstReader::get_statements() {
+  vector<shared_ptr<stmt::Stmt>> statements(get_count());
+  for (auto& s : statements) {
+    s = get_stmt();
+  }
+
+  return statements;
+}
+
+shared_ptr<stmt::Fn> AstReader::get_fn() {
+  std::size_t index = m_functions.size();
+  m_functions.push_back(nullptr);
+
+  auto name = get_token();
+
+  vector<Token> params;
+  std::uint32_t count = get_count();
+  params.reserve(count);
+  for (std::uint32_t i = 0; i < count; ++i) {
+    params.push_back(get_token());
+  }
+
+  ++m_scope_depth;
+  ++m_fn_depth;
+  auto body = get_statements();
+  --m_fn_depth;
+  --m_scope_depth;
+
+  auto fn = std::make_shared<stmt::Fn>(stmt::Fn(name, params, body, nullptr));
+  m_functions[index] = fn.get();
+  return fn;
+}
+
+Token AstReader::get_token() {
+  auto type = get_u8();
+  if (type > END_OF_FILE) {
+    throw CorruptImage();
+  }
+
+  auto lexeme = get_string();
+  auto literal = get_object();
+  auto line = get_u32();
+  return Token(static_cast<TokenType>(type), lexeme, literal, line);
+}
+
+Object AstReader::get_object() {
+  switch (get_u8()) {
+    case OBJECT_NONE:   return nullptr;
+    case OBJECT_FALSE:  return false;
+    case OBJECT_TRUE:   return true;
+    case OBJECT_INT:    return get_i64();
+    case OBJECT_DOUBLE: return get_f64();
+    case OBJECT_STRING: return get_string();
+    default:
+      throw CorruptImage();
+  }
+}
+
+string AstReader::get_string() {
+  std::uint32_t size = get_u32();
+  return string(take(size), size);
+}
+
+std::uint8_t AstReader::get_u8() {
+  return static_cast<std::uint8_t>(*take(1));
+}
+
+std::uint32_t AstReader::get_u32() {
+  std::uint32_t value;
+  std::memcpy(&value, take(sizeof(value)), sizeof(value));
+  return value;
+}
+
+std::int64_t AstReader::get_i64() {
+  std::int64_t value;
+  std::memcpy(&value, take(sizeof(value)), sizeof(value));
+  return value;
+}
+
+double AstReader::get_f64() {
+  double value;
+  std::memcpy(&value, take(sizeof(value)), sizeof(value));
+  return value;
+}
+
+std::uint32_t AstReader::get_count() {
+  // every element takes at least a byte,
+  // so a corrupt count can not make us allocate more than the image
+  std::uint32_t count = get_u32();
+  if (static_cast<std::size_t>(m_end - m_current) < count) {
+    throw CorruptImage();
+  }
+
+  return count;
+}
+
+const char* AstReader::take(std::size_t count) {
+  if (static_cast<std::size_t>(m_end - m_current) < count) {
+    throw CorruptImage();
+  }
+
+  const char* data = m_current;
+  m_current += count;
+  return data;
+}
+
+} // namespace slang
@@ -0,0 +1,158 @@
+#ifndef __SLANG_AST_SERIALIZER_HPP__
+#define __SLANG_AST_SERIALIZER_HPP__
+
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Expr.hpp"
+#include "Interpreter.hpp"
+#include "Stmt.hpp"
+
+namespace slang {
+
+using std::vector;
+using std::shared_ptr;
+using std::string;
+
+/// Thrown by AstReader when the image is truncated or malformed.
+class CorruptImage : public std::runtime_error {
+public:
+  CorruptImage() : std::runtime_error("corrupt program image") {}
+};
+
+/// Writes a resolved and type-inferred program into a flat binary image.
+/// Besides the tree itself the image keeps everything the later stages
+/// derived from it: the scope depth of every resolved variable, the
+/// tail calls and the static type of every expression.
+class AstWriter : public expr::IVisitor,
+                  public stmt::IVisitor {
+public:
+  /// @interpreter must be the one the program was resolved for.
+  explicit AstWriter(Interpreter& interpreter);
+
+  AstWriter(AstWriter &&) = delete;
+  AstWriter(const AstWriter &) = delete;
+  AstWriter &operator=(AstWriter &&) = delete;
+  AstWriter &operator=(const AstWriter &) = delete;
+  ~AstWriter() = default;
+
+  /// Appends the image of @statements to @out,
+  /// the bodies of all functions must have been parsed.
+  void write(vector<shared_ptr<stmt::Stmt>>& statements, string& out);
+
+  /// Position of @fn among the functions and methods written so far,
+  /// the same as in AstReader::functions(), nothing if @fn was not written.
+  std::optional<std::uint32_t> function_index(const stmt::Fn& fn) const;
+
+  void visitAssignExpr(expr::Assign &expr) override;
+  void visitBinaryExpr(expr::Binary &expr) override;
+  void visitCallExpr(expr::Call &expr) override;
+  void visitGetExpr(expr::Get &expr) override;
+  void visitGroupingExpr(expr::Grouping &expr) override;
+  void visitLiteralExpr(expr::Literal &expr) override;
+  void visitLogicalExpr(expr::Logical &expr) override;
+  void visitSetExpr(expr::Set &expr) override;
+  void visitMapExpr(expr::Map &expr) override;
+  void visitListExpr(expr::List &expr) override;
+  void visitIndexExpr(expr::Index &expr) override;
+  void visitSetIndexExpr(expr::SetIndex &expr) override;
+  void visitSliceExpr(expr::Slice &expr) override;
+  void visitUnaryExpr(expr::Unary &expr) override;
+  void visitVariableExpr(expr::Variable &expr) override;
+
+  void visitBlockStmt(stmt::Block &stmt) override;
+  void visitClassStmt(stmt::Class &stmt) override;
+  void visitBreakStmt(stmt::Break &stmt) override;
+  void visitExpressionStmt(stmt::Expression &stmt) override;
+  void visitIfStmt(stmt::If &stmt) override;
+  void visitFnStmt(stmt::Fn &stmt) override;
+  void visitImportStmt(stmt::Import &stmt) override;
+  void visitPrintStmt(stmt::Print &stmt) override;
+  void visitReturnStmt(stmt::Return &stmt) override;
+  void visitVarStmt(stmt::Var &stmt) override;
+  void visitWhileStmt(stmt::While &stmt) override;
+
+private:
+  Interpreter& m_interpreter;
+  string* m_out{nullptr};
+  std::unordered_map<const stmt::Fn*, std::uint32_t> m_functions{};
+
+  void put(expr::Expr* expr);
+  void put(stmt::Stmt* stmt);
+  void put(vector<shared_ptr<stmt::Stmt>>& statements);
+  void put_kind(std::uint8_t kind, expr::Expr& expr);
+  void put_depth(expr::Expr& expr);
+  void put_fn(stmt::Fn& fn);
+  void put_token(const Token& token);
+  void put_object(const Object& value);
+  void put_string(std::string_view str);
+  void put_u8(std::uint8_t value);
+  void put_u32(std::uint32_t value);
+  void put_i64(std::int64_t value);
+  void put_f64(double value);
+};
+
+/// Rebuilds a program from an image written by AstWriter, reading it in
+/// place, and registers its resolved variables and tail calls with the
+/// Interpreter as the Resolver would have done.
+class AstReader {
+public:
+  AstReader(Interpreter& interpreter, const char* data, std::size_t size);
+
+  AstReader(AstReader &&) = delete;
+  AstReader(const AstReader &) = delete;
+  AstReader &operator=(AstReader &&) = delete;
+  AstReader &operator=(const AstReader &) = delete;
+  ~AstReader() = default;
+
+  /// Throws CorruptImage if the image is malformed, or holds a program
+  /// the Resolver would not have produced: variables resolved deeper than
+  /// their scopes, tail calls of anything but a call, returns outside of
+  /// functions and breaks outside of loops.
+  vector<shared_ptr<stmt::Stmt>> read();
+
+  /// Functions and methods of the program in the order they were read.
+  const vector<stmt::Fn*>& functions() const { return m_functions; }
+
+private:
+  Interpreter& m_interpreter;
+  const char* m_current;
+  const char* m_end;
+  vector<stmt::Fn*> m_functions{};
+
+  vector<std::pair<expr::Expr*, int>> m_locals{};
+  vector<stmt::Return*> m_tail_calls{};
+
+  // enclosing local scopes, functions and loop bodies of the node being
+  // read, what the Resolver allows in a node depends on them
+  std::size_t m_scope_depth{0};
+  std::size_t m_fn_depth{0};
+  std::size_t m_loop_depth{0};
+
+  /// A node that must be there, throws CorruptImage for an empty one.
+  shared_ptr<expr::Expr> get_expr();
+  shared_ptr<stmt::Stmt> get_stmt();
+  shared_ptr<expr::Expr> get_optional_expr();
+  shared_ptr<stmt::Stmt> get_optional_stmt();
+  vector<shared_ptr<stmt::Stmt>> get_statements();
+  shared_ptr<stmt::Fn> get_fn();
+  Token get_token();
+  Object get_object();
+  string get_string();
+  std::uint8_t get_u8();
+  std::uint32_t get_u32();
+  std::int64_t get_i64();
+  double get_f64();
+  std::uint32_t get_count();
+  const char* take(std::size_t count);
+};
+
+} // namespace slang
+
+#endif // !__SLANG_AST_SERIALIZER_HPP__
@@ -0,0 +1,56 @@
+#include "CompiledFn.hpp"
+
+namespace slang {
+
+CompiledFn::CompiledFn(const std::string& name, Code code,
+                       const std::vector<std::string>& params,
+                       std::unique_ptr<Environment> closure)
+  : m_name(name),
+    m_code(code),
+    m_params(params),
+    m_closure(std::move(closure))
+{
+  m_closure->define(m_name, this);
+}
+
+Object CompiledFn::call(Interpreter &interpreter, std::vector<Object> &args) {
+  CompiledFn* fn = this;
+  TailCall tail;
+  Object tail_callee = nullptr;
+  std::vector<Object> tail_args;
+  std::vector<Object>* fn_args = &args;
+
+  Environment env(m_closure.get());
+
+  for (;;) {
+    for (size_t i = 0; i < fn->m_params.size(); ++i) {
+      env.define(fn->m_params[i], (*fn_args)[i]);
+    }
+
+    Object ret = fn->m_code(interpreter, &env, tail);
+    if (tail.m_fn == nullptr) {
+      return ret;
+    }
+
+    tail_callee = std::move(tail.m_callee);
+    tail_args = std::move(tail.m_args);
+    fn_args = &tail_args;
+    fn = tail.m_fn;
+    tail.m_fn = nullptr;
+    env.reset(fn->m_closure.get());
+  }
+}
+
+void CompiledFn::track(Journal& journal) {
+  journal.track(*m_closure);
+}
+
+size_t CompiledFn::arity() {
+  return m_params.size();
+}
+
+std::string CompiledFn::to_string() const {
+  return "<fn " + m_name + ">";
+}
+
+} // namespace slang
@@ -0,0 +1,56 @@
+#ifndef __SLANG_COMPILED_FN_HPP__
+#define __SLANG_COMPILED_FN_HPP__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ICallable.hpp"
+#include "Interpreter.hpp"
+
+namespace slang {
+
+/// Function whose body was translated to C++ by `slang --emit-cpp`.
+/// Behaves like SlangFn: same closure and parameter environments,
+/// and `return f(...)` reuses the caller's frame.
+class CompiledFn : public ICallable {
+public:
+  /// Set by the body instead of returning when it ends in a tail call
+  /// to another compiled function.
+  struct TailCall {
+    Object m_callee{nullptr}; // keeps m_fn alive until the frame is reused
+    CompiledFn* m_fn{nullptr};
+    std::vector<Object> m_args{};
+  };
+
+  using Code = Object (*)(Interpreter&, Environment*, TailCall&);
+
+  CompiledFn(const std::string& name, Code code,
+             const std::vector<std::string>& params,
+             std::unique_ptr<Environment> closure);
+
+  CompiledFn(CompiledFn &&) = delete;
+  CompiledFn(const CompiledFn &) = delete;
+  CompiledFn &operator=(CompiledFn &&) = delete;
+  CompiledFn &operator=(const CompiledFn &) = delete;
+  ~CompiledFn() = default;
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override;
+
+  size_t arity() override;
+
+  void track(Journal& journal) override;
+
+  std::string to_string() const override;
+
+private:
+  std::string m_name;
+  Code m_code;
+  std::vector<std::string> m_params;
+  std::unique_ptr<Environment> m_closure;
+
+};
+
+} // namespace slang
+
+#endif // !__SLANG_COMPILED_FN_HPP__
@@ -0,0 +1,648 @@
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+
+#include "CppEmitter.hpp"
+#include "Number.hpp"
+
+namespace slang {
+
+// ------------------------ | PUBLIC |
+CppEmitter::CppEmitter(Interpreter& interpreter)
+  : m_interpreter(interpreter)
+{}
+
+void CppEmitter::emit(vector<shared_ptr<stmt::Stmt>>& statements,
+                      const string& source_name, std::ostream& out) {
+  std::ostringstream body;
+  m_out = &body;
+  m_indent = 1;
+  m_loop_depth = 0;
+  emit(statements);
+
+  out << "// Generated by `slang --emit-cpp` from " << source_name
+      << ", do not edit.\n"
+      << "#include <memory>\n"
+      << "#include <string>\n"
+      << "#include <unordered_map>\n"
+      << "#include <vector>\n"
+      << "\n"
+      << "#include \"CompiledFn.hpp\"\n"
+      << "#include \"ErrorReporter.hpp\"\n"
+      << "#include \"Interpreter.hpp\"\n"
+      << "#include \"InterpreterExceptions.hpp\"\n"
+      << "#include \"Number.hpp\"\n"
+      << "#include \"Runtime.hpp\"\n"
+      << "#include \"SlangClass.hpp\"\n"
+      << "#include \"SlangInstance.hpp\"\n"
+      << "\n"
+      << "using namespace slang;\n"
+      << "\n"
+      << "namespace {\n"
+      << "\n"
+      << m_tokens.str()
+      << "\n"
+      << m_functions.str()
+      << "void run_script(Interpreter& interp) {\n"
+      << "  Environment* env = interp.get_global_environment();\n"
+      << "  [[maybe_unused]] Environment* globals = env;\n"
+      << body.str()
+      << "}\n"
+      << "\n"
+      << "} // namespace\n"
+      << "\n"
+      << "int main() {\n"
+      << "  auto reporter = std::make_shared<ErrorReporter>();\n"
+      << "  Interpreter interp(reporter);\n"
+      << "  try {\n"
+      << "    run_script(interp);\n"
+      << "  } catch (const RuntimeError& e) {\n"
+      << "    interp.output().flush();\n"
+      << "    reporter->runtime_error(e);\n"
+      << "    return 70;\n"
+      << "  }\n"
+      << "  return 0;\n"
+      << "}\n";
+}
+
+void CppEmitter::visitAssignExpr(expr::Assign &expr) {
+  string value = emit(*expr.m_value);
+  string name = token(expr.m_name);
+
+  int depth = m_interpreter.local_depth(expr);
+  if (depth >= 0) {
+    line() << "env->assign_at(" << depth << ", " << name << ", " << value << ");\n";
+  } else {
+    line() << "globals->assign(" << name << ", " << value << ");\n";
+  }
+
+  line() << "env->assign(" << name << ", " << value << ");\n";
+  Return(value);
+}
+
+void CppEmitter::visitBinaryExpr(expr::Binary &expr) {
+  auto left_type = expr.m_left->m_static_type;
+  auto right_type = expr.m_right->m_static_type;
+  string result = temp();
+
+  if (is_numeric_type(left_type) && is_numeric_type(right_type)) {
+    string left = number(*expr.m_left);
+    string right = number(*expr.m_right);
+    line() << "Object " << result << " = number_operation("
+           << type_name(expr.m_oper.m_type) << ", " << left << ", " << right << ");\n";
+    Return(result);
+    return;
+  }
+
+  string left = emit(*expr.m_left);
+  string right = emit(*expr.m_right);
+
+  if (expr.m_oper.m_type == PLUS
+      && left_type == TYPE_STRING && right_type == TYPE_STRING) {
+    line() << "Object " << result << " = SlangString::concat(std::get<SlangString>("
+           << left << "), std::get<SlangString>(" << right << "));\n";
+  } else {
+    line() << "Object " << result << " = runtime::binary("
+           << token(expr.m_oper) << ", " << left << ", " << right << ");\n";
+  }
+
+  Return(result);
+}
+
+void CppEmitter::visitCallExpr(expr::Call &expr) {
+  string callee, fn, args, paren;
+  emit_call(expr, callee, fn, args, paren);
+
+  string result = temp();
+  line() << "Object " << result << " = runtime::call(*" << fn << ", interp, "
+         << args << ", " << paren << ");\n";
+  Return(result);
+}
+
+void CppEmitter::visitGetExpr(expr::Get &expr) {
+  string obj = emit(*expr.m_object);
+  string result = temp();
+  line() << "Object " << result << " = runtime::get_property("
+         << obj << ", " << token(expr.m_name) << ");\n";
+  Return(result);
+}
+
+void CppEmitter::visitGroupingExpr(expr::Grouping &expr) {
+  Return(emit(*expr.m_expression));
+}
+
+void CppEmitter::visitLiteralExpr(expr::Literal &expr) {
+  string result = temp();
+  line() << "Object " << result << " = " << literal(expr.m_value) << ";\n";
+  Return(result);
+}
+
+void CppEmitter::visitLogicalExpr(expr::Logical &expr) {
+  string left = emit(*expr.m_left);
+  string result = temp();
+  line() << "Object " << result << " = " << left << ";\n";
+
+  if (expr.m_oper.m_type == OR) {
+    line() << "if (!runtime::is_truthy(" << result << ")) {\n";
+  } else {
+    line() << "if (runtime::is_truthy(" << result << ")) {\n";
+  }
+
+  ++m_indent;
+  string right = emit(*expr.m_right);
+  line() << result << " = " << right << ";\n";
+  --m_indent;
+  line() << "}\n";
+
+  Return(result);
+}
+
+void CppEmitter::visitSetExpr(expr::Set &expr) {
+  string obj = emit(*expr.m_object);
+  string instance = temp();
+  line() << "SlangInstance* " << instance << " = runtime::as_instance("
+         << obj << ", " << token(expr.m_name) << ");\n";
+
+  string value = emit(*expr.m_value);
+  line() << instance << "->set_property(" << token(expr.m_name)
+         << ", " << value << ");\n";
+  Return(value);
+}
+
+void CppEmitter::visitListExpr(expr::List &expr) {
+  string items = temp();
+  line() << "std::vector<Object> " << items << ";\n";
+  line() << items << ".reserve(" << expr.m_elements.size() << ");\n";
+  for (auto& element : expr.m_elements) {
+    string value = emit(*element);
+    line() << items << ".push_back(" << value << ");\n";
+  }
+
+  string result = temp();
+  line() << "Object " << result << " = runtime::make_list(std::move(" << items << "));\n";
+  Return(result);
+}
+
+void CppEmitter::visitMapExpr(expr::Map &expr) {
+  string keys = temp();
+  string values = temp();
+  line() << "std::vector<Object> " << keys << ";\n";
+  line() << "std::vector<Object> " << values << ";\n";
+  for (std::size_t i = 0; i < expr.m_keys.size(); ++i) {
+    string key = emit(*expr.m_keys[i]);
+    line() << keys << ".push_back(" << key << ");\n";
+    string value = emit(*expr.m_values[i]);
+    line() << values << ".push_back(" << value << ");\n";
+  }
+
+  string result = temp();
+  line() << "Object " << result << " = runtime::make_map(" << keys << ", " << values
+         << ", " << token(expr.m_brace) << ");\n";
+  Return(result);
+}
+
+void CppEmitter::visitIndexExpr(expr::Index &expr) {
+  string obj = emit(*expr.m_object);
+  string index = emit(*expr.m_index);
+  string result = temp();
+  line() << "Object " << result << " = runtime::get_index("
+         << obj << ", " << index << ", " << token(expr.m_bracket) << ");\n";
+  Return(result);
+}
+
+void CppEmitter::visitSetIndexExpr(expr::SetIndex &expr) {
+  string obj = emit(*expr.m_object);
+  string index = emit(*expr.m_index);
+  string value = emit(*expr.m_value);
+  line() << "runtime::set_index(" << obj << ", " << index << ", "
+         << value << ", " << token(expr.m_bracket) << ");\n";
+  Return(value);
+}
+
+void CppEmitter::visitSliceExpr(expr::Slice &expr) {
+  string obj = emit(*expr.m_object);
+  string start = expr.m_start != nullptr ? emit(*expr.m_start) : "Object(nullptr)";
+  string end = expr.m_end != nullptr ? emit(*expr.m_end) : "Object(nullptr)";
+  string result = temp();
+  line() << "Object " << result << " = runtime::slice(" << obj << ", " << start
+         << ", " << end << ", " << token(expr.m_bracket) << ");\n";
+  Return(result);
+}
+
+void CppEmitter::visitUnaryExpr(expr::Unary &expr) {
+  string result = temp();
+
+  if (expr.m_oper.m_type == MINUS
+      && is_numeric_type(expr.m_right->m_static_type)) {
+    string right = number(*expr.m_right);
+    line() << "Object " << result << " = negate(" << right << ").to_object();\n";
+  } else {
+    string right = emit(*expr.m_right);
+    line() << "Object " << result << " = runtime::unary("
+           << token(expr.m_oper) << ", " << right << ");\n";
+  }
+
+  Return(result);
+}
+
+void CppEmitter::visitVariableExpr(expr::Variable &expr) {
+  string result = temp();
+
+  int depth = m_interpreter.local_depth(expr);
+  if (depth >= 0) {
+    line() << "Object " << result << " = env->get_variable_at("
+           << depth << ", " << name(expr.m_name.m_lexeme) << ");\n";
+  } else {
+    line() << "Object " << result << " = globals->get_variable("
+           << token(expr.m_name) << ");\n";
+  }
+
+  Return(result);
+}
+
+
+void CppEmitter::visitBlockStmt(stmt::Block &stmt) {
+  open_block();
+  line() << "Environment block_env(env);\n";
+  line() << "Environment* env = &block_env;\n";
+  emit(stmt.m_statements);
+  close_block();
+}
+
+void CppEmitter::visitClassStmt(stmt::Class &stmt) {
+  open_block();
+  line() << "env->define(" << name(stmt.m_name.m_lexeme) << ", nullptr);\n";
+  line() << "std::unordered_map<std::string, std::shared_ptr<ICallable>> methods;\n";
+
+  for (auto& method : stmt.m_methods) {
+    string fn = emit_function(*method);
+    line() << "methods.insert({" << quote(method->m_name.m_lexeme)
+           << ", " << fn << "});\n";
+  }
+
+  line() << "env->assign(" << token(stmt.m_name) << ", std::make_shared<SlangClass>(SlangClass("
+         << quote(stmt.m_name.m_lexeme) << ", methods)));\n";
+  close_block();
+}
+
+void CppEmitter::visitBreakStmt(stmt::Break &) {
+  if (m_loop_depth > 0) {
+    line() << "break;\n";
+  } else {
+    line() << "throw BreakExc{};\n";
+  }
+}
+
+void CppEmitter::visitExpressionStmt(stmt::Expression &stmt) {
+  open_block();
+  emit(*stmt.m_expression);
+  close_block();
+}
+
+void CppEmitter::visitIfStmt(stmt::If &stmt) {
+  open_block();
+  string condition = emit(*stmt.m_condition);
+  line() << "if (runtime::is_truthy(" << condition << ")) {\n";
+  ++m_indent;
+  emit(*stmt.m_then_branch);
+  --m_indent;
+
+  if (stmt.m_else_branch != nullptr) {
+    line() << "} else {\n";
+    ++m_indent;
+    emit(*stmt.m_else_branch);
+    --m_indent;
+  }
+
+  line() << "}\n";
+  close_block();
+}
+
+void CppEmitter::visitFnStmt(stmt::Fn &stmt) {
+  string fn = emit_function(stmt);
+  line() << "env->define(" << name(stmt.m_name.m_lexeme) << ", " << fn << ");\n";
+}
+
+void CppEmitter::visitImportStmt(stmt::Import &stmt) {
+  // rejected before emitting, see Slang::emit_cpp()
+  line() << "throw RuntimeError(" << token(stmt.m_keyword)
+         << ", \"Compiled scripts can not import modules.\");\n";
+}
+
+void CppEmitter::visitPrintStmt(stmt::Print &stmt) {
+  open_block();
+  string value = emit(*stmt.m_expression);
+  line() << "interp.print(" << value << ");\n";
+  close_block();
+}
+
+void CppEmitter::visitReturnStmt(stmt::Return &stmt) {
+  if (stmt.m_value == nullptr) {
+    line() << "return nullptr;\n";
+    return;
+  }
+
+  open_block();
+  if (m_interpreter.is_tail_call(stmt)) {
+    auto& call = *static_cast<expr::Call*>(stmt.m_value.get());
+    string callee, fn, args, paren;
+    emit_call(call, callee, fn, args, paren);
+
+    // only compiled functions can reuse the caller's frame,
+    // natives and classes are called in place
+    line() << "if (auto compiled = dynamic_cast<CompiledFn*>(" << fn << ")) {\n";
+    ++m_indent;
+    line() << "tail.m_callee = " << callee << ";\n";
+    line() << "tail.m_fn = compiled;\n";
+    line() << "tail.m_args = std::move(" << args << ");\n";
+    line() << "return nullptr;\n";
+    --m_indent;
+    line() << "}\n";
+    line() << "return runtime::call(*" << fn << ", interp, " << args << ", " << paren << ");\n";
+  } else {
+    string value = emit(*stmt.m_value);
+    line() << "return " << value << ";\n";
+  }
+  close_block();
+}
+
+void CppEmitter::visitVarStmt(stmt::Var &stmt) {
+  open_block();
+  string value = "nullptr";
+  if (stmt.m_initializer != nullptr) {
+    value = emit(*stmt.m_initializer);
+  }
+
+  line() << "env->define(" << name(stmt.m_name.m_lexeme) << ", " << value << ");\n";
+  close_block();
+}
+
+void CppEmitter::visitWhileStmt(stmt::While &stmt) {
+  open_block();
+  string condition = emit(*stmt.m_condition);
+  line() << "if (runtime::is_truthy(" << condition << ")) {\n";
+  ++m_indent;
+  line() << "for (;;) {\n";
+  ++m_indent;
+
+  // breaks thrown from called functions end the loop as well
+  line() << "try {\n";
+  ++m_indent;
+  ++m_loop_depth;
+  emit(*stmt.m_then_branch);
+  --m_loop_depth;
+  --m_indent;
+  line() << "} catch (const BreakExc&) {\n";
+  line() << "  break;\n";
+  line() << "}\n";
+
+  condition = emit(*stmt.m_condition);
+  line() << "if (!runtime::is_truthy(" << condition << ")) break;\n";
+  --m_indent;
+  line() << "}\n";
+  --m_indent;
+
+  if (stmt.m_else_branch != nullptr) {
+    line() << "} else {\n";
+    ++m_indent;
+    emit(*stmt.m_else_branch);
+    --m_indent;
+  }
+
+  line() << "}\n";
+  close_block();
+}
+
+// ------------------------ | PRIVATE |
+string CppEmitter::emit(expr::Expr& expr) {
+  return GetValue(expr);
+}
+
+string CppEmitter::number(expr::Expr& expr) {
+  if (auto binary = dynamic_cast<expr::Binary*>(&expr)) {
+    auto oper = binary->m_oper.m_type;
+    if (!is_comparison(oper)
+        && is_numeric_type(binary->m_left->m_static_type)
+        && is_numeric_type(binary->m_right->m_static_type)) {
+      string left = number(*binary->m_left);
+      string right = number(*binary->m_right);
+      return string("arithmetic(") + type_name(oper) + ", " + left + ", " + right + ")";
+    }
+  } else if (auto unary = dynamic_cast<expr::Unary*>(&expr)) {
+    if (unary->m_oper.m_type == MINUS
+        && is_numeric_type(unary->m_right->m_static_type)) {
+      return "negate(" + number(*unary->m_right) + ")";
+    }
+  } else if (auto grouping = dynamic_cast<expr::Grouping*>(&expr)) {
+    return number(*grouping->m_expression);
+  } else if (auto lit = dynamic_cast<expr::Literal*>(&expr)) {
+    if (std::holds_alternative<std::int64_t>(lit->m_value)) {
+      return "Number::from_int(" + literal(lit->m_value) + ")";
+    }
+    return "Number::from_double(" + literal(lit->m_value) + ")";
+  }
+
+  return "Number::from_object(" + emit(expr) + ")";
+}
+
+void CppEmitter::emit(stmt::Stmt& stmt) {
+  stmt.accept(*this);
+}
+
+void CppEmitter::emit(vector<shared_ptr<stmt::Stmt>>& statements) {
+  for (auto& s : statements) {
+    emit(*s);
+  }
+}
+
+void CppEmitter::emit_call(expr::Call& expr, string& callee,
+                           string& fn, string& args, string& paren) {
+  paren = token(expr.m_paren);
+  callee = emit(*expr.m_callee);
+
+  fn = temp();
+  line() << "ICallable* " << fn << " = runtime::as_callable(" << callee << ", " << paren << ");\n";
+  line() << "runtime::check_arity(*" << fn << ", " << expr.m_args.size()
+         << ", " << paren << ");\n";
+
+  args = temp();
+  line() << "std::vector<Object> " << args << ";\n";
+  line() << args << ".reserve(" << expr.m_args.size() << ");\n";
+  for (auto& arg : expr.m_args) {
+    string value = emit(*arg);
+    line() << args << ".push_back(" << value << ");\n";
+  }
+}
+
+string CppEmitter::emit_function(stmt::Fn& fn) {
+  string fn_name = "fn_" + fn.m_name.m_lexeme + "_" + std::to_string(m_fn_count++);
+
+  std::ostringstream body;
+  std::ostringstream* out = m_out;
+  int indent = m_indent;
+  int loop_depth = m_loop_depth;
+  m_out = &body;
+  m_indent = 1;
+  m_loop_depth = 0;
+
+  body << "Object " << fn_name << "(Interpreter& interp, Environment* env, "
+       << "[[maybe_unused]] CompiledFn::TailCall& tail) {\n";
+  line() << "[[maybe_unused]] Environment* globals = interp.get_global_environment();\n";
+  emit(fn.m_body);
+  line() << "return nullptr;\n";
+  body << "}\n\n";
+  m_functions << body.str();
+
+  m_out = out;
+  m_indent = indent;
+  m_loop_depth = loop_depth;
+
+  string params = "std::vector<std::string>{";
+  for (size_t i = 0; i < fn.m_params.size(); ++i) {
+    if (i > 0) params += ", ";
+    params += quote(fn.m_params[i].m_lexeme);
+  }
+  params += "}";
+
+  // the closure is a copy of the defining environment, as in the Interpreter
+  return "std::make_shared<CompiledFn>(" + quote(fn.m_name.m_lexeme) + ", &" + fn_name + ", "
+         + params + ", std::make_unique<Environment>(*env))";
+}
+
+std::ostream& CppEmitter::line() {
+  for (int i = 0; i < m_indent; ++i) {
+    *m_out << "  ";
+  }
+
+  return *m_out;
+}
+
+void CppEmitter::open_block() {
+  line() << "{\n";
+  ++m_indent;
+}
+
+void CppEmitter::close_block() {
+  --m_indent;
+  line() << "}\n";
+}
+
+string CppEmitter::temp() {
+  return "t" + std::to_string(m_temp_count++);
+}
+
+string CppEmitter::name(const string& str) {
+  auto found = m_names.find(str);
+  if (found != m_names.end()) {
+    return found->second;
+  }
+
+  string name = "name" + std::to_string(m_names.size());
+  m_tokens << "const std::string " << name << " = " << quote(str) << ";\n";
+  m_names.insert({str, name});
+  return name;
+}
+
+string CppEmitter::token(const Token& token) {
+  string name = "tok" + std::to_string(m_token_count++);
+  m_tokens << "const Token " << name << "(" << type_name(token.m_type) << ", "
+           << quote(token.m_lexeme) << ", nullptr, " << token.m_line << ");\n";
+  return name;
+}
+
+string CppEmitter::quote(std::string_view str) {
+  std::ostringstream out;
+  out << "std::string(\"";
+  for (unsigned char c : str) {
+    switch (c) {
+      case '"':  out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (c < 0x20 || c >= 0x7f) {
+          out << '\\' << std::oct << std::setw(3) << std::setfill('0')
+              << static_cast<int>(c) << std::dec;
+        } else {
+          out << c;
+        }
+        break;
+    }
+  }
+  out << "\", " << str.size() << ")";
+  return out.str();
+}
+
+string CppEmitter::literal(const Object& value) {
+  if (auto pint = std::get_if<std::int64_t>(&value)) {
+    if (*pint == INT64_MIN) return "std::int64_t(INT64_MIN)";
+    return "std::int64_t(" + std::to_string(*pint) + "LL)";
+  } else if (auto pdouble = std::get_if<double>(&value)) {
+    if (std::isnan(*pdouble)) return "std::nan(\"\")";
+    if (std::isinf(*pdouble)) return *pdouble > 0 ? "HUGE_VAL" : "-HUGE_VAL";
+
+    std::ostringstream out;
+    out << std::hexfloat << *pdouble;
+    return out.str();
+  } else if (auto pbool = std::get_if<bool>(&value)) {
+    return *pbool ? "true" : "false";
+  } else if (auto pstr = std::get_if<SlangString>(&value)) {
+    return quote(pstr->view());
+  }
+
+  return "nullptr";
+}
+
+const char* CppEmitter::type_name(TokenType type) {
+  switch (type) {
+    case LEFT_PAREN:  return "LEFT_PAREN";
+    case RIGHT_PAREN: return "RIGHT_PAREN";
+    case LEFT_BRACE:  return "LEFT_BRACE";
+    case RIGHT_BRACE: return "RIGHT_BRACE";
+    case LEFT_BRACKET:  return "LEFT_BRACKET";
+    case RIGHT_BRACKET: return "RIGHT_BRACKET";
+    case COLON:       return "COLON";
+    case COMMA:       return "COMMA";
+    case DOT:         return "DOT";
+    case MINUS:       return "MINUS";
+    case PLUS:        return "PLUS";
+    case SEMICOLON:   return "SEMICOLON";
+    case SLASH:       return "SLASH";
+    case STAR:        return "STAR";
+    case BANG:        return "BANG";
+    case BANG_EQ:     return "BANG_EQ";
+    case EQ:          return "EQ";
+    case EQ_EQ:       return "EQ_EQ";
+    case GREATER:     return "GREATER";
+    case GREATER_EQ:  return "GREATER_EQ";
+    case LESS:        return "LESS";
+    case LESS_EQ:     return "LESS_EQ";
+    case EQ_GREATER:  return "EQ_GREATER";
+    case IDENTIFIER:  return "IDENTIFIER";
+    case STRING:      return "STRING";
+    case NUMBER:      return "NUMBER";
+    case AND:         return "AND";
+    case BASE:        return "BASE";
+    case BREAK:       return "BREAK";
+    case CLASS:       return "CLASS";
+    case ELSE:        return "ELSE";
+    case FALSE:       return "FALSE";
+    case FOR:         return "FOR";
+    case FN:          return "FN";
+    case IF:          return "IF";
+    case IMPORT:      return "IMPORT";
+    case LET:         return "LET";
+    case NONE:        return "NONE";
+    case OR:          return "OR";
+    case PRINT:       return "PRINT";
+    case RETURN:      return "RETURN";
+    case SELF:        return "SELF";
+    case TRUE:        return "TRUE";
+    case WHILE:       return "WHILE";
+    case END_OF_FILE: return "END_OF_FILE";
+  }
+
+  return "END_OF_FILE";
+}
+
+} // namespace slang
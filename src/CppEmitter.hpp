@@ -0,0 +1,126 @@
+#ifndef __SLANG_CPP_EMITTER_HPP__
+#define __SLANG_CPP_EMITTER_HPP__
+
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Expr.hpp"
+#include "Interpreter.hpp"
+#include "Stmt.hpp"
+
+namespace slang {
+
+using std::vector;
+using std::shared_ptr;
+using std::string;
+using std::unordered_map;
+
+/// Translates a resolved and type-inferred program into a self-contained
+/// C++ translation unit that links against the slangrt runtime library.
+///
+/// The emitted code keeps the Interpreter's environments and runtime
+/// helpers, so scoping, closures, while-else, break and error messages
+/// behave exactly as when the script is interpreted. Expressions the
+/// TypeInferrer proved numeric are compiled to unboxed Number arithmetic.
+class CppEmitter : public expr::ValueGetter<CppEmitter, expr::Expr, string>,
+                   public expr::IVisitor,
+                   public stmt::IVisitor {
+public:
+  /// @interpreter must be the one the program was resolved for.
+  explicit CppEmitter(Interpreter& interpreter);
+
+  CppEmitter(CppEmitter &&) = delete;
+  CppEmitter(const CppEmitter &) = delete;
+  CppEmitter &operator=(CppEmitter &&) = delete;
+  CppEmitter &operator=(const CppEmitter &) = delete;
+  ~CppEmitter() = default;
+
+  /// Writes the translation unit, whose main() runs @statements,
+  /// @source_name only goes into the header comment.
+  void emit(vector<shared_ptr<stmt::Stmt>>& statements,
+            const string& source_name, std::ostream& out);
+
+  void visitAssignExpr(expr::Assign &expr) override;
+  void visitBinaryExpr(expr::Binary &expr) override;
+  void visitCallExpr(expr::Call &expr) override;
+  void visitGetExpr(expr::Get &expr) override;
+  void visitGroupingExpr(expr::Grouping &expr) override;
+  void visitLiteralExpr(expr::Literal &expr) override;
+  void visitLogicalExpr(expr::Logical &expr) override;
+  void visitSetExpr(expr::Set &expr) override;
+  void visitMapExpr(expr::Map &expr) override;
+  void visitListExpr(expr::List &expr) override;
+  void visitIndexExpr(expr::Index &expr) override;
+  void visitSetIndexExpr(expr::SetIndex &expr) override;
+  void visitSliceExpr(expr::Slice &expr) override;
+  void visitUnaryExpr(expr::Unary &expr) override;
+  void visitVariableExpr(expr::Variable &expr) override;
+
+  void visitBlockStmt(stmt::Block &stmt) override;
+  void visitClassStmt(stmt::Class &stmt) override;
+  void visitBreakStmt(stmt::Break &stmt) override;
+  void visitExpressionStmt(stmt::Expression &stmt) override;
+  void visitIfStmt(stmt::If &stmt) override;
+  void visitFnStmt(stmt::Fn &stmt) override;
+  void visitImportStmt(stmt::Import &stmt) override;
+  void visitPrintStmt(stmt::Print &stmt) override;
+  void visitReturnStmt(stmt::Return &stmt) override;
+  void visitVarStmt(stmt::Var &stmt) override;
+  void visitWhileStmt(stmt::While &stmt) override;
+
+private:
+  Interpreter& m_interpreter;
+
+  std::ostringstream m_tokens{};
+  std::ostringstream m_functions{};
+
+  // body of the function being emitted
+  std::ostringstream* m_out{nullptr};
+  int m_indent{0};
+  // loops of the current function around the code being emitted,
+  // a break outside of them has to unwind through a call
+  int m_loop_depth{0};
+
+  std::size_t m_temp_count{0};
+  std::size_t m_token_count{0};
+  std::size_t m_fn_count{0};
+  unordered_map<string, string> m_names{};
+
+  /// Emits the evaluation of @expr, returns the name of the Object holding it.
+  string emit(expr::Expr& expr);
+  /// Returns a C++ expression of type Number for a numeric-typed @expr.
+  string number(expr::Expr& expr);
+  void emit(stmt::Stmt& stmt);
+  void emit(vector<shared_ptr<stmt::Stmt>>& statements);
+
+  /// Emits callee and argument evaluation, sets @callee, @fn, @args and
+  /// @paren to the names of the callee Object, its ICallable, the
+  /// arguments and the Token errors of the call are reported at.
+  void emit_call(expr::Call& expr, string& callee, string& fn,
+                 string& args, string& paren);
+  /// Emits the definition of @fn and returns the expression creating
+  /// its CompiledFn in the current environment.
+  string emit_function(stmt::Fn& fn);
+
+  std::ostream& line();
+  void open_block();
+  void close_block();
+
+  string temp();
+  /// Hoists a constant for variable name @str.
+  string name(const string& str);
+  /// Hoists a constant copy of @token for runtime error reporting.
+  string token(const Token& token);
+
+  static string quote(std::string_view str);
+  static string literal(const Object& value);
+  static const char* type_name(TokenType type);
+};
+
+} // namespace slang
+
+#endif // !__SLANG_CPP_EMITTER_HPP__
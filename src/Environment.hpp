@@ -6,6 +6,7 @@
 #include <string>
 
 #include "InterpreterExceptions.hpp"
+#include "Journal.hpp"
 #include "Token.hpp"
 
 namespace slang {
@@ -23,16 +24,27 @@ public:
   ~Environment() = default;
 
   void define(const std::string& name, const Object& value) {
+    before_write();
     variables[name] = value;
   }
 
   void assign(const Token& name, const Object& value) {
-    auto found = get_iter(name);
-    found->second = value;
+    for (Environment* env = this; env != nullptr; env = env->m_enclosing) {
+      auto found = env->variables.find(name.m_lexeme);
+      if (found != env->variables.end()) {
+        env->before_write();
+        found->second = value;
+        return;
+      }
+    }
+
+    throw RuntimeError(name, "Undefined variable '" + name.m_lexeme + "'.");
   }
 
   void assign_at(int distance, const Token& name, const Object& value) {
-    ancestor(distance)->variables.insert({name.m_lexeme, value});
+    Environment* env = ancestor(distance);
+    env->before_write();
+    env->variables.insert({name.m_lexeme, value});
   }
 
   Object& get_variable(const Token& name) {
@@ -44,10 +56,45 @@ public:
     return ancestor(depth)->variables[name];
   }
 
+  /// Returns the variable @name defined in this very environment,
+  /// nullptr if there is none.
+  const Object* find(const std::string& name) const {
+    auto found = variables.find(name);
+    return found != variables.end() ? &found->second : nullptr;
+  }
+
+  /// Calls @fn with the name and value of every variable
+  /// defined in this very environment.
+  template <typename Fn>
+  void for_each(Fn fn) const {
+    for (const auto& [name, value] : variables) {
+      fn(name, value);
+    }
+  }
+
+  /// Drops all variables and re-parents the environment,
+  /// keeps the allocated buckets for reuse.
+  void reset(Environment* enclosing) {
+    before_write();
+    variables.clear();
+    m_enclosing = enclosing;
+  }
+
 private:
+  friend class HeapPin;
+  friend class HeapReader;
+  friend class HeapWriter;
+  friend class Journal;
+
   Environment* m_enclosing{nullptr};
   std::unordered_map<std::string, Object> variables{};
+  JournalLink m_link{};
 
+  void before_write() {
+    if (m_link.m_journal != nullptr) {
+      m_link.m_journal->save(*this);
+    }
+  }
 
   using iterator = std::unordered_map<std::string, Object>::iterator;
 
@@ -13,6 +13,10 @@ namespace slang {
 class ErrorReporter {
 public:
   ErrorReporter() = default;
+
+  /// Writes the reports to @out instead of stderr.
+  explicit ErrorReporter(std::ostream& out) : m_out(&out) {}
+
   ErrorReporter(ErrorReporter &&) = default;
   ErrorReporter(const ErrorReporter &) = default;
   ErrorReporter &operator=(ErrorReporter &&) = default;
@@ -22,7 +26,13 @@ public:
   void report(int line, const std::string& where, const std::string& msg) {
     std::stringstream ss;
     ss << "[line " << line << "] Error " << where << ": " << msg;
-    std::cerr << ss.str() << std::endl;
+    *m_out << ss.str() << std::endl;
+    m_has_error = true;
+  }
+
+  /// Passes on compile errors another reporter wrote as @reports.
+  void relay(const std::string& reports) {
+    *m_out << reports << std::flush;
     m_has_error = true;
   }
 
@@ -41,7 +51,7 @@ public:
   void runtime_error(const RuntimeError& e) {
     std::stringstream ss;
     ss << e.what() << "\n[line " + std::to_string(e.m_token.m_line) << "]";
-    std::cerr << ss.str() << std::endl;
+    *m_out << ss.str() << std::endl;
     m_has_runtime_error = true;
   }
 
@@ -49,9 +59,13 @@ public:
 
   bool has_runtime_error() const { return m_has_runtime_error; }
 
-  void discard_error_state() { m_has_error = false; }
+  void discard_error_state() {
+    m_has_error = false;
+    m_has_runtime_error = false;
+  }
 
 private:
+  std::ostream* m_out{&std::cerr};
   bool m_has_error{false};
   bool m_has_runtime_error{false};
 };
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "Token.hpp"
+#include "StaticType.hpp"
 
 namespace slang {
 
@@ -15,9 +16,14 @@ class Binary;
 class Call;
 class Get;
 class Grouping;
+class Index;
+class List;
 class Literal;
 class Logical;
+class Map;
 class Set;
+class SetIndex;
+class Slice;
 class Unary;
 class Variable;
 
@@ -35,9 +41,14 @@ public:
   virtual void visitCallExpr(Call& expr) = 0;
   virtual void visitGetExpr(Get& expr) = 0;
   virtual void visitGroupingExpr(Grouping& expr) = 0;
+  virtual void visitIndexExpr(Index& expr) = 0;
+  virtual void visitListExpr(List& expr) = 0;
   virtual void visitLiteralExpr(Literal& expr) = 0;
   virtual void visitLogicalExpr(Logical& expr) = 0;
+  virtual void visitMapExpr(Map& expr) = 0;
   virtual void visitSetExpr(Set& expr) = 0;
+  virtual void visitSetIndexExpr(SetIndex& expr) = 0;
+  virtual void visitSliceExpr(Slice& expr) = 0;
   virtual void visitUnaryExpr(Unary& expr) = 0;
   virtual void visitVariableExpr(Variable& expr) = 0;
 };
@@ -53,6 +64,8 @@ public:
 
   virtual void accept(IVisitor& visitor) = 0;
 
+  StaticType m_static_type{TYPE_ANY};
+
 };
 
 template <class Visitor, class Visitable, class R>
@@ -196,6 +209,54 @@ public:
 
 };
 
+class Index : public Expr {
+public:
+  Index(const std::shared_ptr<Expr>& object, const Token& bracket, const std::shared_ptr<Expr>& index) :
+    Expr(),
+    m_object(object),
+    m_bracket(bracket),
+    m_index(index)
+  {}
+
+  Index(const Index&) = default;
+  Index(Index&&) = default;
+  Index& operator=(const Index&) = default;
+  Index& operator=(Index&&) = default;
+  virtual ~Index() = default;
+
+  void accept(IVisitor& visitor) override {
+    visitor.visitIndexExpr(*this);
+  }
+
+  std::shared_ptr<Expr> m_object;
+  Token m_bracket;
+  std::shared_ptr<Expr> m_index;
+
+};
+
+class List : public Expr {
+public:
+  List(const Token& bracket, const std::vector<std::shared_ptr<Expr>>& elements) :
+    Expr(),
+    m_bracket(bracket),
+    m_elements(elements)
+  {}
+
+  List(const List&) = default;
+  List(List&&) = default;
+  List& operator=(const List&) = default;
+  List& operator=(List&&) = default;
+  virtual ~List() = default;
+
+  void accept(IVisitor& visitor) override {
+    visitor.visitListExpr(*this);
+  }
+
+  Token m_bracket;
+  std::vector<std::shared_ptr<Expr>> m_elements;
+
+};
+
 class Literal : public Expr {
 public:
   Literal(const Object& value) :
@@ -242,6 +303,31 @@ public:
 
 };
 
+class Map : public Expr {
+public:
+  Map(const Token& brace, const std::vector<std::shared_ptr<Expr>>& keys, const std::vector<std::shared_ptr<Expr>>& values) :
+    Expr(),
+    m_brace(brace),
+    m_keys(keys),
+    m_values(values)
+  {}
+
+  Map(const Map&) = default;
+  Map(Map&&) = default;
+  Map& operator=(const Map&) = default;
+  Map& operator=(Map&&) = default;
+  virtual ~Map() = default;
+
+  void accept(IVisitor& visitor) override {
+    visitor.visitMapExpr(*this);
+  }
+
+  Token m_brace;
+  std::vector<std::shared_ptr<Expr>> m_keys;
+  std::vector<std::shared_ptr<Expr>> m_values;
+
+};
+
 class Set : public Expr {
 public:
   Set(const std::shared_ptr<Expr>& object, const Token& name, const std::shared_ptr<Expr>& value) :
@@ -267,6 +353,60 @@ public:
 
 };
 
+class SetIndex : public Expr {
+public:
+  SetIndex(const std::shared_ptr<Expr>& object, const Token& bracket, const std::shared_ptr<Expr>& index, const std::shared_ptr<Expr>& value) :
+    Expr(),
+    m_object(object),
+    m_bracket(bracket),
+    m_index(index),
+    m_value(value)
+  {}
+
+  SetIndex(const SetIndex&) = default;
+  SetIndex(SetIndex&&) = default;
+  SetIndex& operator=(const SetIndex&) = default;
+  SetIndex& operator=(SetIndex&&) = default;
+  virtual ~SetIndex() = default;
+
+  void accept(IVisitor& visitor) override {
+    visitor.visitSetIndexExpr(*this);
+  }
+
+  std::shared_ptr<Expr> m_object;
+  Token m_bracket;
+  std::shared_ptr<Expr> m_index;
+  std::shared_ptr<Expr> m_value;
+
+};
+
+class Slice : public Expr {
+public:
+  Slice(const std::shared_ptr<Expr>& object, const Token& bracket, const std::shared_ptr<Expr>& start, const std::shared_ptr<Expr>& end) :
+    Expr(),
+    m_object(object),
+    m_bracket(bracket),
+    m_start(start),
+    m_end(end)
+  {}
+
+  Slice(const Slice&) = default;
+  Slice(Slice&&) = default;
+  Slice& operator=(const Slice&) = default;
+  Slice& operator=(Slice&&) = default;
+  virtual ~Slice() = default;
+
+  void accept(IVisitor& visitor) override {
+    visitor.visitSliceExpr(*this);
+  }
+
+  std::shared_ptr<Expr> m_object;
+  Token m_bracket;
+  std::shared_ptr<Expr> m_start;
+  std::shared_ptr<Expr> m_end;
+
+};
+
 class Unary : public Expr {
 public:
   Unary(const Token& oper, const std::shared_ptr<Expr>& right) :
@@ -0,0 +1,575 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "HeapImage.hpp"
+#include "ICallable.hpp"
+#include "SlangClass.hpp"
+#include "SlangFn.hpp"
+#include "SlangArray.hpp"
+#include "SlangInstance.hpp"
+#include "SlangList.hpp"
+#include "SlangMap.hpp"
+
+namespace slang {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+struct HeapImageHeader {
+  char m_magic[4];
+  // bump whenever the layout of the heap or of AstWriter images changes
+  std::uint32_t m_version;
+  std::uint64_t m_ast_size;
+};
+
+static const char HEAP_IMAGE_MAGIC[4] = {'S', 'L', 'G', 'H'};
+static constexpr std::uint32_t HEAP_IMAGE_VERSION = 5;
+
+enum ValueKind : std::uint8_t {
+  VALUE_NIL, VALUE_FALSE, VALUE_TRUE, VALUE_INT, VALUE_DOUBLE, VALUE_STRING,
+  VALUE_CALLABLE, VALUE_CALLABLE_REF, VALUE_INSTANCE, VALUE_LIST,
+  VALUE_MAP, VALUE_ARRAY
+};
+
+static bool is_native(const ICallable& callable) {
+  return callable.to_string().rfind("<native fn", 0) == 0;
+}
+
+} // namespace helpers
+
+// ------------------------ | WRITER |
+HeapWriter::HeapWriter(Interpreter& interpreter)
+  : m_ast(interpreter)
+{}
+
+void HeapWriter::write(vector<shared_ptr<stmt::Stmt>>& statements,
+                       Environment& globals, string& out) {
+  m_out = &out;
+
+  helpers::HeapImageHeader header;
+  std::memcpy(header.m_magic, helpers::HEAP_IMAGE_MAGIC, sizeof(header.m_magic));
+  header.m_version = helpers::HEAP_IMAGE_VERSION;
+  header.m_ast_size = 0;
+
+  std::size_t header_at = out.size();
+  out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  m_ast.write(statements, out);
+  header.m_ast_size = out.size() - header_at - sizeof(header);
+  std::memcpy(&out[header_at], &header, sizeof(header));
+
+  collect(globals);
+  number_callables();
+
+  put_u32(m_environments.size());
+
+  put_u32(m_natives.size());
+  for (ICallable* native : m_natives) {
+    put_string(native->to_string());
+  }
+
+  put_u32(m_functions.size());
+  for (SlangFn* fn : m_functions) {
+    auto index = m_ast.function_index(fn->m_declaration);
+    if (!index.has_value()) {
+      throw std::runtime_error("'" + fn->to_string() + "' is not part of the program.");
+    }
+
+    put_u32(*index);
+    put_u32(m_environment_ids.at(fn->m_closure.get()));
+    put_u32(m_environment_ids.at(fn->m_globals));
+  }
+
+  put_u32(m_classes.size());
+  for (SlangClass* cls : m_classes) {
+    put_string(cls->m_name);
+    put_u32(cls->m_methods.size());
+    for (auto& [name, method] : cls->m_methods) {
+      put_string(name);
+      put_u32(m_callable_ids.at(method.get()));
+    }
+  }
+
+  put_u32(m_instances.size());
+  for (SlangInstance* instance : m_instances) {
+    put_u32(m_callable_ids.at(instance->m_cls));
+  }
+
+  put_u32(m_lists.size());
+  put_u32(m_maps.size());
+  put_u32(m_arrays.size());
+
+  for (Environment* env : m_environments) {
+    put_environment(*env);
+  }
+
+  for (SlangInstance* instance : m_instances) {
+    put_u32(instance->m_fields.size());
+    for (auto& [name, value] : instance->m_fields) {
+      put_string(name);
+      put_value(value);
+    }
+  }
+
+  for (SlangList* list : m_lists) {
+    put_u32(list->m_items.size());
+    for (auto& item : list->m_items) {
+      put_value(item);
+    }
+  }
+
+  for (SlangMap* map : m_maps) {
+    put_u32(map->size());
+    for (auto& entry : map->m_entries) {
+      if (entry.m_removed) continue;
+
+      put_value(entry.m_key);
+      put_value(entry.m_value);
+    }
+  }
+
+  // the elements as they are in memory, read back with a copy
+  for (SlangArray* array : m_arrays) {
+    put_u8(array->m_type);
+    put_u32(array->size());
+    if (array->m_type == SlangArray::FLOAT64) {
+      m_out->append(reinterpret_cast<const char*>(array->m_floats.data()),
+                    array->m_floats.size() * sizeof(double));
+    } else {
+      m_out->append(reinterpret_cast<const char*>(array->m_ints.data()),
+                    array->m_ints.size() * sizeof(std::int64_t));
+    }
+  }
+
+  m_out = nullptr;
+}
+
+void HeapWriter::collect(Environment& env) {
+  for (Environment* current = &env; current != nullptr; current = current->m_enclosing) {
+    auto id = static_cast<std::uint32_t>(m_environments.size());
+    if (!m_environment_ids.insert({current, id}).second) return;
+
+    m_environments.push_back(current);
+    for (const auto& [name, value] : current->variables) {
+      collect(value);
+    }
+  }
+}
+
+void HeapWriter::collect(const Object& value) {
+  if (auto callable = std::get_if<std::shared_ptr<ICallable>>(&value)) {
+    collect(callable->get());
+  } else if (auto callable = std::get_if<ICallable*>(&value)) {
+    collect(*callable);
+  } else if (auto instance = std::get_if<std::shared_ptr<SlangInstance>>(&value)) {
+    auto id = static_cast<std::uint32_t>(m_instances.size());
+    if (!m_instance_ids.insert({instance->get(), id}).second) return;
+
+    m_instances.push_back(instance->get());
+    // instances do not own their class
+    collect(const_cast<SlangClass*>((*instance)->m_cls));
+    for (const auto& [name, field] : (*instance)->m_fields) {
+      collect(field);
+    }
+  } else if (auto list = std::get_if<std::shared_ptr<SlangList>>(&value)) {
+    auto id = static_cast<std::uint32_t>(m_lists.size());
+    if (!m_list_ids.insert({list->get(), id}).second) return;
+
+    m_lists.push_back(list->get());
+    for (const auto& item : (*list)->m_items) {
+      collect(item);
+    }
+  } else if (auto map = std::get_if<std::shared_ptr<SlangMap>>(&value)) {
+    auto id = static_cast<std::uint32_t>(m_maps.size());
+    if (!m_map_ids.insert({map->get(), id}).second) return;
+
+    m_maps.push_back(map->get());
+    for (const auto& entry : (*map)->m_entries) {
+      collect(entry.m_key);
+      collect(entry.m_value);
+    }
+  } else if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&value)) {
+    auto id = static_cast<std::uint32_t>(m_arrays.size());
+    if (!m_array_ids.insert({array->get(), id}).second) return;
+
+    m_arrays.push_back(array->get());
+  }
+}
+
+void HeapWriter::collect(ICallable* callable) {
+  // numbered once all of them are known
+  if (!m_callable_ids.insert({callable, 0}).second) return;
+
+  if (auto fn = dynamic_cast<SlangFn*>(callable)) {
+    m_functions.push_back(fn);
+    collect(*fn->m_closure);
+    // the globals of the module that defined it
+    collect(*fn->m_globals);
+  } else if (auto cls = dynamic_cast<SlangClass*>(callable)) {
+    m_classes.push_back(cls);
+    for (auto& [name, method] : cls->m_methods) {
+      collect(method.get());
+    }
+  } else if (helpers::is_native(*callable)) {
+    m_natives.push_back(callable);
+  } else {
+    throw std::runtime_error("'" + callable->to_string() + "' can not be saved in an image.");
+  }
+}
+
+void HeapWriter::number_callables() {
+  std::uint32_t id = 0;
+  for (ICallable* native : m_natives) m_callable_ids[native] = id++;
+  for (SlangFn* fn : m_functions) m_callable_ids[fn] = id++;
+  for (SlangClass* cls : m_classes) m_callable_ids[cls] = id++;
+}
+
+void HeapWriter::put_environment(const Environment& env) {
+  // 0 for none, the id of the enclosing environment plus one otherwise
+  put_u32(env.m_enclosing != nullptr ? m_environment_ids.at(env.m_enclosing) + 1 : 0);
+
+  put_u32(env.variables.size());
+  for (const auto& [name, value] : env.variables) {
+    put_string(name);
+    put_value(value);
+  }
+}
+
+void HeapWriter::put_value(const Object& value) {
+  if (auto pint = std::get_if<std::int64_t>(&value)) {
+    put_u8(helpers::VALUE_INT);
+    put_i64(*pint);
+  } else if (auto pdouble = std::get_if<double>(&value)) {
+    put_u8(helpers::VALUE_DOUBLE);
+    put_f64(*pdouble);
+  } else if (auto pbool = std::get_if<bool>(&value)) {
+    put_u8(*pbool ? helpers::VALUE_TRUE : helpers::VALUE_FALSE);
+  } else if (auto pstr = std::get_if<SlangString>(&value)) {
+    put_u8(helpers::VALUE_STRING);
+    put_string(pstr->view());
+  } else if (auto callable = std::get_if<std::shared_ptr<ICallable>>(&value)) {
+    put_u8(helpers::VALUE_CALLABLE);
+    put_u32(m_callable_ids.at(callable->get()));
+  } else if (auto callable = std::get_if<ICallable*>(&value)) {
+    put_u8(helpers::VALUE_CALLABLE_REF);
+    put_u32(m_callable_ids.at(*callable));
+  } else if (auto instance = std::get_if<std::shared_ptr<SlangInstance>>(&value)) {
+    put_u8(helpers::VALUE_INSTANCE);
+    put_u32(m_instance_ids.at(instance->get()));
+  } else if (auto list = std::get_if<std::shared_ptr<SlangList>>(&value)) {
+    put_u8(helpers::VALUE_LIST);
+    put_u32(m_list_ids.at(list->get()));
+  } else if (auto map = std::get_if<std::shared_ptr<SlangMap>>(&value)) {
+    put_u8(helpers::VALUE_MAP);
+    put_u32(m_map_ids.at(map->get()));
+  } else if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&value)) {
+    put_u8(helpers::VALUE_ARRAY);
+    put_u32(m_array_ids.at(array->get()));
+  } else {
+    put_u8(helpers::VALUE_NIL);
+  }
+}
+
+void HeapWriter::put_string(std::string_view str) {
+  put_u32(str.size());
+  m_out->append(str);
+}
+
+void HeapWriter::put_u8(std::uint8_t value) {
+  m_out->push_back(static_cast<char>(value));
+}
+
+void HeapWriter::put_u32(std::uint32_t value) {
+  m_out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void HeapWriter::put_i64(std::int64_t value) {
+  m_out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void HeapWriter::put_f64(double value) {
+  m_out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// ------------------------ | READER |
+HeapReader::HeapReader(const char* data, std::size_t size)
+  : m_ast(data),
+    m_current(data),
+    m_end(data + size)
+{
+  helpers::HeapImageHeader header;
+  std::memcpy(&header, take(sizeof(header)), sizeof(header));
+  if (0 != std::memcmp(header.m_magic, helpers::HEAP_IMAGE_MAGIC, sizeof(header.m_magic))
+      || header.m_version != helpers::HEAP_IMAGE_VERSION
+      || header.m_ast_size > static_cast<std::uint64_t>(m_end - m_current)) {
+    throw CorruptImage();
+  }
+
+  m_ast = m_current;
+  m_ast_size = header.m_ast_size;
+  m_current += m_ast_size;
+}
+
+vector<shared_ptr<stmt::Stmt>> HeapReader::read_program(Interpreter& interpreter) {
+  AstReader reader(interpreter, m_ast, m_ast_size);
+  auto statements = reader.read();
+  m_functions = reader.functions();
+  return statements;
+}
+
+void HeapReader::read_heap(Environment& globals, LoadedHeap& heap) {
+  // the natives of the new interpreter stand in for the saved ones
+  std::unordered_map<string, Object> natives;
+  for (const auto& [name, value] : globals.variables) {
+    if (auto callable = std::get_if<std::shared_ptr<ICallable>>(&value)) {
+      natives.insert({(*callable)->to_string(), value});
+    }
+  }
+
+  std::uint32_t environment_count = get_count();
+  if (environment_count == 0) {
+    throw CorruptImage();
+  }
+
+  // owned by the image until a function takes its closure
+  vector<std::unique_ptr<Environment>> environments(environment_count);
+  m_environments.assign(environment_count, &globals);
+  for (std::uint32_t i = 1; i < environment_count; ++i) {
+    environments[i] = std::make_unique<Environment>();
+    m_environments[i] = environments[i].get();
+  }
+
+  std::uint32_t native_count = get_count();
+  for (std::uint32_t i = 0; i < native_count; ++i) {
+    auto native = natives.find(get_string());
+    if (native == natives.end()) {
+      throw CorruptImage();
+    }
+    m_callables.push_back(native->second);
+  }
+
+  std::uint32_t function_count = get_count();
+  for (std::uint32_t i = 0; i < function_count; ++i) {
+    stmt::Fn* declaration = m_functions[get_index(m_functions.size())];
+    auto closure = std::move(environments[get_index(environment_count)]);
+    if (closure == nullptr) {
+      // the globals, or the closure of another function
+      throw CorruptImage();
+    }
+    Environment* fn_globals = m_environments[get_index(environment_count)];
+
+    m_callables.push_back(std::make_shared<SlangFn>(
+        SlangFn(*declaration, std::move(closure), fn_globals)));
+  }
+
+  std::uint32_t class_count = get_count();
+  for (std::uint32_t i = 0; i < class_count; ++i) {
+    auto name = get_string();
+
+    std::unordered_map<string, shared_ptr<ICallable>> methods;
+    std::uint32_t method_count = get_count();
+    for (std::uint32_t j = 0; j < method_count; ++j) {
+      auto method_name = get_string();
+      auto method = get_index(native_count + function_count);
+      if (method < native_count) {
+        throw CorruptImage();
+      }
+      methods.insert({method_name, std::get<shared_ptr<ICallable>>(m_callables[method])});
+    }
+
+    m_callables.push_back(std::make_shared<SlangClass>(SlangClass(name, methods)));
+  }
+
+  std::uint32_t instance_count = get_count();
+  for (std::uint32_t i = 0; i < instance_count; ++i) {
+    auto cls = get_index(m_callables.size());
+    if (cls < native_count + function_count) {
+      throw CorruptImage();
+    }
+
+    auto callable = std::get<shared_ptr<ICallable>>(m_callables[cls]);
+    m_instances.push_back(std::make_shared<SlangInstance>(
+        static_cast<const SlangClass*>(callable.get())));
+  }
+
+  std::uint32_t list_count = get_count();
+  for (std::uint32_t i = 0; i < list_count; ++i) {
+    m_lists.push_back(std::make_shared<SlangList>());
+  }
+
+  std::uint32_t map_count = get_count();
+  for (std::uint32_t i = 0; i < map_count; ++i) {
+    m_maps.push_back(std::make_shared<SlangMap>());
+  }
+
+  std::uint32_t array_count = get_count();
+  for (std::uint32_t i = 0; i < array_count; ++i) {
+    m_arrays.push_back(std::make_shared<SlangArray>(SlangArray::FLOAT64, 0));
+  }
+
+  for (Environment* env : m_environments) {
+    std::uint32_t enclosing = get_u32();
+    if (enclosing > environment_count) {
+      throw CorruptImage();
+    }
+    env->m_enclosing = enclosing != 0 ? m_environments[enclosing - 1] : nullptr;
+
+    std::uint32_t variable_count = get_count();
+    for (std::uint32_t i = 0; i < variable_count; ++i) {
+      auto name = get_string();
+      env->define(name, get_value());
+    }
+  }
+
+  for (auto& instance : m_instances) {
+    auto& fields = std::get<shared_ptr<SlangInstance>>(instance)->m_fields;
+
+    std::uint32_t field_count = get_count();
+    for (std::uint32_t i = 0; i < field_count; ++i) {
+      auto name = get_string();
+      fields.insert_or_assign(name, get_value());
+    }
+  }
+
+  for (auto& list : m_lists) {
+    auto& items = std::get<shared_ptr<SlangList>>(list)->m_items;
+
+    std::uint32_t item_count = get_count();
+    items.reserve(item_count);
+    for (std::uint32_t i = 0; i < item_count; ++i) {
+      items.push_back(get_value());
+    }
+  }
+
+  for (auto& map : m_maps) {
+    auto& target = *std::get<shared_ptr<SlangMap>>(map);
+
+    std::uint32_t entry_count = get_count();
+    for (std::uint32_t i = 0; i < entry_count; ++i) {
+      auto key = get_value();
+      if (!SlangMap::is_key(key)) {
+        throw CorruptImage();
+      }
+      target.set(key, get_value());
+    }
+  }
+
+  for (auto& array : m_arrays) {
+    auto& target = *std::get<shared_ptr<SlangArray>>(array);
+
+    std::uint8_t type = get_u8();
+    if (type != SlangArray::FLOAT64 && type != SlangArray::INT64) {
+      throw CorruptImage();
+    }
+    target.m_type = static_cast<SlangArray::ElementType>(type);
+
+    std::uint32_t size = get_u32();
+    if (static_cast<std::size_t>(m_end - m_current) / sizeof(double) < size) {
+      throw CorruptImage();
+    }
+
+    const char* elements = take(size * sizeof(double));
+    if (target.m_type == SlangArray::FLOAT64) {
+      target.m_floats.resize(size);
+      std::memcpy(target.m_floats.data(), elements, size * sizeof(double));
+    } else {
+      target.m_ints.resize(size);
+      std::memcpy(target.m_ints.data(), elements, size * sizeof(std::int64_t));
+    }
+  }
+
+  if (m_current != m_end) {
+    throw CorruptImage();
+  }
+
+  for (auto& env : environments) {
+    if (env != nullptr) {
+      heap.m_environments.push_back(std::move(env));
+    }
+  }
+  heap.m_objects.insert(heap.m_objects.end(), m_callables.begin(), m_callables.end());
+  heap.m_objects.insert(heap.m_objects.end(), m_instances.begin(), m_instances.end());
+  heap.m_objects.insert(heap.m_objects.end(), m_lists.begin(), m_lists.end());
+  heap.m_objects.insert(heap.m_objects.end(), m_maps.begin(), m_maps.end());
+  heap.m_objects.insert(heap.m_objects.end(), m_arrays.begin(), m_arrays.end());
+}
+
+Object HeapReader::get_value() {
+  switch (get_u8()) {
+    case helpers::VALUE_NIL:          return nullptr;
+    case helpers::VALUE_FALSE:        return false;
+    case helpers::VALUE_TRUE:         return true;
+    case helpers::VALUE_INT:          return get_i64();
+    case helpers::VALUE_DOUBLE:       return get_f64();
+    case helpers::VALUE_STRING:       return get_string();
+    case helpers::VALUE_CALLABLE:     return m_callables[get_index(m_callables.size())];
+    case helpers::VALUE_CALLABLE_REF: {
+      auto& callable = m_callables[get_index(m_callables.size())];
+      return std::get<shared_ptr<ICallable>>(callable).get();
+    }
+    case helpers::VALUE_INSTANCE:     return m_instances[get_index(m_instances.size())];
+    case helpers::VALUE_LIST:         return m_lists[get_index(m_lists.size())];
+    case helpers::VALUE_MAP:          return m_maps[get_index(m_maps.size())];
+    case helpers::VALUE_ARRAY:        return m_arrays[get_index(m_arrays.size())];
+    default:
+      throw CorruptImage();
+  }
+}
+
+string HeapReader::get_string() {
+  std::uint32_t size = get_u32();
+  return string(take(size), size);
+}
+
+std::uint8_t HeapReader::get_u8() {
+  return static_cast<std::uint8_t>(*take(1));
+}
+
+std::uint32_t HeapReader::get_u32() {
+  std::uint32_t value;
+  std::memcpy(&value, take(sizeof(value)), sizeof(value));
+  return value;
+}
+
+std::int64_t HeapReader::get_i64() {
+  std::int64_t value;
+  std::memcpy(&value, take(sizeof(value)), sizeof(value));
+  return value;
+}
+
+double HeapReader::get_f64() {
+  double value;
+  std::memcpy(&value, take(sizeof(value)), sizeof(value));
+  return value;
+}
+
+std::uint32_t HeapReader::get_count() {
+  // every element takes at least a byte,
+  // so a corrupt count can not make us allocate more than the image
+  std::uint32_t count = get_u32();
+  if (static_cast<std::size_t>(m_end - m_current) < count) {
+    throw CorruptImage();
+  }
+
+  return count;
+}
+
+std::uint32_t HeapReader::get_index(std::size_t count) {
+  std::uint32_t index = get_u32();
+  if (index >= count) {
+    throw CorruptImage();
+  }
+
+  return index;
+}
+
+const char* HeapReader::take(std::size_t count) {
+  if (static_cast<std::size_t>(m_end - m_current) < count) {
+    throw CorruptImage();
+  }
+
+  const char* data = m_current;
+  m_current += count;
+  return data;
+}
+
+} // namespace slang
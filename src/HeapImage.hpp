@@ -0,0 +1,140 @@
+#ifndef __SLANG_HEAP_IMAGE_HPP__
+#define __SLANG_HEAP_IMAGE_HPP__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "AstSerializer.hpp"
+#include "Environment.hpp"
+#include "Interpreter.hpp"
+#include "Stmt.hpp"
+
+namespace slang {
+
+using std::vector;
+using std::shared_ptr;
+using std::string;
+
+/// What a loaded heap image needs kept alive besides the globals: every
+/// object it created, since objects also refer to each other by plain
+/// pointers, and the environments no function owns.
+struct LoadedHeap {
+  vector<Object> m_objects{};
+  vector<std::unique_ptr<Environment>> m_environments{};
+};
+
+/// Writes a program together with its heap into an image file: the
+/// compiled statements as AstWriter writes them, followed by the globals
+/// and every environment, function, class, instance, list, map and
+/// array reachable from them. Objects refer to each other by index instead of by address, so
+/// the image can be mapped anywhere and read in place.
+class HeapWriter {
+public:
+  /// @interpreter must be the one the program was resolved for.
+  explicit HeapWriter(Interpreter& interpreter);
+
+  HeapWriter(HeapWriter &&) = delete;
+  HeapWriter(const HeapWriter &) = delete;
+  HeapWriter &operator=(HeapWriter &&) = delete;
+  HeapWriter &operator=(const HeapWriter &) = delete;
+  ~HeapWriter() = default;
+
+  /// Appends the image of @statements and @globals to @out. Throws
+  /// std::runtime_error for objects an image can not hold.
+  void write(vector<shared_ptr<stmt::Stmt>>& statements,
+             Environment& globals, string& out);
+
+private:
+  AstWriter m_ast;
+  string* m_out{nullptr};
+
+  // the globals are always the first environment
+  vector<Environment*> m_environments{};
+  std::unordered_map<const Environment*, std::uint32_t> m_environment_ids{};
+
+  // natives, functions and classes, in the order they are read back
+  vector<ICallable*> m_natives{};
+  vector<SlangFn*> m_functions{};
+  vector<SlangClass*> m_classes{};
+  std::unordered_map<const ICallable*, std::uint32_t> m_callable_ids{};
+
+  vector<SlangInstance*> m_instances{};
+  std::unordered_map<const SlangInstance*, std::uint32_t> m_instance_ids{};
+
+  vector<SlangList*> m_lists{};
+  std::unordered_map<const SlangList*, std::uint32_t> m_list_ids{};
+
+  vector<SlangMap*> m_maps{};
+  std::unordered_map<const SlangMap*, std::uint32_t> m_map_ids{};
+
+  vector<SlangArray*> m_arrays{};
+  std::unordered_map<const SlangArray*, std::uint32_t> m_array_ids{};
+
+  void collect(Environment& env);
+  void collect(const Object& value);
+  void collect(ICallable* callable);
+  void number_callables();
+
+  void put_environment(const Environment& env);
+  void put_value(const Object& value);
+  void put_string(std::string_view str);
+  void put_u8(std::uint8_t value);
+  void put_u32(std::uint32_t value);
+  void put_i64(std::int64_t value);
+  void put_f64(double value);
+};
+
+/// Reads an image written by HeapWriter in place, usually from a
+/// mapped file.
+class HeapReader {
+public:
+  /// Throws CorruptImage if @data does not start with an image header.
+  HeapReader(const char* data, std::size_t size);
+
+  HeapReader(HeapReader &&) = delete;
+  HeapReader(const HeapReader &) = delete;
+  HeapReader &operator=(HeapReader &&) = delete;
+  HeapReader &operator=(const HeapReader &) = delete;
+  ~HeapReader() = default;
+
+  /// Rebuilds the program and registers it with @interpreter,
+  /// see AstReader::read().
+  vector<shared_ptr<stmt::Stmt>> read_program(Interpreter& interpreter);
+
+  /// Defines the saved globals in @globals, which must still hold the
+  /// natives of a new interpreter, and rebuilds everything they refer to
+  /// into @heap. Must follow read_program(), throws CorruptImage.
+  void read_heap(Environment& globals, LoadedHeap& heap);
+
+private:
+  const char* m_ast;
+  std::size_t m_ast_size{0};
+  const char* m_current;
+  const char* m_end;
+  vector<stmt::Fn*> m_functions{};
+
+  vector<Environment*> m_environments{};
+  vector<Object> m_callables{};
+  vector<Object> m_instances{};
+  vector<Object> m_lists{};
+  vector<Object> m_maps{};
+  vector<Object> m_arrays{};
+
+  Object get_value();
+  string get_string();
+  std::uint8_t get_u8();
+  std::uint32_t get_u32();
+  std::int64_t get_i64();
+  double get_f64();
+  std::uint32_t get_count();
+  std::uint32_t get_index(std::size_t count);
+  const char* take(std::size_t count);
+};
+
+} // namespace slang
+
+#endif // !__SLANG_HEAP_IMAGE_HPP__
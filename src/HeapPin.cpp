@@ -0,0 +1,81 @@
+#include "Environment.hpp"
+#include "HeapPin.hpp"
+#include "ICallable.hpp"
+#include "SlangArray.hpp"
+#include "SlangInstance.hpp"
+#include "SlangList.hpp"
+#include "SlangMap.hpp"
+
+namespace slang {
+
+// ------------------------ | PUBLIC |
+HeapPin::HeapPin()
+  : m_owner(std::make_shared<Owner>())
+{}
+
+void HeapPin::pin(Environment& env) {
+  for (Environment* current = &env; current != nullptr; current = current->m_enclosing) {
+    if (!m_seen.insert(current).second) return;
+
+    for (auto& [name, value] : current->variables) {
+      pin(value);
+    }
+  }
+}
+
+void HeapPin::pin(Object& value) {
+  if (auto str = std::get_if<SlangString>(&value)) {
+    str->pin();
+  } else if (auto callable = std::get_if<std::shared_ptr<ICallable>>(&value)) {
+    pin(*callable);
+  } else if (auto callable = std::get_if<ICallable*>(&value)) {
+    // a function referring to itself, owned by a shared pointer elsewhere
+    if (m_seen.insert(*callable).second) {
+      (*callable)->pin(*this);
+    }
+  } else if (auto instance = std::get_if<std::shared_ptr<SlangInstance>>(&value)) {
+    if (!alias(*instance)) return;
+
+    for (auto& [name, field] : (*instance)->m_fields) {
+      pin(field);
+    }
+  } else if (auto list = std::get_if<std::shared_ptr<SlangList>>(&value)) {
+    if (!alias(*list)) return;
+
+    for (auto& item : (*list)->m_items) {
+      pin(item);
+    }
+  } else if (auto map = std::get_if<std::shared_ptr<SlangMap>>(&value)) {
+    if (!alias(*map)) return;
+
+    // an alias points to the same object, the hashes stay valid
+    for (auto& entry : (*map)->m_entries) {
+      pin(entry.m_key);
+      pin(entry.m_value);
+    }
+  } else if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&value)) {
+    alias(*array);
+  }
+}
+
+void HeapPin::pin(std::shared_ptr<ICallable>& callable) {
+  if (alias(callable)) {
+    callable->pin(*this);
+  }
+}
+
+// ------------------------ | PRIVATE |
+template <typename T>
+bool HeapPin::alias(std::shared_ptr<T>& pointer) {
+  // every pointer to the object becomes an alias,
+  // the owner keeps the pointer it replaces
+  bool is_alias = !pointer.owner_before(m_owner) && !m_owner.owner_before(pointer);
+  if (!is_alias) {
+    m_owner->m_objects.push_back(pointer);
+  }
+
+  pointer = std::shared_ptr<T>(m_owner, pointer.get());
+  return m_seen.insert(pointer.get()).second;
+}
+
+} // namespace slang
@@ -0,0 +1,56 @@
+#ifndef __SLANG_HEAP_PIN_HPP__
+#define __SLANG_HEAP_PIN_HPP__
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "Object.hpp"
+
+namespace slang {
+
+class Environment;
+
+/// Takes the objects reachable from the globals off the reference
+/// counting path, for processes forked once the heap is set up.
+///
+/// A forked worker copies every page it writes to, and copying a shared
+/// pointer writes the count next to the object it points to. pin() makes
+/// every shared pointer reachable from the globals an alias of one owner,
+/// which keeps all of them alive, and the buffers of long strings
+/// immortal. Copying a pinned object then writes to the count of that
+/// owner only, wherever the copy is made. Pinned objects are never
+/// freed, even once unreachable.
+class HeapPin {
+public:
+  HeapPin();
+
+  HeapPin(HeapPin &&) = delete;
+  HeapPin(const HeapPin &) = delete;
+  HeapPin &operator=(HeapPin &&) = delete;
+  HeapPin &operator=(const HeapPin &) = delete;
+  ~HeapPin() = default;
+
+  /// Pins @env and everything reachable from it, starting with the globals.
+  void pin(Environment& env);
+  void pin(Object& value);
+  void pin(std::shared_ptr<ICallable>& callable);
+
+private:
+  // the pointers the objects had before, the aliases share their count
+  struct Owner {
+    std::vector<std::shared_ptr<void>> m_objects{};
+  };
+
+  std::shared_ptr<Owner> m_owner;
+  std::unordered_set<const void*> m_seen{};
+
+  /// Makes @pointer an alias of the owner, returns whether its object
+  /// was seen for the first time.
+  template <typename T>
+  bool alias(std::shared_ptr<T>& pointer);
+};
+
+} // namespace slang
+
+#endif // !__SLANG_HEAP_PIN_HPP__
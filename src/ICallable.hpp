@@ -6,6 +6,8 @@
 
 #include "Object.hpp"
 #include "Interpreter.hpp"
+#include "HeapPin.hpp"
+#include "Journal.hpp"
 
 
 namespace slang {
@@ -23,6 +25,13 @@ public:
 
   virtual size_t arity() = 0;
 
+  /// Adds what the callable keeps alive, like its closure,
+  /// to the snapshot of @journal.
+  virtual void track(Journal& journal) { (void)journal; }
+
+  /// Pins what the callable keeps alive, see HeapPin.
+  virtual void pin(HeapPin& pin) { (void)pin; }
+
   virtual std::string to_string() const {
     return "<fn @" + std::to_string(size_t(this)) + ">";
   }
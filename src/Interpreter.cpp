@@ -1,4 +1,3 @@
-#include <iostream>
 #include <unordered_map>
 
 #include "ICallable.hpp"
@@ -6,46 +5,132 @@
 #include "SlangInstance.hpp"
 #include "InterpreterExceptions.hpp"
 #include "Interpreter.hpp"
+#include "Number.hpp"
+#include "Runtime.hpp"
 #include "SlangFn.hpp"
+#include "SlangList.hpp"
+#include "native_fn/Add.hpp"
 #include "native_fn/Clock.hpp"
+#include "native_fn/Dot.hpp"
+#include "native_fn/Filter.hpp"
+#include "native_fn/Float64Array.hpp"
+#include "native_fn/Greater.hpp"
+#include "native_fn/Flush.hpp"
+#include "native_fn/Has.hpp"
+#include "native_fn/Int64Array.hpp"
+#include "native_fn/Keys.hpp"
+#include "native_fn/Len.hpp"
+#include "native_fn/Less.hpp"
+#include "native_fn/Max.hpp"
+#include "native_fn/Min.hpp"
+#include "native_fn/Mul.hpp"
+#include "native_fn/Pop.hpp"
+#include "native_fn/PrefixSum.hpp"
+#include "native_fn/Push.hpp"
+#include "native_fn/Remove.hpp"
+#include "native_fn/Scale.hpp"
+#include "native_fn/Sum.hpp"
+#include "native_fn/Values.hpp"
 
 
 namespace slang {
 
-// ------------------------ | HELPERS |
-static void check_number_operand(const Token& operator_,
-                                 const Object& operand) {
-  if (std::holds_alternative<double>(operand)) return;
+// ------------------------ | NUMBER EVALUATOR |
+/// Evaluates expressions the TypeInferrer proved to be numbers straight
+/// into unboxed Numbers, without building an Object for every
+/// intermediate result.
+class NumberEvaluator : public expr::ValueGetter<NumberEvaluator, expr::Expr, Number>,
+                        public expr::IVisitor {
+public:
+  explicit NumberEvaluator(Interpreter& interpreter)
+    : m_interpreter(interpreter) {}
+
+  NumberEvaluator(NumberEvaluator &&) = default;
+  NumberEvaluator(const NumberEvaluator &) = default;
+  NumberEvaluator &operator=(NumberEvaluator &&) = delete;
+  NumberEvaluator &operator=(const NumberEvaluator &) = delete;
+  ~NumberEvaluator() = default;
+
+  Number evaluate(expr::Expr& expr) {
+    return GetValue(expr);
+  }
 
-  throw RuntimeError(operator_, "Operand must be a number.");
-}
+  void visitBinaryExpr(expr::Binary &expr) override {
+    auto oper = expr.m_oper.m_type;
+    if (is_comparison(oper)
+        || !is_numeric_type(expr.m_left->m_static_type)
+        || !is_numeric_type(expr.m_right->m_static_type)) {
+      fallback(expr);
+      return;
+    }
 
-static void check_number_operands(const Token& operator_,
-                                 const Object& left,
-                                 const Object& right) {
-  if (std::holds_alternative<double>(left)
-      && std::holds_alternative<double>(right)) return;
+    Number left = evaluate(*expr.m_left);
+    Number right = evaluate(*expr.m_right);
+    Return(arithmetic(oper, left, right));
+  }
 
-  throw RuntimeError(operator_, "Operands must be numbers.");
-}
+  void visitUnaryExpr(expr::Unary &expr) override {
+    if (expr.m_oper.m_type == MINUS
+        && is_numeric_type(expr.m_right->m_static_type)) {
+      Return(negate(evaluate(*expr.m_right)));
+    } else {
+      fallback(expr);
+    }
+  }
+
+  void visitGroupingExpr(expr::Grouping &expr) override {
+    Return(evaluate(*expr.m_expression));
+  }
+
+  void visitLiteralExpr(expr::Literal &expr) override {
+    Return(Number::from_object(expr.m_value));
+  }
+
+  void visitAssignExpr(expr::Assign &expr) override { fallback(expr); }
+  void visitCallExpr(expr::Call &expr) override { fallback(expr); }
+  void visitGetExpr(expr::Get &expr) override { fallback(expr); }
+  void visitIndexExpr(expr::Index &expr) override { fallback(expr); }
+  void visitListExpr(expr::List &expr) override { fallback(expr); }
+  void visitLogicalExpr(expr::Logical &expr) override { fallback(expr); }
+  void visitMapExpr(expr::Map &expr) override { fallback(expr); }
+  void visitSetExpr(expr::Set &expr) override { fallback(expr); }
+  void visitSetIndexExpr(expr::SetIndex &expr) override { fallback(expr); }
+  void visitSliceExpr(expr::Slice &expr) override { fallback(expr); }
+  void visitVariableExpr(expr::Variable &expr) override { fallback(expr); }
+
+private:
+  Interpreter& m_interpreter;
+
+  void fallback(expr::Expr& expr) {
+    Return(Number::from_object(m_interpreter.evaluate(expr)));
+  }
+};
 
 // ------------------------ | PUBLIC |
-Interpreter::Interpreter(std::shared_ptr<ErrorReporter> reporter)
+Interpreter::Interpreter(std::shared_ptr<ErrorReporter> reporter,
+                         std::shared_ptr<Output> output,
+                         std::shared_ptr<Resolution> resolution)
   : m_reporter(reporter),
+    m_output(output),
     m_global(std::make_unique<Environment>(Environment{})),
-    m_env(m_global.get())
+    m_env(m_global.get()),
+    m_globals(m_global.get()),
+    m_resolution(resolution),
+    m_locals(resolution->m_locals),
+    m_tail_calls(resolution->m_tail_calls)
 {
-  m_global->define("clock", 
-                   std::make_shared<native_fn::Clock>(native_fn::Clock{}));
+  define_natives(*m_global);
 }
 
 
-void Interpreter::interpret(vector<shared_ptr<stmt::Stmt>>& statements) {
+void Interpreter::interpret(const vector<shared_ptr<stmt::Stmt>>& statements) {
   try {
     for (auto& s : statements) {
       execute(*s);
     }
   } catch (const RuntimeError& e) {
+    // what was printed before the error comes before its report
+    m_output->flush();
     m_reporter->runtime_error(e);
   }
 }
@@ -54,80 +139,57 @@ void Interpreter::resolve(expr::Expr& expr, int depth) {
   m_locals.insert({&expr, depth});
 }
 
-void Interpreter::visitUnaryExpr(expr::Unary &expr) {
-  Object right = evaluate(*expr.m_right);
+void Interpreter::mark_tail_call(stmt::Return& stmt) {
+  m_tail_calls.insert(&stmt);
+}
+
+int Interpreter::local_depth(expr::Expr& expr) const {
+  auto distance = m_locals.find(&expr);
+  return distance != m_locals.end() ? distance->second : -1;
+}
+
+bool Interpreter::is_tail_call(stmt::Return& stmt) const {
+  return m_tail_calls.count(&stmt) != 0;
+}
 
-  switch (expr.m_oper.m_type) {
-    case MINUS:
-      check_number_operand(expr.m_oper, right);
-      Return(-std::get<double>(right));   
-      break;
-    case BANG:
-      Return(!is_truthy(right));
-      break;
-    default:
-      Return(nullptr);
-      break;
+void Interpreter::print(const Object& value) {
+  m_output->print(value);
+}
+
+void Interpreter::visitUnaryExpr(expr::Unary &expr) {
+  if (expr.m_oper.m_type == MINUS
+      && is_numeric_type(expr.m_right->m_static_type)) {
+    Return(negate(NumberEvaluator(*this).evaluate(*expr.m_right)).to_object());
+    return;
   }
+
+  Object right = evaluate(*expr.m_right);
+  Return(runtime::unary(expr.m_oper, right));
 }
 
 
 void Interpreter::visitBinaryExpr(expr::Binary &expr) {
+  auto left_type = expr.m_left->m_static_type;
+  auto right_type = expr.m_right->m_static_type;
+
+  if (is_numeric_type(left_type) && is_numeric_type(right_type)) {
+    NumberEvaluator numbers(*this);
+    Number left = numbers.evaluate(*expr.m_left);
+    Number right = numbers.evaluate(*expr.m_right);
+    Return(number_operation(expr.m_oper.m_type, left, right));
+    return;
+  }
+
   Object left = evaluate(*expr.m_left);
   Object right = evaluate(*expr.m_right);
 
-  switch (expr.m_oper.m_type) {
-    case GREATER:
-      check_number_operands(expr.m_oper, left, right);
-      Return(std::get<double>(left) > std::get<double>(right));
-      break;
-    case GREATER_EQ:
-      check_number_operands(expr.m_oper, left, right);
-      Return(std::get<double>(left) >= std::get<double>(right));
-      break;
-    case LESS:
-      check_number_operands(expr.m_oper, left, right);
-      Return(std::get<double>(left) < std::get<double>(right));
-      break;
-    case LESS_EQ:
-      check_number_operands(expr.m_oper, left, right);
-      Return(std::get<double>(left) <= std::get<double>(right));
-      break;
-
-    case BANG_EQ:
-      Return(left != right);
-      break;
-    case EQ_EQ:
-      Return(left == right);
-      break;
-
-    case SLASH:
-      check_number_operands(expr.m_oper, left, right);
-      Return(std::get<double>(left) / std::get<double>(right));
-      break;
-    case STAR:
-      check_number_operands(expr.m_oper, left, right);
-      Return(std::get<double>(left) * std::get<double>(right));
-      break;
-    case MINUS:
-      check_number_operands(expr.m_oper, left, right);
-      Return(std::get<double>(left) - std::get<double>(right));
-      break;
-    case PLUS:
-      if (std::holds_alternative<double>(left) && std::holds_alternative<double>(right)) {
-        Return(std::get<double>(left) + std::get<double>(right));
-        break;
-      } else if (std::holds_alternative<std::string>(left) && std::holds_alternative<std::string>(right)) {
-        Return(std::get<std::string>(left) + std::get<std::string>(right));
-        break;
-      }
-      throw RuntimeError(expr.m_oper,
-                        "Operands must be two numbers or two strings.");
-
-    default:
-      Return(nullptr);
-      break;
+  if (expr.m_oper.m_type == PLUS
+      && left_type == TYPE_STRING && right_type == TYPE_STRING) {
+    Return(SlangString::concat(std::get<SlangString>(left), std::get<SlangString>(right)));
+    return;
   }
+
+  Return(runtime::binary(expr.m_oper, left, right));
 }
 
 void Interpreter::visitLiteralExpr(expr::Literal &expr) {
@@ -149,7 +211,7 @@ void Interpreter::visitAssignExpr(expr::Assign &expr) {
   if (distance != m_locals.end()) {
     m_env->assign_at(distance->second, expr.m_name, value);
   } else {
-    m_global->assign(expr.m_name, value);
+    m_globals->assign(expr.m_name, value);
   }
 
   m_env->assign(expr.m_name, value);
@@ -160,12 +222,12 @@ void Interpreter::visitLogicalExpr(expr::Logical &expr) {
   auto left = evaluate(*expr.m_left);
 
   if (expr.m_oper.m_type == OR) {
-    if (is_truthy(left)) {
+    if (runtime::is_truthy(left)) {
       Return(left);
       return;
     }
   } else {
-    if (!is_truthy(left)) {
+    if (!runtime::is_truthy(left)) {
       Return(left);
       return;
     }
@@ -176,52 +238,75 @@ void Interpreter::visitLogicalExpr(expr::Logical &expr) {
 
 void Interpreter::visitCallExpr(expr::Call &expr){
   auto callee = evaluate(*expr.m_callee);
+  ICallable *fn = runtime::as_callable(callee, expr.m_paren);
+  auto args = evaluate_args(*fn, expr);
 
-  ICallable *fn = nullptr;
-  if (auto *f = std::get_if<shared_ptr<ICallable>>(&callee)) {
-    fn = f->get();
-  } else if (ICallable **f = std::get_if<ICallable*>(&callee)) {
-    fn = *f;
-  }
+  Return(runtime::call(*fn, *this, args, expr.m_paren));
+} 
 
-  if (fn != nullptr) {
-    if (expr.m_args.size() != fn->arity()) {
-      throw RuntimeError(expr.m_paren, "Expected " + 
-                         std::to_string(fn->arity()) + " arguments, but got " + 
-                         std::to_string(expr.m_args.size()) + ".");
-    }
+void Interpreter::visitGetExpr(expr::Get &expr) {
+  auto obj = evaluate(*expr.m_object);
+  Return(runtime::get_property(obj, expr.m_name));
+}
 
-    vector<Object> args;
-    for (auto& arg : expr.m_args) {
-      args.push_back(evaluate(*arg));
-    }
+void Interpreter::visitSetExpr(expr::Set &expr) {
+  auto obj = evaluate(*expr.m_object);
 
-    Return(fn->call(*this, args));
-  } else {
-    throw RuntimeError(expr.m_paren, "Can only call functions.");
+  SlangInstance* instance = runtime::as_instance(obj, expr.m_name);
+  auto value = evaluate(*expr.m_value);
+  instance->set_property(expr.m_name, value);
+  Return(value);
+}
+
+void Interpreter::visitListExpr(expr::List &expr) {
+  vector<Object> items;
+  items.reserve(expr.m_elements.size());
+  for (auto& element : expr.m_elements) {
+    items.push_back(evaluate(*element));
   }
-} 
 
-void Interpreter::visitGetExpr(expr::Get &expr) {
-  auto obj = evaluate(*expr.m_object);
-  
-  if (auto pobj = std::get_if<shared_ptr<SlangInstance>>(&obj)) {
-    Return(pobj->get()->get_property(expr.m_name));
-  } else {
-    throw RuntimeError(expr.m_name, "Only instances have properties.");
+  Return(runtime::make_list(std::move(items)));
+}
+
+void Interpreter::visitMapExpr(expr::Map &expr) {
+  vector<Object> keys;
+  vector<Object> values;
+  keys.reserve(expr.m_keys.size());
+  values.reserve(expr.m_values.size());
+  for (std::size_t i = 0; i < expr.m_keys.size(); ++i) {
+    keys.push_back(evaluate(*expr.m_keys[i]));
+    values.push_back(evaluate(*expr.m_values[i]));
   }
+
+  Return(runtime::make_map(keys, values, expr.m_brace));
 }
 
-void Interpreter::visitSetExpr(expr::Set &expr) {
+void Interpreter::visitIndexExpr(expr::Index &expr) {
   auto obj = evaluate(*expr.m_object);
+  auto index = evaluate(*expr.m_index);
+  Return(runtime::get_index(obj, index, expr.m_bracket));
+}
 
-  if (auto pobj = std::get_if<shared_ptr<SlangInstance>>(&obj)) {
-    auto value = evaluate(*expr.m_value);
-    pobj->get()->set_property(expr.m_name, value);
-    Return(value);
-  } else {
-    throw RuntimeError(expr.m_name, "Only instances have fields.");
+void Interpreter::visitSetIndexExpr(expr::SetIndex &expr) {
+  auto obj = evaluate(*expr.m_object);
+  auto index = evaluate(*expr.m_index);
+  auto value = evaluate(*expr.m_value);
+  runtime::set_index(obj, index, value, expr.m_bracket);
+  Return(value);
+}
+
+void Interpreter::visitSliceExpr(expr::Slice &expr) {
+  auto obj = evaluate(*expr.m_object);
+  Object start = nullptr;
+  if (expr.m_start != nullptr) {
+    start = evaluate(*expr.m_start);
+  }
+  Object end = nullptr;
+  if (expr.m_end != nullptr) {
+    end = evaluate(*expr.m_end);
   }
+
+  Return(runtime::slice(obj, start, end, expr.m_bracket));
 }
 
 void Interpreter::visitExpressionStmt(stmt::Expression &stmt) {
@@ -229,8 +314,7 @@ void Interpreter::visitExpressionStmt(stmt::Expression &stmt) {
 }
 
 void Interpreter::visitPrintStmt(stmt::Print &stmt) {
-  auto value = evaluate(*stmt.m_expression);
-  std::cout << object_to_string(value) << std::endl;
+  print(evaluate(*stmt.m_expression));
 }
 
 void Interpreter::visitVarStmt(stmt::Var& stmt) {
@@ -249,7 +333,7 @@ void Interpreter::visitBlockStmt(stmt::Block &stmt) {
 }
 
 void Interpreter::visitIfStmt(stmt::If &stmt) {
-  if (is_truthy(evaluate(*stmt.m_condition))) {
+  if (runtime::is_truthy(evaluate(*stmt.m_condition))) {
     execute(*stmt.m_then_branch);
   } else if (stmt.m_else_branch != nullptr) {
     execute(*stmt.m_else_branch);
@@ -258,14 +342,14 @@ void Interpreter::visitIfStmt(stmt::If &stmt) {
 
 
 void Interpreter::visitWhileStmt(stmt::While &stmt) {
-  if (is_truthy(evaluate(*stmt.m_condition))) {
+  if (runtime::is_truthy(evaluate(*stmt.m_condition))) {
     do {
       try {
         execute(*stmt.m_then_branch);
       } catch (const BreakExc&) {
         break;
       }
-    } while (is_truthy(evaluate(*stmt.m_condition)));
+    } while (runtime::is_truthy(evaluate(*stmt.m_condition)));
   } else if (stmt.m_else_branch != nullptr) {
     execute(*stmt.m_else_branch);
   }
@@ -275,11 +359,81 @@ void Interpreter::visitWhileStmt(stmt::While &stmt) {
 void Interpreter::visitFnStmt(stmt::Fn &stmt) {
   // make copy of env and store it in closure
   auto closure = std::make_unique<Environment>(Environment(*m_env));
-  auto fn = std::make_shared<SlangFn>(SlangFn(stmt, std::move(closure))); 
+  auto fn = std::make_shared<SlangFn>(SlangFn(stmt, std::move(closure), m_globals));
   m_env->define(stmt.m_name.m_lexeme, fn);
 }
 
+void Interpreter::visitImportStmt(stmt::Import &stmt) {
+  auto found = m_resolution->m_imports.find(&stmt);
+  if (found == m_resolution->m_imports.end()) {
+    throw RuntimeError(stmt.m_path, "Module was not loaded.");
+  }
+
+  const ModuleCode* code = found->second.get();
+  ModuleState& module = m_modules[code];
+
+  if (module.m_running) {
+    throw RuntimeError(stmt.m_path, "Circular import of '" + code->m_path + "'.");
+  }
+
+  // the first import runs the module in globals of its own
+  if (module.m_globals == nullptr) {
+    module.m_globals = std::make_unique<Environment>();
+    define_natives(*module.m_globals);
+    module.m_globals->for_each([&module](const std::string& name, const Object& value) {
+      module.m_imported.insert({name, value});
+    });
+
+    class RunModule {
+    public:
+      RunModule(Interpreter& interpreter, ModuleState& module)
+        : m_interpreter(interpreter),
+          m_env(interpreter.m_env),
+          m_globals(interpreter.m_globals),
+          m_module(interpreter.m_module)
+      {
+        module.m_running = true;
+        interpreter.m_env = interpreter.m_globals = module.m_globals.get();
+        interpreter.m_module = &module;
+      }
+
+      ~RunModule() {
+        m_interpreter.m_module->m_running = false;
+        m_interpreter.m_env = m_env;
+        m_interpreter.m_globals = m_globals;
+        m_interpreter.m_module = m_module;
+      }
+
+    private:
+      Interpreter& m_interpreter;
+      Environment* m_env;
+      Environment* m_globals;
+      ModuleState* m_module;
+    };
+
+    RunModule run(*this, module);
+    for (auto& s : code->m_statements) {
+      execute(*s);
+    }
+  }
+
+  // imports only happen at the top level, m_env holds the importer's globals
+  module.m_globals->for_each([this, &module](const std::string& name, const Object& value) {
+    auto imported = module.m_imported.find(name);
+    if (imported != module.m_imported.end() && imported->second == value) return;
+
+    m_env->define(name, value);
+    if (m_module != nullptr) {
+      m_module->m_imported.insert_or_assign(name, value);
+    }
+  });
+}
+
 void Interpreter::visitReturnStmt(stmt::Return &stmt) {
+  if (m_tail_calls.count(&stmt) != 0) {
+    tail_call(*static_cast<expr::Call*>(stmt.m_value.get()));
+  }
+
   Object ret = nullptr;
   if (stmt.m_value != nullptr) {
     ret = evaluate(*stmt.m_value);
@@ -296,10 +450,10 @@ void Interpreter::visitBreakStmt(stmt::Break &) {
 void Interpreter::visitClassStmt(stmt::Class &stmt) {
   m_env->define(stmt.m_name.m_lexeme, nullptr);
 
-  std::unordered_map<string, shared_ptr<SlangFn>> methods;
+  std::unordered_map<string, shared_ptr<ICallable>> methods;
   for (auto& method : stmt.m_methods) {
     auto closure = std::make_unique<Environment>(Environment(*m_env));
-    auto fn = make_shared<SlangFn>(SlangFn(*method, std::move(closure)));
+    auto fn = make_shared<SlangFn>(SlangFn(*method, std::move(closure), m_globals));
     methods.insert({method->m_name.m_lexeme, fn});
   }
 
@@ -312,17 +466,51 @@ Object Interpreter::evaluate(expr::Expr& expr) {
   return GetValue(expr);
 }
 
-bool Interpreter::is_truthy(const Object& obj) {
-  if (std::holds_alternative<std::nullptr_t>(obj)
-      || (std::holds_alternative<double>(obj) && std::get<double>(obj) == 0)) {
-    return false;
-  }
-
-  if (std::holds_alternative<bool>(obj)) {
-    return std::get<bool>(obj);
-  }
-
-  return true;
+void Interpreter::define_natives(Environment& globals) {
+  globals.define("add",
+                 std::make_shared<native_fn::Add>(native_fn::Add{}));
+  globals.define("clock",
+                 std::make_shared<native_fn::Clock>(native_fn::Clock{}));
+  globals.define("dot",
+                 std::make_shared<native_fn::Dot>(native_fn::Dot{}));
+  globals.define("filter",
+                 std::make_shared<native_fn::Filter>(native_fn::Filter{}));
+  globals.define("float64_array",
+                 std::make_shared<native_fn::Float64Array>(native_fn::Float64Array{}));
+  globals.define("flush",
+                 std::make_shared<native_fn::Flush>(native_fn::Flush{}));
+  globals.define("greater",
+                 std::make_shared<native_fn::Greater>(native_fn::Greater{}));
+  globals.define("has",
+                 std::make_shared<native_fn::Has>(native_fn::Has{}));
+  globals.define("int64_array",
+                 std::make_shared<native_fn::Int64Array>(native_fn::Int64Array{}));
+  globals.define("keys",
+                 std::make_shared<native_fn::Keys>(native_fn::Keys{}));
+  globals.define("len",
+                 std::make_shared<native_fn::Len>(native_fn::Len{}));
+  globals.define("less",
+                 std::make_shared<native_fn::Less>(native_fn::Less{}));
+  globals.define("max",
+                 std::make_shared<native_fn::Max>(native_fn::Max{}));
+  globals.define("min",
+                 std::make_shared<native_fn::Min>(native_fn::Min{}));
+  globals.define("mul",
+                 std::make_shared<native_fn::Mul>(native_fn::Mul{}));
+  globals.define("pop",
+                 std::make_shared<native_fn::Pop>(native_fn::Pop{}));
+  globals.define("prefix_sum",
+                 std::make_shared<native_fn::PrefixSum>(native_fn::PrefixSum{}));
+  globals.define("push",
+                 std::make_shared<native_fn::Push>(native_fn::Push{}));
+  globals.define("remove",
+                 std::make_shared<native_fn::Remove>(native_fn::Remove{}));
+  globals.define("scale",
+                 std::make_shared<native_fn::Scale>(native_fn::Scale{}));
+  globals.define("sum",
+                 std::make_shared<native_fn::Sum>(native_fn::Sum{}));
+  globals.define("values",
+                 std::make_shared<native_fn::Values>(native_fn::Values{}));
 }
 
 void Interpreter::execute(stmt::Stmt& statement) {
@@ -365,9 +553,34 @@ Object Interpreter::lookup_variable(const Token& name, expr::Expr& expr) {
   if (distance != m_locals.end()) {
     return m_env->get_variable_at(distance->second, name.m_lexeme);
   } else {
-    return m_global->get_variable(name);
+    return m_globals->get_variable(name);
+  }
+}
+
+vector<Object> Interpreter::evaluate_args(ICallable& fn, expr::Call& expr) {
+  runtime::check_arity(fn, expr.m_args.size(), expr.m_paren);
+
+  vector<Object> args;
+  args.reserve(expr.m_args.size());
+  for (auto& arg : expr.m_args) {
+    args.push_back(evaluate(*arg));
   }
+
+  return args;
 }
 
+void Interpreter::tail_call(expr::Call& expr) {
+  auto callee = evaluate(*expr.m_callee);
+  ICallable *fn = runtime::as_callable(callee, expr.m_paren);
+  auto args = evaluate_args(*fn, expr);
+
+  // only slang functions can reuse the caller's frame,
+  // natives and classes are called in place
+  if (auto slang_fn = dynamic_cast<SlangFn*>(fn)) {
+    throw TailCallExc(callee, slang_fn, std::move(args));
+  }
+
+  throw ReturnExc(runtime::call(*fn, *this, args, expr.m_paren));
+}
 
 } // namespace slang
@@ -2,12 +2,15 @@
 #define __SLANG_INTERPRETER_HPP__
 
 #include <stdexcept>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "Environment.hpp"
 #include "Expr.hpp"
 #include "Stmt.hpp"
 #include "ErrorReporter.hpp"
+#include "Output.hpp"
 
 namespace slang {
 
@@ -16,11 +19,33 @@ using std::unordered_map;
 using std::shared_ptr;
 using std::unique_ptr;
 
+class NumberEvaluator;
+
+/// Compiled code of a module, run by the first `import` of it.
+struct ModuleCode {
+  std::string m_path;
+  vector<shared_ptr<stmt::Stmt>> m_statements;
+};
+
+/// What the Resolver found out about the code an Interpreter runs.
+/// Only read once the code is resolved, so interpreters running the same
+/// code on different threads share it.
+struct Resolution {
+  unordered_map<expr::Expr*, int> m_locals{};
+  std::unordered_set<stmt::Return*> m_tail_calls{};
+  // the module of every import, registered by the ModuleLoader
+  unordered_map<stmt::Import*, shared_ptr<const ModuleCode>> m_imports{};
+};
+
 class Interpreter : public expr::ValueGetter<Interpreter, expr::Expr, Object>,
                     public expr::IVisitor,
                     public stmt::IVisitor {
 public:
-  Interpreter(std::shared_ptr<ErrorReporter> reporter);
+  /// Prints to @output, the process wide Output by default.
+  /// Runs code resolved into @resolution, or resolved by this interpreter.
+  Interpreter(std::shared_ptr<ErrorReporter> reporter,
+              std::shared_ptr<Output> output = Output::standard(),
+              std::shared_ptr<Resolution> resolution = std::make_shared<Resolution>());
   Interpreter(Interpreter &&) = default;
   Interpreter(const Interpreter &) = delete;
   Interpreter &operator=(Interpreter &&) = delete;
@@ -37,6 +62,11 @@ public:
   void visitCallExpr(expr::Call &expr) override;
   void visitGetExpr(expr::Get &expr) override;
   void visitSetExpr(expr::Set &expr) override;
+  void visitMapExpr(expr::Map &expr) override;
+  void visitListExpr(expr::List &expr) override;
+  void visitIndexExpr(expr::Index &expr) override;
+  void visitSetIndexExpr(expr::SetIndex &expr) override;
+  void visitSliceExpr(expr::Slice &expr) override;
 
   void visitExpressionStmt(stmt::Expression &stmt) override;
   void visitPrintStmt(stmt::Print &stmt) override;
@@ -47,32 +77,77 @@ public:
   void visitIfStmt(stmt::If &stmt) override;
   void visitWhileStmt(stmt::While &stmt) override;
   void visitFnStmt(stmt::Fn &stmt) override;
+  void visitImportStmt(stmt::Import &stmt) override;
   void visitReturnStmt(stmt::Return &stmt) override;
 
-  void interpret(vector<shared_ptr<stmt::Stmt>>& statements);
+  void interpret(const vector<shared_ptr<stmt::Stmt>>& statements);
   Environment* get_global_environment() { return m_global.get(); }
+  const Environment* get_global_environment() const { return m_global.get(); }
+
+  /// Makes @globals, those of the module a function was defined in, the
+  /// ones global variables are looked up in. Returns the previous ones.
+  Environment* switch_globals(Environment* globals) {
+    Environment* previous = m_globals;
+    m_globals = globals;
+    return previous;
+  }
+
+  /// Globals of the module running now, the program's own outside modules.
+  Environment* current_globals() const { return m_globals; }
 
   void executeBlock(vector<shared_ptr<stmt::Stmt>>& statements,
                     Environment *env);
 
   void resolve(expr::Expr& expr, int depth);
+  void mark_tail_call(stmt::Return& stmt);
+
+  /// Number of scopes between the use of a local variable and its
+  /// declaration, -1 for globals.
+  int local_depth(expr::Expr& expr) const;
+  bool is_tail_call(stmt::Return& stmt) const;
+
+  void print(const Object& value);
+  Output& output() { return *m_output; }
+  shared_ptr<Resolution> resolution() const { return m_resolution; }
 
 private:
+  friend class NumberEvaluator;
+
+  /// A module of this interpreter that an import started to run.
+  struct ModuleState {
+    unique_ptr<Environment> m_globals{};
+    // what the natives and its own imports defined, a name still bound
+    // to that value is not passed on, one the module redefined is
+    unordered_map<std::string, Object> m_imported{};
+    bool m_running{false};
+  };
+
   shared_ptr<ErrorReporter> m_reporter;
+  shared_ptr<Output> m_output;
 
   unique_ptr<Environment> m_global;
   Environment* m_env;
+  Environment* m_globals;
 
-  unordered_map<expr::Expr*, int> m_locals{};
+  unordered_map<const ModuleCode*, ModuleState> m_modules{};
+  ModuleState* m_module{nullptr};
+
+  shared_ptr<Resolution> m_resolution;
+  unordered_map<expr::Expr*, int>& m_locals;
+  std::unordered_set<stmt::Return*>& m_tail_calls;
 
 
   Object evaluate(expr::Expr& expr);
-  bool is_truthy(const Object& obj);
+
+  void define_natives(Environment& globals);
   
   void execute(stmt::Stmt& statement);
 
   Object lookup_variable(const Token& name, expr::Expr& expr);
 
+  vector<Object> evaluate_args(ICallable& fn, expr::Call& expr);
+  void tail_call(expr::Call& expr);
+
 };
 
 } // namespace slang
@@ -2,11 +2,14 @@
 #define __SLANG_INTERPRETER_EXCEPTIONS_HPP__
 
 #include <stdexcept>
+#include <vector>
 
 #include "Token.hpp"
 
 namespace slang {
 
+class SlangFn;
+
 class RuntimeError : public std::runtime_error {
 public:
   RuntimeError(const Token& token, const std::string& msg) :
@@ -23,6 +26,19 @@ public:
 
 };
 
+/// Thrown by native functions, which do not know the call they run for.
+/// runtime::call reports it as a RuntimeError at the call.
+class NativeError : public std::runtime_error {
+public:
+  explicit NativeError(const std::string& msg) : std::runtime_error(msg) {}
+
+  NativeError(NativeError &&) = default;
+  NativeError(const NativeError &) = default;
+  NativeError &operator=(NativeError &&) = default;
+  NativeError &operator=(const NativeError &) = default;
+  ~NativeError() = default;
+};
+
 class ReturnExc : public std::runtime_error {
 public:
   ReturnExc(const Object& value) 
@@ -49,6 +65,23 @@ public:
   ~BreakExc() = default;
 };
 
+/// Thrown by a `return f(...)` in tail position, unwinds to the enclosing
+/// SlangFn::call which then reuses its frame for the callee.
+class TailCallExc : public std::runtime_error {
+public:
+  TailCallExc(const Object& callee, SlangFn* fn, std::vector<Object>&& args)
+    : std::runtime_error(""), m_callee(callee), m_fn(fn), m_args(std::move(args)) {}
+
+  TailCallExc(TailCallExc &&) = default;
+  TailCallExc(const TailCallExc &) = default;
+  TailCallExc &operator=(TailCallExc &&) = default;
+  TailCallExc &operator=(const TailCallExc &) = default;
+  ~TailCallExc() = default;
+
+  Object m_callee; // keeps m_fn alive until the frame is reused
+  SlangFn* m_fn;
+  std::vector<Object> m_args;
+};
 
 } // namespace slang
 
@@ -0,0 +1,158 @@
+#include "Environment.hpp"
+#include "ICallable.hpp"
+#include "Journal.hpp"
+#include "SlangArray.hpp"
+#include "SlangInstance.hpp"
+#include "SlangList.hpp"
+#include "SlangMap.hpp"
+
+namespace slang {
+
+// ------------------------ | PUBLIC |
+Journal::Journal() = default;
+
+Journal::~Journal() {
+  for (Environment* env : m_envs) {
+    env->m_link.m_journal = nullptr;
+  }
+
+  for (SlangInstance* instance : m_instances) {
+    instance->m_link.m_journal = nullptr;
+  }
+
+  for (SlangList* list : m_lists) {
+    list->m_link.m_journal = nullptr;
+  }
+
+  for (SlangMap* map : m_maps) {
+    map->m_link.m_journal = nullptr;
+  }
+
+  for (SlangArray* array : m_arrays) {
+    array->m_link.m_journal = nullptr;
+  }
+}
+
+void Journal::track(Environment& env) {
+  for (Environment* current = &env; current != nullptr; current = current->m_enclosing) {
+    if (!m_seen.insert(current).second) return;
+
+    current->m_link.m_journal = this;
+    m_envs.push_back(current);
+
+    for (const auto& [name, value] : current->variables) {
+      track(value);
+    }
+  }
+}
+
+void Journal::track(const Object& value) {
+  if (auto callable = std::get_if<std::shared_ptr<ICallable>>(&value)) {
+    if (!m_seen.insert(callable->get()).second) return;
+
+    m_roots.push_back(value);
+    (*callable)->track(*this);
+  } else if (auto callable = std::get_if<ICallable*>(&value)) {
+    // a function referring to itself, owned by a shared pointer elsewhere
+    if (!m_seen.insert(*callable).second) return;
+
+    (*callable)->track(*this);
+  } else if (auto instance = std::get_if<std::shared_ptr<SlangInstance>>(&value)) {
+    if (!m_seen.insert(instance->get()).second) return;
+
+    m_roots.push_back(value);
+    (*instance)->m_link.m_journal = this;
+    m_instances.push_back(instance->get());
+
+    for (const auto& [name, field] : (*instance)->m_fields) {
+      track(field);
+    }
+  } else if (auto list = std::get_if<std::shared_ptr<SlangList>>(&value)) {
+    if (!m_seen.insert(list->get()).second) return;
+
+    m_roots.push_back(value);
+    (*list)->m_link.m_journal = this;
+    m_lists.push_back(list->get());
+
+    for (const auto& item : (*list)->m_items) {
+      track(item);
+    }
+  } else if (auto map = std::get_if<std::shared_ptr<SlangMap>>(&value)) {
+    if (!m_seen.insert(map->get()).second) return;
+
+    m_roots.push_back(value);
+    (*map)->m_link.m_journal = this;
+    m_maps.push_back(map->get());
+
+    for (const auto& entry : (*map)->m_entries) {
+      track(entry.m_key);
+      track(entry.m_value);
+    }
+  } else if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&value)) {
+    if (!m_seen.insert(array->get()).second) return;
+
+    m_roots.push_back(value);
+    (*array)->m_link.m_journal = this;
+    m_arrays.push_back(array->get());
+  }
+}
+
+void Journal::save(Environment& env) {
+  m_dirty_envs.emplace_back(&env, std::make_unique<Environment>(env));
+  env.m_link.m_journal = nullptr;
+}
+
+void Journal::save(SlangInstance& instance) {
+  m_dirty_instances.emplace_back(&instance, instance.m_fields);
+  instance.m_link.m_journal = nullptr;
+}
+
+void Journal::save(SlangList& list) {
+  m_dirty_lists.emplace_back(&list, list.m_items);
+  list.m_link.m_journal = nullptr;
+}
+
+void Journal::save(SlangMap& map) {
+  m_dirty_maps.emplace_back(&map, std::make_unique<SlangMap>(map));
+  map.m_link.m_journal = nullptr;
+}
+
+void Journal::save(SlangArray& array) {
+  m_dirty_arrays.emplace_back(&array, std::make_unique<SlangArray>(array));
+  array.m_link.m_journal = nullptr;
+}
+
+void Journal::restore() {
+  for (auto& [env, saved] : m_dirty_envs) {
+    *env = std::move(*saved);
+    env->m_link.m_journal = this;
+  }
+
+  for (auto& [instance, fields] : m_dirty_instances) {
+    instance->m_fields = std::move(fields);
+    instance->m_link.m_journal = this;
+  }
+
+  for (auto& [list, items] : m_dirty_lists) {
+    list->m_items = std::move(items);
+    list->m_link.m_journal = this;
+  }
+
+  for (auto& [map, saved] : m_dirty_maps) {
+    *map = std::move(*saved);
+    map->m_link.m_journal = this;
+  }
+
+  for (auto& [array, saved] : m_dirty_arrays) {
+    *array = std::move(*saved);
+    array->m_link.m_journal = this;
+  }
+
+  m_dirty_envs.clear();
+  m_dirty_instances.clear();
+  m_dirty_lists.clear();
+  m_dirty_maps.clear();
+  m_dirty_arrays.clear();
+}
+
+} // namespace slang
@@ -0,0 +1,95 @@
+#ifndef __SLANG_JOURNAL_HPP__
+#define __SLANG_JOURNAL_HPP__
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Object.hpp"
+
+namespace slang {
+
+class Environment;
+class Journal;
+class SlangList;
+class SlangMap;
+class SlangArray;
+
+/// Journal a heap object belongs to. A copy of the object starts out
+/// untracked, since it is not part of the snapshot.
+struct JournalLink {
+  JournalLink() = default;
+  JournalLink(const JournalLink &) {}
+  JournalLink &operator=(const JournalLink &) { return *this; }
+  ~JournalLink() = default;
+
+  Journal* m_journal{nullptr};
+};
+
+/// Undo log that takes a heap back to a snapshot.
+///
+/// track() marks every environment, instance, list, map and array reachable from the
+/// globals as belonging to the journal. The first write to such an object
+/// saves its variables here, so restore() puts back only the objects
+/// written since the snapshot. Objects created later are never saved,
+/// they become unreachable once their referrers are restored.
+class Journal {
+public:
+  // out of line, the saved maps and arrays are incomplete here
+  Journal();
+
+  // tracked objects refer to the journal
+  Journal(Journal &&) = delete;
+  Journal(const Journal &) = delete;
+  Journal &operator=(Journal &&) = delete;
+  Journal &operator=(const Journal &) = delete;
+  ~Journal();
+
+  /// Adds @env and everything reachable from it to the snapshot,
+  /// starting with the globals.
+  void track(Environment& env);
+  void track(const Object& value);
+
+  /// Called on the first write to a tracked object since the snapshot
+  /// or since the last restore().
+  void save(Environment& env);
+  void save(SlangInstance& instance);
+  void save(SlangList& list);
+  void save(SlangMap& map);
+  void save(SlangArray& array);
+
+  /// Restores every object written since the snapshot.
+  void restore();
+
+  /// Number of objects written since the snapshot.
+  std::size_t dirty() const {
+    return m_dirty_envs.size() + m_dirty_instances.size() + m_dirty_lists.size()
+           + m_dirty_maps.size() + m_dirty_arrays.size();
+  }
+
+private:
+  using Fields = std::unordered_map<std::string, Object>;
+
+  // keep the tracked objects, and the environments they own, alive
+  std::vector<Object> m_roots{};
+  std::unordered_set<const void*> m_seen{};
+  std::vector<Environment*> m_envs{};
+  std::vector<SlangInstance*> m_instances{};
+  std::vector<SlangList*> m_lists{};
+  std::vector<SlangMap*> m_maps{};
+  std::vector<SlangArray*> m_arrays{};
+
+  // contents of the written objects at the time of the snapshot
+  std::vector<std::pair<Environment*, std::unique_ptr<Environment>>> m_dirty_envs{};
+  std::vector<std::pair<SlangInstance*, Fields>> m_dirty_instances{};
+  std::vector<std::pair<SlangList*, std::vector<Object>>> m_dirty_lists{};
+  std::vector<std::pair<SlangMap*, std::unique_ptr<SlangMap>>> m_dirty_maps{};
+  std::vector<std::pair<SlangArray*, std::unique_ptr<SlangArray>>> m_dirty_arrays{};
+};
+
+} // namespace slang
+
+#endif // !__SLANG_JOURNAL_HPP__
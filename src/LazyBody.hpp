@@ -0,0 +1,30 @@
+#ifndef __SLANG_LAZY_BODY_HPP__
+#define __SLANG_LAZY_BODY_HPP__
+
+namespace slang {
+
+class Interpreter;
+
+namespace stmt {
+class Fn;
+} // namespace stmt
+
+/// Body of a function that has not been parsed yet, see the Parser's
+/// pre-parse mode. SlangFn compiles it on the first call.
+class LazyBody {
+public:
+  LazyBody() = default;
+  LazyBody(LazyBody &&) = default;
+  LazyBody(const LazyBody &) = default;
+  LazyBody &operator=(LazyBody &&) = default;
+  LazyBody &operator=(const LazyBody &) = default;
+  virtual ~LazyBody() = default;
+
+  /// Parses and resolves the body of @fn for @interpreter.
+  /// Throws RuntimeError if the body does not compile.
+  virtual void compile(stmt::Fn& fn, Interpreter& interpreter) = 0;
+};
+
+} // namespace slang
+
+#endif // !__SLANG_LAZY_BODY_HPP__
@@ -0,0 +1,65 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.hpp"
+
+namespace slang {
+
+MappedFile::MappedFile(MappedFile &&other)
+  : m_data(other.m_data),
+    m_size(other.m_size),
+    m_mapped(other.m_mapped)
+{
+  other.m_data = nullptr;
+  other.m_size = 0;
+  other.m_mapped = false;
+}
+
+MappedFile::~MappedFile() {
+  if (m_mapped) {
+    munmap(const_cast<char*>(m_data), m_size);
+  }
+}
+
+bool MappedFile::open(const char* path) {
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    return false;
+  }
+
+  m_size = static_cast<std::size_t>(st.st_size);
+  if (m_size == 0) {
+    // mmap rejects empty mappings
+    close(fd);
+    m_data = "";
+    return true;
+  }
+
+  void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if (data == MAP_FAILED) {
+    m_size = 0;
+    return false;
+  }
+
+  m_data = static_cast<const char*>(data);
+  m_mapped = true;
+  return true;
+}
+
+void MappedFile::advise_sequential() const {
+  if (m_mapped) {
+    madvise(const_cast<char*>(m_data), m_size, MADV_SEQUENTIAL);
+  }
+}
+
+} // namespace slang
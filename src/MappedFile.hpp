@@ -0,0 +1,35 @@
+#ifndef __SLANG_MAPPED_FILE_HPP__
+#define __SLANG_MAPPED_FILE_HPP__
+
+#include <cstddef>
+
+namespace slang {
+
+/// Read-only memory mapping of a whole file, unmapped on destruction.
+class MappedFile {
+public:
+  MappedFile() = default;
+  MappedFile(MappedFile &&other);
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(MappedFile &&) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  ~MappedFile();
+
+  /// Maps the file at @path, returns false if it can not be mapped.
+  bool open(const char* path);
+
+  /// Hints that the file is read once from start to end.
+  void advise_sequential() const;
+
+  const char* data() const { return m_data; }
+  std::size_t size() const { return m_size; }
+
+private:
+  const char* m_data{nullptr};
+  std::size_t m_size{0};
+  bool m_mapped{false};
+};
+
+} // namespace slang
+
+#endif // !__SLANG_MAPPED_FILE_HPP__
@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+#include "ModuleLoader.hpp"
+#include "Parser.hpp"
+#include "Resolver.hpp"
+#include "Scanner.hpp"
+#include "ScriptCache.hpp"
+#include "SourceFile.hpp"
+#include "TypeInferrer.hpp"
+
+namespace slang {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+static constexpr const char* MODULE_EXTENSION = ".slang";
+
+static string directory_of(const string& path) {
+  std::size_t slash = path.rfind('/');
+  if (slash == string::npos) return ".";
+  if (slash == 0) return "/";
+  return path.substr(0, slash);
+}
+
+static string canonical(const string& path) {
+  char resolved[PATH_MAX];
+  if (realpath(path.c_str(), resolved) == nullptr) return {};
+  return resolved;
+}
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+ModuleLoader::ModuleLoader(shared_ptr<ErrorReporter> reporter)
+  : m_reporter(reporter)
+{}
+
+bool ModuleLoader::load(const string& importer,
+                        const vector<shared_ptr<stmt::Stmt>>& statements,
+                        Resolution& resolution) {
+  vector<Pending> pending;
+  if (!find_imports(importer, statements, pending)) return false;
+
+  // one level of the import graph at a time, the modules of a level
+  // are only known once the level before it is compiled
+  while (!pending.empty()) {
+    vector<string> paths;
+    for (auto& import : pending) {
+      if (m_modules.count(import.m_path) == 0
+          && std::find(paths.begin(), paths.end(), import.m_path) == paths.end()) {
+        paths.push_back(import.m_path);
+      }
+    }
+
+    vector<Compiled> compiled(paths.size());
+    std::size_t thread_count = std::min<std::size_t>(
+        std::max(std::thread::hardware_concurrency(), 1u), paths.size());
+
+    if (thread_count <= 1) {
+      for (std::size_t i = 0; i < paths.size(); ++i) {
+        compile(paths[i], compiled[i]);
+      }
+    } else {
+      std::atomic<std::size_t> next{0};
+      vector<std::thread> threads;
+      threads.reserve(thread_count);
+      for (std::size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&]() {
+          for (std::size_t i = next++; i < paths.size(); i = next++) {
+            compile(paths[i], compiled[i]);
+          }
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+
+    bool ok = true;
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+      if (!compiled[i].m_errors.empty()) {
+        m_reporter->relay("In module '" + paths[i] + "':\n" + compiled[i].m_errors);
+        ok = false;
+        continue;
+      }
+
+      Resolution& module = *compiled[i].m_resolution;
+      resolution.m_locals.insert(module.m_locals.begin(), module.m_locals.end());
+      resolution.m_tail_calls.insert(module.m_tail_calls.begin(), module.m_tail_calls.end());
+      m_modules.emplace(paths[i], compiled[i].m_code);
+    }
+    if (!ok) return false;
+
+    for (auto& import : pending) {
+      resolution.m_imports[import.m_import] = m_modules.at(import.m_path);
+    }
+
+    pending.clear();
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+      if (!find_imports(paths[i], compiled[i].m_code->m_statements, pending)) return false;
+    }
+  }
+
+  return true;
+}
+
+// ------------------------ | PRIVATE |
+bool ModuleLoader::find_imports(const string& importer,
+                                const vector<shared_ptr<stmt::Stmt>>& statements,
+                                vector<Pending>& pending) {
+  bool found_all = true;
+
+  // the Resolver keeps imports at the top level
+  for (auto& statement : statements) {
+    auto import = dynamic_cast<stmt::Import*>(statement.get());
+    if (import == nullptr) continue;
+
+    string path = find_module(importer, std::get<SlangString>(import->m_path.m_literal).str());
+    if (path.empty()) {
+      m_reporter->error(import->m_path, "Cannot find module.");
+      found_all = false;
+      continue;
+    }
+
+    pending.push_back(Pending{import, std::move(path)});
+  }
+
+  return found_all;
+}
+
+string ModuleLoader::find_module(const string& importer, const string& name) {
+  string file = name;
+  std::size_t extension_size = std::char_traits<char>::length(helpers::MODULE_EXTENSION);
+  if (file.size() < extension_size
+      || file.compare(file.size() - extension_size, extension_size, helpers::MODULE_EXTENSION) != 0) {
+    file += helpers::MODULE_EXTENSION;
+  }
+
+  if (!file.empty() && file.front() == '/') {
+    return helpers::canonical(file);
+  }
+
+  string path = helpers::canonical(
+      (importer.empty() ? string(".") : helpers::directory_of(importer)) + "/" + file);
+  if (!path.empty()) return path;
+
+  const char* search_path = std::getenv("SLANG_PATH");
+  if (search_path == nullptr) return {};
+
+  std::istringstream dirs(search_path);
+  string dir;
+  while (std::getline(dirs, dir, ':')) {
+    if (dir.empty()) continue;
+
+    path = helpers::canonical(dir + "/" + file);
+    if (!path.empty()) return path;
+  }
+
+  return {};
+}
+
+void ModuleLoader::compile(const string& path, Compiled& module) {
+  std::ostringstream reports;
+  auto reporter = std::make_shared<ErrorReporter>(reports);
+
+  module.m_code = std::make_shared<ModuleCode>();
+  module.m_code->m_path = path;
+
+  SourceFile file;
+  if (!file.open(path.c_str())) {
+    module.m_errors = "Could not open '" + path + "'.\n";
+    return;
+  }
+
+  // only resolves into the module, never runs anything
+  ScriptCache cache(path, file);
+  Interpreter interpreter(reporter, nullptr, module.m_resolution);
+  auto& statements = module.m_code->m_statements;
+
+  if (cache.load(interpreter, statements)) return;
+
+  if (file.is_mapped()) {
+    Scanner scanner(file.text(), reporter);
+    Parser parser(scanner, reporter);
+    statements = parser.parse();
+  } else {
+    Scanner scanner(file.stream(), reporter);
+    Parser parser(scanner, reporter);
+    statements = parser.parse();
+  }
+
+  if (!reporter->has_error()) {
+    Resolver resolver(interpreter, reporter);
+    resolver.resolve(statements);
+  }
+
+  if (reporter->has_error()) {
+    module.m_errors = reports.str();
+    return;
+  }
+
+  TypeInferrer inferrer;
+  inferrer.infer(statements);
+  cache.store(interpreter, statements);
+}
+
+} // namespace slang
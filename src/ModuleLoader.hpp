@@ -0,0 +1,78 @@
+#ifndef __SLANG_MODULE_LOADER_HPP__
+#define __SLANG_MODULE_LOADER_HPP__
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ErrorReporter.hpp"
+#include "Interpreter.hpp"
+#include "Stmt.hpp"
+
+namespace slang {
+
+using std::vector;
+using std::shared_ptr;
+using std::string;
+
+/// Finds, compiles and registers every module a program imports, before
+/// the program runs.
+///
+/// `import "util";` is looked up as `util.slang` next to the importing
+/// file first, then in every directory of SLANG_PATH, a colon separated
+/// list like PATH. Each module goes through the ScriptCache on its own,
+/// so only the modules that changed since the last run are recompiled.
+/// The modules imported by the same level of the import graph are
+/// compiled in parallel, one thread per module up to the number of cores.
+class ModuleLoader {
+public:
+  explicit ModuleLoader(shared_ptr<ErrorReporter> reporter);
+
+  ModuleLoader(ModuleLoader &&) = delete;
+  ModuleLoader(const ModuleLoader &) = delete;
+  ModuleLoader &operator=(ModuleLoader &&) = delete;
+  ModuleLoader &operator=(const ModuleLoader &) = delete;
+  ~ModuleLoader() = default;
+
+  /// Loads everything @statements import, directly or through other
+  /// modules, into @resolution. @importer is the path of the file the
+  /// statements come from, empty for code that has no file.
+  /// Reports the errors and returns false if a module fails to load.
+  bool load(const string& importer, const vector<shared_ptr<stmt::Stmt>>& statements,
+            Resolution& resolution);
+
+private:
+  /// Import waiting for its module.
+  struct Pending {
+    stmt::Import* m_import;
+    string m_path;
+  };
+
+  /// A module compiled by one of the threads.
+  struct Compiled {
+    shared_ptr<ModuleCode> m_code{};
+    shared_ptr<Resolution> m_resolution{std::make_shared<Resolution>()};
+    string m_errors{};
+  };
+
+  shared_ptr<ErrorReporter> m_reporter;
+
+  // every module loaded so far, by canonical path
+  std::unordered_map<string, shared_ptr<const ModuleCode>> m_modules{};
+
+  /// Adds the imports among @statements to @pending, returns false if
+  /// the module of one of them can not be found.
+  bool find_imports(const string& importer, const vector<shared_ptr<stmt::Stmt>>& statements,
+                    vector<Pending>& pending);
+
+  /// Canonical path of the module @name imported by @importer, empty
+  /// if there is none.
+  static string find_module(const string& importer, const string& name);
+
+  static void compile(const string& path, Compiled& module);
+};
+
+} // namespace slang
+
+#endif // !__SLANG_MODULE_LOADER_HPP__
@@ -0,0 +1,182 @@
+#ifndef __SLANG_NUMBER_HPP__
+#define __SLANG_NUMBER_HPP__
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+
+#include "Object.hpp"
+#include "Token.hpp"
+
+namespace slang {
+
+inline bool is_number(const Object& obj) {
+  return std::holds_alternative<std::int64_t>(obj)
+         || std::holds_alternative<double>(obj);
+}
+
+/// Unboxed number, integers stay integers until an operation overflows
+/// or mixes them with a double.
+struct Number {
+  std::int64_t m_int;
+  double m_double;
+  bool m_is_int;
+
+  static Number from_int(std::int64_t value) { return Number{value, 0, true}; }
+  static Number from_double(double value) { return Number{0, value, false}; }
+
+  static Number from_object(const Object& obj) {
+    if (const std::int64_t *pval = std::get_if<std::int64_t>(&obj)) {
+      return from_int(*pval);
+    }
+
+    return from_double(std::get<double>(obj));
+  }
+
+  double as_double() const {
+    return m_is_int ? static_cast<double>(m_int) : m_double;
+  }
+
+  Object to_object() const {
+    if (m_is_int) return m_int;
+    return m_double;
+  }
+};
+
+inline bool is_comparison(TokenType oper) {
+  switch (oper) {
+    case GREATER:
+    case GREATER_EQ:
+    case LESS:
+    case LESS_EQ:
+    case BANG_EQ:
+    case EQ_EQ:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Whether @value is integral and in the range of int64, then stored
+/// in @integer. Such doubles are equal to that integer.
+inline bool to_exact_int(double value, std::int64_t& integer) {
+  // -2^63 and 2^63 are exact doubles, unlike the bounds of int64
+  if (std::trunc(value) != value
+      || value < -9223372036854775808.0 || value >= 9223372036854775808.0) {
+    return false;
+  }
+
+  integer = static_cast<std::int64_t>(value);
+  return true;
+}
+
+/// Orders @left before, like or after the double @right, -1, 0 or 1,
+/// without rounding @left to a double. @right is not NaN.
+inline int order_mixed(std::int64_t left, double right) {
+  if (right >= 9223372036854775808.0) return -1;
+  if (right < -9223372036854775808.0) return 1;
+
+  double whole = std::trunc(right);
+  auto integer = static_cast<std::int64_t>(whole);
+  if (left != integer) return left < integer ? -1 : 1;
+
+  return whole < right ? -1 : (whole > right ? 1 : 0);
+}
+
+/// An integer and a double compare exactly, beyond 2^53 distinct
+/// integers would round to the same double.
+inline bool compare(TokenType oper, Number left, Number right) {
+  if (left.m_is_int && right.m_is_int) {
+    switch (oper) {
+      case GREATER:    return left.m_int > right.m_int;
+      case GREATER_EQ: return left.m_int >= right.m_int;
+      case LESS:       return left.m_int < right.m_int;
+      case LESS_EQ:    return left.m_int <= right.m_int;
+      case BANG_EQ:    return left.m_int != right.m_int;
+      default:         return left.m_int == right.m_int;
+    }
+  }
+
+  if (left.m_is_int != right.m_is_int) {
+    double other = left.m_is_int ? right.m_double : left.m_double;
+    if (std::isnan(other)) return oper == BANG_EQ;
+
+    int order = left.m_is_int ? order_mixed(left.m_int, right.m_double)
+                              : -order_mixed(right.m_int, left.m_double);
+    switch (oper) {
+      case GREATER:    return order > 0;
+      case GREATER_EQ: return order >= 0;
+      case LESS:       return order < 0;
+      case LESS_EQ:    return order <= 0;
+      case BANG_EQ:    return order != 0;
+      default:         return order == 0;
+    }
+  }
+
+  double l = left.as_double();
+  double r = right.as_double();
+  switch (oper) {
+    case GREATER:    return l > r;
+    case GREATER_EQ: return l >= r;
+    case LESS:       return l < r;
+    case LESS_EQ:    return l <= r;
+    case BANG_EQ:    return l != r;
+    default:         return l == r;
+  }
+}
+
+/// int x int stays an integer unless it overflows or does not divide evenly,
+/// in which case the operation is redone on doubles.
+inline Number arithmetic(TokenType oper, Number left, Number right) {
+  if (left.m_is_int && right.m_is_int) {
+    std::int64_t l = left.m_int;
+    std::int64_t r = right.m_int;
+    std::int64_t result{};
+
+    switch (oper) {
+      case PLUS:
+        if (!__builtin_add_overflow(l, r, &result)) return Number::from_int(result);
+        break;
+      case MINUS:
+        if (!__builtin_sub_overflow(l, r, &result)) return Number::from_int(result);
+        break;
+      case STAR:
+        if (!__builtin_mul_overflow(l, r, &result)) return Number::from_int(result);
+        break;
+      default:
+        if (r != 0 && !(r == -1 && l == INT64_MIN) && l % r == 0) {
+          return Number::from_int(l / r);
+        }
+        break;
+    }
+  }
+
+  double l = left.as_double();
+  double r = right.as_double();
+  switch (oper) {
+    case PLUS:  return Number::from_double(l + r);
+    case MINUS: return Number::from_double(l - r);
+    case STAR:  return Number::from_double(l * r);
+    default:    return Number::from_double(l / r);
+  }
+}
+
+inline Number negate(Number number) {
+  if (number.m_is_int && number.m_int != INT64_MIN) {
+    return Number::from_int(-number.m_int);
+  }
+
+  return Number::from_double(-number.as_double());
+}
+
+inline Object number_operation(TokenType oper, Number left, Number right) {
+  if (is_comparison(oper)) {
+    return compare(oper, left, right);
+  }
+
+  return arithmetic(oper, left, right).to_object();
+}
+
+} // namespace slang
+
+#endif // !__SLANG_NUMBER_HPP__
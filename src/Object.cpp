@@ -1,32 +1,37 @@
-#include <iostream>
+#include <charconv>
+#include <cmath>
 
 #include "Object.hpp"
 #include "ICallable.hpp"
 #include "SlangClass.hpp"
 #include "SlangInstance.hpp"
+#include "SlangList.hpp"
+#include "SlangMap.hpp"
+#include "SlangArray.hpp"
 
 namespace slang {
 
 std::string object_to_string(const Object& obj) {
   if (const double * pval = std::get_if<double>(&obj)) {
-    constexpr char trailing_zeros[] = ".000000";
-    constexpr size_t tz_size = sizeof(trailing_zeros) - 1;
-    auto str = std::to_string(*pval);
-
-    if (0 == str.compare(str.length() - tz_size, tz_size, trailing_zeros)) {
-      str = str.substr(0, str.length() - tz_size);
-    }
-
-    return str;
-
+    char buffer[NUMBER_BUFFER_SIZE];
+    return std::string(buffer, format_number(*pval, buffer));
+  } else if (const std::int64_t * pval = std::get_if<std::int64_t>(&obj)) {
+    char buffer[NUMBER_BUFFER_SIZE];
+    return std::string(buffer, format_number(*pval, buffer));
   } else if (const std::shared_ptr<ICallable> * pval = std::get_if<std::shared_ptr<ICallable>>(&obj)) {
     return pval->get()->to_string();
   } else if (const auto pval = std::get_if<std::shared_ptr<SlangInstance>>(&obj)) {
     return pval->get()->to_string();
+  } else if (const auto pval = std::get_if<std::shared_ptr<SlangList>>(&obj)) {
+    return pval->get()->to_string();
+  } else if (const auto pval = std::get_if<std::shared_ptr<SlangMap>>(&obj)) {
+    return pval->get()->to_string();
+  } else if (const auto pval = std::get_if<std::shared_ptr<SlangArray>>(&obj)) {
+    return pval->get()->to_string();
   } else if (const bool * pval = std::get_if<bool>(&obj)) {
     return *pval ? "true" : "false";
-  } else if (const std::string * pval = std::get_if<std::string>(&obj)) {
-    return *pval;
+  } else if (const SlangString * pval = std::get_if<SlangString>(&obj)) {
+    return pval->str();
   } else if (std::holds_alternative<std::nullptr_t>(obj)) {
     return "none";
   }
@@ -34,4 +39,21 @@ std::string object_to_string(const Object& obj) {
   return "";
 }
 
+char* format_number(double value, char* buffer) {
+  // integral doubles are the common case and print like integers,
+  // 2^53 keeps the conversion exact
+  constexpr double MAX_EXACT_INT = 9007199254740992.0;
+  if (std::fabs(value) <= MAX_EXACT_INT && value == std::trunc(value)
+      && !(value == 0 && std::signbit(value))) {
+    return format_number(static_cast<std::int64_t>(value), buffer);
+  }
+
+  // shortest representation that round-trips, locale independent
+  return std::to_chars(buffer, buffer + NUMBER_BUFFER_SIZE, value).ptr;
+}
+
+char* format_number(std::int64_t value, char* buffer) {
+  return std::to_chars(buffer, buffer + NUMBER_BUFFER_SIZE, value).ptr;
+}
+
 }
@@ -1,23 +1,41 @@
 #ifndef __SLANG_OBJECT_HPP__
 #define __SLANG_OBJECT_HPP__
 
+#include <cstdint>
 #include <string>
 #include <variant>
 #include <memory>
 
+#include "SlangString.hpp"
+
 namespace slang {
 
 class ICallable;
 class SlangClass;
 class SlangInstance;
+class SlangList;
+class SlangMap;
+class SlangArray;
 
-using Object = std::variant<double, bool, std::string, 
+using Object = std::variant<double, std::int64_t, bool, SlangString,
                             std::shared_ptr<ICallable>, ICallable*,
                             std::shared_ptr<SlangInstance>,
+                            std::shared_ptr<SlangList>,
+                            std::shared_ptr<SlangMap>,
+                            std::shared_ptr<SlangArray>,
                             std::nullptr_t>;
 
 std::string object_to_string(const Object& obj);
 
+/// Fits the text format_number writes for any number.
+constexpr std::size_t NUMBER_BUFFER_SIZE = 32;
+
+/// Writes the shortest text that reads back as @value to @buffer of
+/// NUMBER_BUFFER_SIZE chars, integral values without a fraction.
+/// Returns the end of the text, which is not null terminated.
+char* format_number(double value, char* buffer);
+char* format_number(std::int64_t value, char* buffer);
+
 } // namespace slang
 
 #endif // __SLANG_OBJECT_HPP__
@@ -0,0 +1,192 @@
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Output.hpp"
+
+namespace slang {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+static Output::FlushPolicy policy_from_env(int fd) {
+  const char* policy = std::getenv("SLANG_OUTPUT_FLUSH");
+  if (policy == nullptr || *policy == '\0') {
+    return isatty(fd) ? Output::LINE : Output::SIZE;
+  }
+
+  if (0 == std::strcmp(policy, "line")) return Output::LINE;
+  if (0 == std::strcmp(policy, "size")) return Output::SIZE;
+  if (0 == std::strcmp(policy, "explicit")) return Output::EXPLICIT;
+  if (0 == std::strcmp(policy, "exit")) return Output::EXIT;
+
+  std::cerr << "Unknown SLANG_OUTPUT_FLUSH '" << policy
+            << "', flushing on every line." << std::endl;
+  return Output::LINE;
+}
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+Output::Output(int fd, FlushPolicy policy, bool background_writer, bool owns_fd)
+  : m_fd(fd),
+    m_policy(policy),
+    m_owns_fd(owns_fd)
+{
+  m_buffer.reserve(BUFFER_SIZE);
+
+  if (background_writer) {
+    m_back.reserve(BUFFER_SIZE);
+    m_writer = std::thread(&Output::writer_loop, this);
+  }
+}
+
+Output::~Output() {
+  write_out();
+
+  if (m_writer.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    m_writer.join();
+  }
+
+  if (m_owns_fd) {
+    close(m_fd);
+  }
+}
+
+std::shared_ptr<Output> Output::standard() {
+  static std::shared_ptr<Output> output = []() {
+    int fd = STDOUT_FILENO;
+    bool owns_fd = false;
+
+    const char* path = std::getenv("SLANG_OUTPUT");
+    if (path != nullptr && *path != '\0') {
+      int file = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+      if (file < 0) {
+        std::cerr << "Could not open '" << path << "' for writing, "
+                  << "printing to the standard output." << std::endl;
+      } else {
+        fd = file;
+        owns_fd = true;
+      }
+    }
+
+    const char* thread = std::getenv("SLANG_OUTPUT_THREAD");
+    bool background_writer = thread != nullptr && 0 == std::strcmp(thread, "1");
+
+    return std::make_shared<Output>(fd, helpers::policy_from_env(fd),
+                                    background_writer, owns_fd);
+  }();
+
+  return output;
+}
+
+std::shared_ptr<Output> Output::separate() {
+  auto standard = Output::standard();
+  return std::make_shared<Output>(standard->m_fd, standard->m_policy, false);
+}
+
+void Output::print(const Object& value) {
+  if (const double * pval = std::get_if<double>(&value)) {
+    char buffer[NUMBER_BUFFER_SIZE];
+    m_buffer.append(buffer, format_number(*pval, buffer));
+  } else if (const std::int64_t * pval = std::get_if<std::int64_t>(&value)) {
+    char buffer[NUMBER_BUFFER_SIZE];
+    m_buffer.append(buffer, format_number(*pval, buffer));
+  } else if (const SlangString * pval = std::get_if<SlangString>(&value)) {
+    m_buffer.append(pval->view());
+  } else {
+    m_buffer.append(object_to_string(value));
+  }
+
+  m_buffer.push_back('\n');
+
+  if (m_policy == LINE || (m_policy == SIZE && m_buffer.size() >= BUFFER_SIZE)) {
+    write_out();
+  }
+}
+
+void Output::write(std::string_view text) {
+  m_buffer.append(text);
+
+  if (m_policy == LINE || (m_policy == SIZE && m_buffer.size() >= BUFFER_SIZE)) {
+    write_out();
+  }
+}
+
+void Output::flush() {
+  if (m_policy == EXIT) return;
+
+  write_out();
+
+  if (m_writer.joinable()) {
+    // written for real, so what is reported afterwards comes later
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this]() { return !m_pending; });
+  }
+}
+
+// ------------------------ | PRIVATE |
+void Output::write_out() {
+  if (!m_writer.joinable()) {
+    write_all(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // the writer must be done with the previous buffer
+  m_cond.wait(lock, [this]() { return !m_pending; });
+
+  if (!m_buffer.empty()) {
+    m_buffer.swap(m_back);
+    m_pending = true;
+    lock.unlock();
+    m_cond.notify_all();
+  }
+}
+
+void Output::write_all(const char* data, std::size_t size) const {
+  while (size > 0) {
+    ssize_t written = ::write(m_fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      // nowhere to report it, the output is lost like with std::cout
+      return;
+    }
+
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+}
+
+void Output::writer_loop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  for (;;) {
+    m_cond.wait(lock, [this]() { return m_pending || m_stop; });
+
+    if (m_pending) {
+      // m_back belongs to the writer while a write is pending
+      lock.unlock();
+      write_all(m_back.data(), m_back.size());
+      m_back.clear();
+      lock.lock();
+
+      m_pending = false;
+      m_cond.notify_all();
+    } else if (m_stop) {
+      return;
+    }
+  }
+}
+
+} // namespace slang
@@ -0,0 +1,83 @@
+#ifndef __SLANG_OUTPUT_HPP__
+#define __SLANG_OUTPUT_HPP__
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "Object.hpp"
+
+namespace slang {
+
+/// Where print writes to. Printed text is collected in a large buffer
+/// and handed to write(2) according to a FlushPolicy, optionally by a
+/// background thread, so print heavy scripts do not pay a syscall per line.
+class Output {
+public:
+  enum FlushPolicy {
+    LINE,      // after every print
+    SIZE,      // when the buffer is full
+    EXPLICIT,  // on flush(), the buffer grows until then
+    EXIT,      // when the output is destroyed, the buffer grows until then
+  };
+
+  static constexpr std::size_t BUFFER_SIZE = 64 * 1024;
+
+  /// Writes to @fd, closing it on destruction if @owns_fd.
+  /// With @background_writer a thread does the writes while the
+  /// interpreter fills the next buffer.
+  Output(int fd, FlushPolicy policy, bool background_writer, bool owns_fd = false);
+
+  Output(Output &&) = delete;
+  Output(const Output &) = delete;
+  Output &operator=(Output &&) = delete;
+  Output &operator=(const Output &) = delete;
+  ~Output();
+
+  /// The process wide output of print, flushed at exit. Configured with
+  ///   SLANG_OUTPUT        file to write to instead of the standard output,
+  ///   SLANG_OUTPUT_FLUSH  "line", "size", "explicit" or "exit", by default
+  ///                       "line" for a terminal and "size" otherwise,
+  ///   SLANG_OUTPUT_THREAD "1" for a background writer.
+  static std::shared_ptr<Output> standard();
+
+  /// A new Output to where standard() writes, with its own buffer, for
+  /// code printing from another thread. Every write(2) ends with a whole
+  /// line, so lines of different outputs never mix.
+  static std::shared_ptr<Output> separate();
+
+  /// Appends @value and a newline, as the print statement does.
+  void print(const Object& value);
+  void write(std::string_view text);
+
+  /// Writes out everything buffered so far, unless the policy is EXIT,
+  /// and returns once the background writer is done with it.
+  void flush();
+
+  FlushPolicy policy() const { return m_policy; }
+
+private:
+  int m_fd;
+  FlushPolicy m_policy;
+  bool m_owns_fd;
+  std::string m_buffer{};
+
+  // the background writer writes m_back while m_buffer is filled
+  std::thread m_writer{};
+  std::mutex m_mutex{};
+  std::condition_variable m_cond{};
+  std::string m_back{};
+  bool m_pending{false};
+  bool m_stop{false};
+
+  void write_out();
+  void write_all(const char* data, std::size_t size) const;
+  void writer_loop();
+};
+
+} // namespace slang
+
+#endif // !__SLANG_OUTPUT_HPP__
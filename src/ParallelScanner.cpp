@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+#include "ParallelScanner.hpp"
+#include "ScanKernels.hpp"
+#include "Scanner.hpp"
+
+namespace slang {
+
+// ------------------------ | HELPERS |
+struct ParallelScanner::Chunk {
+  std::size_t m_begin;
+  std::size_t m_end;
+
+  std::size_t m_newlines{0};
+  // whether the chunk ends inside a string when it starts
+  // outside [0] or inside [1] of one
+  bool m_ends_in_string[2]{false, false};
+
+  std::size_t m_first_line{1};
+  vector<Token> m_tokens{};
+  bool m_has_error{false};
+  std::string m_errors{};
+};
+
+namespace helpers {
+
+/// Follows strings and comments through @text the way the Scanner
+/// does, returns true if it ends inside a string.
+static bool ends_in_string(std::string_view text, bool in_string) {
+  const char* p = text.data();
+  const char* end = p + text.size();
+  std::size_t lines = 0;
+
+  while (p != end) {
+    if (in_string) {
+      p = scan::string_end(p, end, lines);
+      if (p == end) break;
+
+      ++p; // closing "
+      in_string = false;
+    } else {
+      char c = *p++;
+
+      if (c == '"') {
+        in_string = true;
+      } else if (c == '/' && p != end && *p == '/') {
+        p = scan::line_end(p, end);
+      }
+    }
+  }
+
+  return in_string;
+}
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+ParallelScanner::ParallelScanner(std::string_view src,
+                                 shared_ptr<ErrorReporter> reporter,
+                                 unsigned threads)
+  : m_src(src),
+    m_reporter(reporter),
+    m_threads(std::max(threads, 1u))
+{}
+
+vector<vector<Token>> ParallelScanner::scan_tokens() {
+  auto chunks = split();
+
+  for_each_chunk(chunks, [this](Chunk& chunk) {
+    auto text = m_src.substr(chunk.m_begin, chunk.m_end - chunk.m_begin);
+    chunk.m_newlines = std::count(text.begin(), text.end(), '\n');
+    chunk.m_ends_in_string[0] = helpers::ends_in_string(text, false);
+    chunk.m_ends_in_string[1] = helpers::ends_in_string(text, true);
+  });
+
+  // a chunk that starts inside a string is scanned with the one before it
+  vector<Chunk> merged;
+  bool in_string = false;
+  for (auto& chunk : chunks) {
+    if (in_string) {
+      merged.back().m_end = chunk.m_end;
+      merged.back().m_newlines += chunk.m_newlines;
+    } else {
+      merged.push_back(chunk);
+    }
+
+    in_string = chunk.m_ends_in_string[in_string];
+  }
+
+  std::size_t line = 1;
+  for (auto& chunk : merged) {
+    chunk.m_first_line = line;
+    line += chunk.m_newlines;
+  }
+
+  for_each_chunk(merged, [this](Chunk& chunk) {
+    std::ostringstream errors;
+    auto reporter = std::make_shared<ErrorReporter>(errors);
+    Scanner scanner(m_src.substr(chunk.m_begin, chunk.m_end - chunk.m_begin),
+                    reporter, chunk.m_first_line);
+
+    // about a token per 16 bytes of generated code, more is fine
+    chunk.m_tokens.reserve((chunk.m_end - chunk.m_begin) / 16);
+    do {
+      chunk.m_tokens.push_back(scanner.next_token());
+    } while (chunk.m_tokens.back().m_type != END_OF_FILE);
+
+    chunk.m_has_error = reporter->has_error();
+    chunk.m_errors = errors.str();
+  });
+
+  vector<vector<Token>> tokens;
+  tokens.reserve(merged.size());
+  for (auto& chunk : merged) {
+    if (chunk.m_has_error) {
+      m_reporter->relay(chunk.m_errors);
+    }
+
+    // only the last chunk ends the source
+    if (&chunk != &merged.back()) {
+      chunk.m_tokens.pop_back();
+    }
+
+    tokens.push_back(std::move(chunk.m_tokens));
+  }
+
+  return tokens;
+}
+
+unsigned ParallelScanner::threads_from_env() {
+  const char* threads = std::getenv("SLANG_SCAN_THREADS");
+  if (threads == nullptr || *threads == '\0') return 1;
+
+  long count = std::strtol(threads, nullptr, 10);
+  if (count == 0) {
+    return std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  return static_cast<unsigned>(std::max(count, 1l));
+}
+
+// ------------------------ | PRIVATE |
+vector<ParallelScanner::Chunk> ParallelScanner::split() const {
+  // a few chunks per thread even out uneven chunks
+  std::size_t count = std::min<std::size_t>(m_threads * 4,
+                                            m_src.size() / MIN_CHUNK_SIZE);
+  if (m_threads == 1) count = 1;
+
+  vector<Chunk> chunks;
+  std::size_t begin = 0;
+
+  for (std::size_t i = 1; i < count; ++i) {
+    std::size_t newline = m_src.find('\n', std::max(begin, i * m_src.size() / count));
+    if (newline == std::string_view::npos || newline + 1 == m_src.size()) break;
+
+    chunks.push_back(Chunk{begin, newline + 1});
+    begin = newline + 1;
+  }
+
+  chunks.push_back(Chunk{begin, m_src.size()});
+  return chunks;
+}
+
+template <typename Fn>
+void ParallelScanner::for_each_chunk(vector<Chunk>& chunks, Fn fn) const {
+  std::atomic<std::size_t> next{0};
+
+  auto worker = [&]() {
+    for (std::size_t i; (i = next++) < chunks.size();) {
+      fn(chunks[i]);
+    }
+  };
+
+  vector<std::thread> workers;
+  std::size_t count = std::min<std::size_t>(m_threads, chunks.size());
+  for (std::size_t i = 1; i < count; ++i) {
+    workers.emplace_back(worker);
+  }
+
+  worker();
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+} // namespace slang
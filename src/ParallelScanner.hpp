@@ -0,0 +1,63 @@
+#ifndef __SLANG_PARALLEL_SCANNER_HPP__
+#define __SLANG_PARALLEL_SCANNER_HPP__
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "ErrorReporter.hpp"
+#include "Token.hpp"
+
+namespace slang {
+
+using std::vector;
+using std::shared_ptr;
+
+/// Scans a source held in memory on several threads, for very large
+/// generated scripts.
+///
+/// The source is split into chunks right after newlines. Only strings
+/// can span lines, so a quick pre-pass finds, for every chunk, whether
+/// it would end inside a string when started inside or outside of one.
+/// Chunk boundaries that turn out to be inside a string are dropped.
+/// The remaining chunks are scanned independently with line numbers
+/// offset by the newlines before them, and their errors are relayed in
+/// order, so the result is the same as the one of Scanner::scan_tokens.
+class ParallelScanner {
+public:
+  /// Scans @src, which must outlive the scanner, on @threads threads.
+  ParallelScanner(std::string_view src, shared_ptr<ErrorReporter> reporter,
+                  unsigned threads);
+
+  ParallelScanner(ParallelScanner &&) = default;
+  ParallelScanner(const ParallelScanner &) = default;
+  ParallelScanner &operator=(ParallelScanner &&) = delete;
+  ParallelScanner &operator=(const ParallelScanner &) = delete;
+  ~ParallelScanner() = default;
+
+  /// Returns the tokens in chunks, in source order, the last chunk ends
+  /// with END_OF_FILE.
+  vector<vector<Token>> scan_tokens();
+
+  /// Number of threads SLANG_SCAN_THREADS asks for, "0" meaning one per
+  /// hardware thread. 1, or no parallel scanning, when it is not set.
+  static unsigned threads_from_env();
+
+private:
+  // smaller chunks are not worth a thread
+  static constexpr std::size_t MIN_CHUNK_SIZE = 1 << 20;
+
+  struct Chunk;
+
+  std::string_view m_src;
+  shared_ptr<ErrorReporter> m_reporter;
+  unsigned m_threads;
+
+  vector<Chunk> split() const;
+  template <typename Fn>
+  void for_each_chunk(vector<Chunk>& chunks, Fn fn) const;
+};
+
+} // namespace slang
+
+#endif // !__SLANG_PARALLEL_SCANNER_HPP__
@@ -1,13 +1,70 @@
 #include "Parser.hpp"
+#include "PreParsedBody.hpp"
 
 namespace slang {
 
 using std::make_shared;
 
+// ------------------------ | HELPERS |
+namespace helpers {
+
+enum InfixKind { BINARY, LOGICAL, ASSIGN, CALL, GET, INDEX };
+
+struct InfixRule {
+  Parser::Precedence m_precedence;
+  InfixKind m_kind;
+};
+
+/// How every token type continues an expression as an infix or postfix
+/// operator, PREC_NONE for the ones that end it.
+struct InfixRules {
+  InfixRule m_rules[END_OF_FILE + 1]{};
+
+  constexpr InfixRules() {
+    m_rules[EQ]         = { Parser::PREC_ASSIGNMENT, ASSIGN };
+    m_rules[OR]         = { Parser::PREC_OR,         LOGICAL };
+    m_rules[AND]        = { Parser::PREC_AND,        LOGICAL };
+    m_rules[BANG_EQ]    = { Parser::PREC_EQUALITY,   BINARY };
+    m_rules[EQ_EQ]      = { Parser::PREC_EQUALITY,   BINARY };
+    m_rules[GREATER]    = { Parser::PREC_COMPARISON, BINARY };
+    m_rules[GREATER_EQ] = { Parser::PREC_COMPARISON, BINARY };
+    m_rules[LESS]       = { Parser::PREC_COMPARISON, BINARY };
+    m_rules[LESS_EQ]    = { Parser::PREC_COMPARISON, BINARY };
+    m_rules[MINUS]      = { Parser::PREC_TERM,       BINARY };
+    m_rules[PLUS]       = { Parser::PREC_TERM,       BINARY };
+    m_rules[SLASH]      = { Parser::PREC_FACTOR,     BINARY };
+    m_rules[STAR]       = { Parser::PREC_FACTOR,     BINARY };
+    m_rules[LEFT_PAREN] = { Parser::PREC_CALL,       CALL };
+    m_rules[DOT]        = { Parser::PREC_CALL,       GET };
+    m_rules[LEFT_BRACKET] = { Parser::PREC_CALL,     INDEX };
+  }
+};
+
+static constexpr InfixRules s_infix_rules{};
+
+} // namespace helpers
+
 // ------------------------ | PUBLIC |
-Parser::Parser(const vector<Token>& tokens, shared_ptr<ErrorReporter> reporter)
-  : m_tokens(tokens),
-    m_reporter(reporter)
+Parser::Parser(Scanner& scanner, shared_ptr<ErrorReporter> reporter,
+               bool lazy_bodies)
+  : m_tokens(scanner),
+    m_reporter(reporter),
+    m_lazy_bodies(lazy_bodies)
+{}
+
+Parser::Parser(vector<vector<Token>> chunks, shared_ptr<ErrorReporter> reporter,
+               bool lazy_bodies)
+  : m_tokens(std::move(chunks)),
+    m_reporter(reporter),
+    m_lazy_bodies(lazy_bodies)
+{}
+
+Parser::Parser(vector<Token> tokens, shared_ptr<ErrorReporter> reporter,
+               bool is_break_allowed)
+  : m_tokens(std::move(tokens)),
+    m_reporter(reporter),
+    m_lazy_bodies(true),
+    m_is_break_allowed(is_break_allowed)
 {}
 
 
@@ -21,6 +78,14 @@ vector<shared_ptr<stmt::Stmt>> Parser::parse() {
   return statments;
 }
 
+vector<shared_ptr<stmt::Stmt>> Parser::parse_body() {
+  try {
+    return block();
+  } catch (const ParserError&) {
+    return {};
+  }
+}
+
 
 // ------------------------ | PRIVATE |
 //
@@ -28,6 +93,7 @@ vector<shared_ptr<stmt::Stmt>> Parser::parse() {
 shared_ptr<stmt::Stmt> Parser::declaration() {
   try {
     if (match({LET})) return var_declaration();
+    if (match({IMPORT})) return import_statement();
 
     return statement();
   } catch (const ParserError& e) {
@@ -37,7 +103,7 @@ shared_ptr<stmt::Stmt> Parser::declaration() {
 }
 
 shared_ptr<stmt::Stmt> Parser::var_declaration() {
-  auto& name = consume(IDENTIFIER, "Expect variable name.");
+  Token name = consume(IDENTIFIER, "Expect variable name.");
 
   shared_ptr<expr::Expr> initializer;
   if (match({EQ})) {
@@ -49,7 +115,7 @@ shared_ptr<stmt::Stmt> Parser::var_declaration() {
 }
 
 shared_ptr<stmt::Stmt> Parser::class_declaration() {
-  auto& name = consume(IDENTIFIER, "Expect class name.");
+  Token name = consume(IDENTIFIER, "Expect class name.");
   consume(LEFT_BRACE, "Expect '{' before class body.");
 
   vector<shared_ptr<stmt::Fn>> methods;
@@ -62,8 +128,16 @@ shared_ptr<stmt::Stmt> Parser::class_declaration() {
   return make_shared<stmt::Class>(stmt::Class(name, methods));
 }
 
+shared_ptr<stmt::Stmt> Parser::import_statement() {
+  Token keyword = previous();
+  Token path = consume(STRING, "Expect module path after 'import'.");
+  consume(SEMICOLON, "Expect ';' after module path.");
+
+  return make_shared<stmt::Import>(stmt::Import(keyword, path));
+}
+
 shared_ptr<stmt::Fn> Parser::function(const string& kind) {
-  auto& name = consume(IDENTIFIER, "Expect " + kind + " name.");
+  Token name = consume(IDENTIFIER, "Expect " + kind + " name.");
   consume(LEFT_PAREN, "Expect '(' after " + kind + " name.");
 
   vector<Token> params;
@@ -80,12 +154,17 @@ shared_ptr<stmt::Fn> Parser::function(const string& kind) {
   consume(RIGHT_PAREN, "Expect ')' after parameters.");
 
   vector<shared_ptr<stmt::Stmt>> body;
+  shared_ptr<LazyBody> lazy_body;
 
   if (match({LEFT_BRACE})) {
-    body = block();
+    if (m_lazy_bodies) {
+      lazy_body = pre_parse_block(params);
+    } else {
+      body = block();
+    }
   } else if (match({EQ_GREATER})) {
     // arrow function
-    auto& keyword = previous();
+    Token keyword = previous();
     auto value = expression();
     auto stmt_ret = make_shared<stmt::Return>(stmt::Return(keyword, value));
     body.push_back(stmt_ret);
@@ -94,7 +173,7 @@ shared_ptr<stmt::Fn> Parser::function(const string& kind) {
     consume(LEFT_BRACE, "Expect '{' before " + kind + " body.");
   }
 
-  return make_shared<stmt::Fn>(stmt::Fn(name, params, body));
+  return make_shared<stmt::Fn>(stmt::Fn(name, params, body, lazy_body));
 }
 
 shared_ptr<stmt::Stmt> Parser::statement() {
@@ -113,13 +192,13 @@ shared_ptr<stmt::Stmt> Parser::statement() {
 }
 
 shared_ptr<stmt::Stmt> Parser::break_statement() {
-  auto& keyword = previous();
+  Token keyword = previous();
   consume(SEMICOLON, "Expect ';' after break.");
   return make_shared<stmt::Break>(stmt::Break(keyword));
 }
 
 shared_ptr<stmt::Stmt> Parser::return_statement() {
-  auto& keyword = previous();
+  Token keyword = previous();
   std::shared_ptr<expr::Expr> value = nullptr;
 
   if (!check(SEMICOLON)) {
@@ -146,7 +225,10 @@ shared_ptr<stmt::Stmt> Parser::while_statement() {
   auto condition = expression();
   consume(RIGHT_PAREN, "Expected ')' after while condition.");
 
+  // set and cleared as the Resolver does, for the bodies pre-parsed in it
+  m_is_break_allowed = true;
   auto then_branch = statement();
+  m_is_break_allowed = false;
   shared_ptr<stmt::Stmt> else_branch = match({ELSE}) ? statement() : nullptr;
 
   return make_shared<stmt::While>(stmt::While(condition, then_branch, else_branch));
@@ -174,7 +256,9 @@ shared_ptr<stmt::Stmt> Parser::for_statement() {
   }
   consume(RIGHT_PAREN, "Expect ')' after for clauses.");
 
+  m_is_break_allowed = true;
   shared_ptr<stmt::Stmt> body = statement();
+  m_is_break_allowed = false;
 
   if (increment != nullptr) {
     body = make_shared<stmt::Block>(
@@ -210,6 +294,35 @@ vector<shared_ptr<stmt::Stmt>> Parser::block() {
   return statements;
 }
 
+shared_ptr<LazyBody> Parser::pre_parse_block(const vector<Token>& params) {
+  vector<Token> tokens;
+  vector<string> assigned;
+
+  m_body_tokens = &tokens;
+  m_body_assigned = &assigned;
+
+  m_body_scopes.emplace_back();
+  for (auto& param : params) {
+    skim_declare(param);
+    skim_define(param);
+  }
+
+  while (!check(RIGHT_BRACE) && !is_at_end()) {
+    skim_declaration();
+  }
+
+  m_body_tokens = nullptr;
+  m_body_assigned = nullptr;
+  m_body_scopes.clear();
+
+  tokens.push_back(consume(RIGHT_BRACE, "Expect '}' after block."));
+  tokens.push_back(Token(END_OF_FILE, "", nullptr, previous().m_line));
+
+  auto body = make_shared<PreParsedBody>(std::move(tokens), m_reporter);
+  body->m_assigned = std::move(assigned);
+  return body;
+}
+
 shared_ptr<stmt::Stmt> Parser::print_statement() {
   auto value = expression();
   consume(SEMICOLON, "Exprect ';' after value.");
@@ -223,171 +336,521 @@ shared_ptr<stmt::Stmt> Parser::expression_statement() {
 }
 
 shared_ptr<expr::Expr> Parser::expression() {
-  return assigment();
+  return parse_precedence(PREC_ASSIGNMENT);
 }
 
+shared_ptr<expr::Expr> Parser::parse_precedence(Precedence min_precedence) {
+  auto expr = unary();
 
-shared_ptr<expr::Expr> Parser::assigment() {
-  auto expr = or_();
+  for (;;) {
+    const auto& rule = helpers::s_infix_rules.m_rules[peek().m_type];
+    if (rule.m_precedence == PREC_NONE || rule.m_precedence < min_precedence) {
+      break;
+    }
 
-  if (match({EQ})) {
-    auto& equals = previous();
-    auto value = assigment();
+    Token oper = advance();
 
-    if (expr::Variable *v = dynamic_cast<expr::Variable*>(expr.get())) {
-      Token name = v->m_name;
-      return make_shared<expr::Assign>(name, value);
-    }
+    switch (rule.m_kind) {
+      case helpers::ASSIGN:
+        expr = assigment(expr, oper);
+        break;
 
-    if (auto get = dynamic_cast<expr::Get*>(expr.get())) {
-      return make_shared<expr::Set>(expr::Set(get->m_object, get->m_name, value));
-    }
+      case helpers::BINARY: {
+        auto right = parse_precedence(static_cast<Precedence>(rule.m_precedence + 1));
+        expr = make_shared<expr::Binary>(expr::Binary(expr, oper, right));
+        break;
+      }
+
+      case helpers::LOGICAL: {
+        auto right = parse_precedence(static_cast<Precedence>(rule.m_precedence + 1));
+        expr = make_shared<expr::Logical>(expr::Logical(expr, oper, right));
+        break;
+      }
+
+      case helpers::CALL:
+        expr = finish_call(expr);
+        break;
+
+      case helpers::GET: {
+        auto& name = consume(IDENTIFIER, "Expect property name after '.'.");
+        expr = make_shared<expr::Get>(expr, name);
+        break;
+      }
 
-    error(equals, "Invalid assigment target.");
+      case helpers::INDEX:
+        expr = finish_index(expr, oper);
+        break;
+    }
   }
 
   return expr;
 }
 
-shared_ptr<expr::Expr> Parser::or_() {
-  auto expr = and_();
+shared_ptr<expr::Expr> Parser::assigment(shared_ptr<expr::Expr>& target,
+                                         const Token& equals) {
+  // right-associative
+  auto value = parse_precedence(PREC_ASSIGNMENT);
 
-  while (match({OR})) {
-    auto& oper = previous();
-    auto right = and_();
-    expr = make_shared<expr::Logical>(expr::Logical(expr, oper, right));
+  if (expr::Variable *v = dynamic_cast<expr::Variable*>(target.get())) {
+    Token name = v->m_name;
+    return make_shared<expr::Assign>(name, value);
   }
 
-  return expr;
+  if (auto get = dynamic_cast<expr::Get*>(target.get())) {
+    return make_shared<expr::Set>(expr::Set(get->m_object, get->m_name, value));
+  }
+
+  if (auto index = dynamic_cast<expr::Index*>(target.get())) {
+    return make_shared<expr::SetIndex>(
+        expr::SetIndex(index->m_object, index->m_bracket, index->m_index, value));
+  }
+
+  error(equals, "Invalid assigment target.");
+  return target;
+}
+
+shared_ptr<expr::Expr> Parser::unary() {
+  if (match({BANG, MINUS})) {
+    Token oper = previous();
+    auto right = parse_precedence(PREC_UNARY);
+    return make_shared<expr::Unary>(expr::Unary(oper, right));
+  }
+
+  return primary();
 }
 
-shared_ptr<expr::Expr> Parser::and_() {
-  auto expr = equality();
+shared_ptr<expr::Expr> Parser::finish_call(shared_ptr<expr::Expr>& callee) {
+  vector<shared_ptr<expr::Expr>> args;
 
-  while (match({AND})) {
-    auto& oper = previous();
-    auto right = equality();
-    expr = make_shared<expr::Logical>(expr::Logical(expr, oper, right));
+  if (!check(RIGHT_PAREN)) {
+    do {
+      if (args.size() >= 255) {
+        m_reporter->error(peek(), "Can't have more than 255 arguments.");
+      }
+      args.push_back(expression());
+    } while (match({COMMA}));
   }
 
-  return expr;
+  auto& paren = consume(RIGHT_PAREN, "Exprect ')' after arguments.");
+
+  return make_shared<expr::Call>(expr::Call(callee, paren, args));
 }
 
-shared_ptr<expr::Expr> Parser::equality() {
-  auto expr = comprasion();
+shared_ptr<expr::Expr> Parser::finish_index(shared_ptr<expr::Expr>& object,
+                                           const Token& bracket) {
+  shared_ptr<expr::Expr> start;
+  if (!check(COLON)) {
+    start = expression();
+  }
+
+  if (match({COLON})) {
+    shared_ptr<expr::Expr> end;
+    if (!check(RIGHT_BRACKET)) {
+      end = expression();
+    }
 
-  while (match({BANG_EQ, EQ_EQ})) {
-    auto& oper = previous();
-    auto right = comprasion();
-    expr = make_shared<expr::Binary>(expr::Binary(expr, oper, right));
+    consume(RIGHT_BRACKET, "Expect ']' after slice.");
+    return make_shared<expr::Slice>(expr::Slice(object, bracket, start, end));
   }
 
-  return expr;
+  consume(RIGHT_BRACKET, "Expect ']' after index.");
+  return make_shared<expr::Index>(expr::Index(object, bracket, start));
 }
 
-shared_ptr<expr::Expr> Parser::comprasion() {
-  auto expr = term();
+shared_ptr<expr::Expr> Parser::primary() {
+  if (match({FALSE})) return make_shared<expr::Literal>(expr::Literal(false));
+  if (match({TRUE})) return make_shared<expr::Literal>(expr::Literal(true));
+  if (match({NONE})) return make_shared<expr::Literal>(expr::Literal(nullptr));
 
-  while (match({GREATER, GREATER_EQ, LESS, LESS_EQ})) {
-    auto& oper = previous();
-    auto right = term();
-    expr = make_shared<expr::Binary>(expr::Binary(expr, oper, right));
+  if (match({NUMBER, STRING})) {
+    return make_shared<expr::Literal>(expr::Literal(previous().m_literal));
   }
 
-  return expr;
+  if (match({IDENTIFIER})) return make_shared<expr::Variable>(previous());
+
+  if (match({LEFT_PAREN})) {
+    auto expr = expression();
+    consume(RIGHT_PAREN, "Expect ')' after expression.");
+    return make_shared<expr::Grouping>(expr::Grouping(expr));
+  }
+
+  if (match({LEFT_BRACKET})) {
+    Token bracket = previous();
+    vector<shared_ptr<expr::Expr>> elements;
+    if (!check(RIGHT_BRACKET)) {
+      do {
+        // a trailing comma is fine
+        if (check(RIGHT_BRACKET)) break;
+        elements.push_back(expression());
+      } while (match({COMMA}));
+    }
+
+    consume(RIGHT_BRACKET, "Expect ']' after list elements.");
+    return make_shared<expr::List>(expr::List(bracket, elements));
+  }
+
+  // a brace starting a statement opens a block, so only expressions get here
+  if (match({LEFT_BRACE})) {
+    Token brace = previous();
+    vector<shared_ptr<expr::Expr>> keys;
+    vector<shared_ptr<expr::Expr>> values;
+    if (!check(RIGHT_BRACE)) {
+      do {
+        // a trailing comma is fine
+        if (check(RIGHT_BRACE)) break;
+        keys.push_back(expression());
+        consume(COLON, "Expect ':' after map key.");
+        values.push_back(expression());
+      } while (match({COMMA}));
+    }
+
+    consume(RIGHT_BRACE, "Expect '}' after map entries.");
+    return make_shared<expr::Map>(expr::Map(brace, keys, values));
+  }
+
+  throw error(peek(), "Expect expression.");
+}
+
+// ------------------------ | PRE-PARSE |
+void Parser::skim_declaration() {
+  // scopes the statement did not get to close
+  std::size_t depth = m_body_scopes.size();
+
+  try {
+    if (match({LET})) return skim_var_declaration();
+
+    if (match({IMPORT})) {
+      Token keyword = previous();
+      consume(STRING, "Expect module path after 'import'.");
+      consume(SEMICOLON, "Expect ';' after module path.");
+      m_reporter->error(keyword, "Can only import at the top level.");
+      return;
+    }
+
+    skim_statement();
+  } catch (const ParserError& e) {
+    m_body_scopes.resize(depth);
+    sync();
+  }
 }
 
-shared_ptr<expr::Expr> Parser::term() {
-  auto expr = factor();
+void Parser::skim_var_declaration() {
+  Token name = consume(IDENTIFIER, "Expect variable name.");
+  skim_declare(name);
 
-  while (match({MINUS, PLUS})) {
-    auto& oper = previous();
-    auto right = factor();
-    expr = make_shared<expr::Binary>(expr::Binary(expr, oper, right));
+  if (match({EQ})) {
+    skim_precedence(PREC_ASSIGNMENT);
   }
 
-  return expr;
+  skim_define(name);
+  consume(SEMICOLON, "Expect ';' after variable declaration.");
 }
 
-shared_ptr<expr::Expr> Parser::factor() {
-  auto expr = unary();
+void Parser::skim_function(const string& kind) {
+  Token name = consume(IDENTIFIER, "Expect " + kind + " name.");
+  // methods are found on the instance, not in a scope
+  if (kind != "method") {
+    skim_declare(name);
+    skim_define(name);
+  }
+
+  consume(LEFT_PAREN, "Expect '(' after " + kind + " name.");
+
+  // the parameters and the body share a scope
+  m_body_scopes.emplace_back();
 
-  while (match({SLASH, STAR})) {
-    auto& oper = previous();
-    auto right = unary();
-    expr = make_shared<expr::Binary>(expr::Binary(expr, oper, right));
+  std::size_t params = 0;
+  if (!check(RIGHT_PAREN)) {
+    do {
+      if (params++ >= 255) {
+        m_reporter->error(peek(), "Cannot have more than 255 parameters.");
+      }
+
+      Token param = consume(IDENTIFIER, "Expect parameter name.");
+      skim_declare(param);
+      skim_define(param);
+    } while(match({COMMA}));
   }
 
-  return expr;
+  consume(RIGHT_PAREN, "Expect ')' after parameters.");
+
+  if (match({LEFT_BRACE})) {
+    skim_block();
+  } else if (match({EQ_GREATER})) {
+    skim_precedence(PREC_ASSIGNMENT);
+    consume(SEMICOLON, "Expect ';' after arrow " + kind + " body.");
+  } else {
+    consume(LEFT_BRACE, "Expect '{' before " + kind + " body.");
+  }
+
+  m_body_scopes.pop_back();
 }
 
-shared_ptr<expr::Expr> Parser::unary() {
-  if (match({BANG, MINUS})) {
-    auto& oper = previous();
-    auto right = unary();
-    return make_shared<expr::Unary>(expr::Unary(oper, right));
+void Parser::skim_statement() {
+  if (match({BREAK})) {
+    Token keyword = previous();
+    consume(SEMICOLON, "Expect ';' after break.");
+    if (!m_is_break_allowed) {
+      m_reporter->error(keyword, "break is not allowed here.");
+    }
+    return;
+  }
+
+  if (match({CLASS})) {
+    Token name = consume(IDENTIFIER, "Expect class name.");
+    skim_declare(name);
+    skim_define(name);
+
+    consume(LEFT_BRACE, "Expect '{' before class body.");
+    while (!check(RIGHT_BRACE) && !is_at_end()) {
+      skim_function("method");
+    }
+    consume(RIGHT_BRACE, "Expect '}' after class body.");
+    return;
+  }
+
+  if (match({FOR})) {
+    consume(LEFT_PAREN, "Expected '(' after 'for'.");
+
+    // scopes of the blocks for_statement() wraps the loop and its body in
+    std::size_t depth = m_body_scopes.size();
+    if (!check(SEMICOLON)) m_body_scopes.emplace_back();
+
+    if (match({LET})) {
+      skim_var_declaration();
+    } else if (!match({SEMICOLON})) {
+      skim_precedence(PREC_ASSIGNMENT);
+      consume(SEMICOLON, "Exprect ';' after expression.");
+    }
+
+    if (!check(SEMICOLON)) skim_precedence(PREC_ASSIGNMENT);
+    consume(SEMICOLON, "Expect ';' after loop condition.");
+
+    bool has_increment = !check(RIGHT_PAREN);
+    if (has_increment) skim_precedence(PREC_ASSIGNMENT);
+    consume(RIGHT_PAREN, "Expect ')' after for clauses.");
+
+    if (has_increment) m_body_scopes.emplace_back();
+
+    m_is_break_allowed = true;
+    skim_statement();
+    m_is_break_allowed = false;
+
+    m_body_scopes.resize(depth);
+    return;
+  }
+
+  if (match({FN})) return skim_function("function");
+
+  if (match({IF, WHILE})) {
+    const string keyword = previous().m_lexeme;
+    bool is_loop = previous().m_type == WHILE;
+    consume(LEFT_PAREN, "Expected '(' after '" + keyword + "'.");
+    skim_precedence(PREC_ASSIGNMENT);
+    consume(RIGHT_PAREN, "Expected ')' after " + keyword + " condition.");
+
+    if (is_loop) m_is_break_allowed = true;
+    skim_statement();
+    if (is_loop) m_is_break_allowed = false;
+
+    if (match({ELSE})) skim_statement();
+    return;
+  }
+
+  if (match({LEFT_BRACE})) {
+    m_body_scopes.emplace_back();
+    skim_block();
+    m_body_scopes.pop_back();
+    return;
+  }
+
+  if (match({PRINT})) {
+    skim_precedence(PREC_ASSIGNMENT);
+    consume(SEMICOLON, "Exprect ';' after value.");
+    return;
+  }
+
+  if (match({RETURN})) {
+    if (!check(SEMICOLON)) skim_precedence(PREC_ASSIGNMENT);
+    consume(SEMICOLON, "Expect ';' after return value.");
+    return;
   }
 
-  return call();
+  skim_precedence(PREC_ASSIGNMENT);
+  consume(SEMICOLON, "Exprect ';' after expression.");
 }
 
+void Parser::skim_block() {
+  while (!check(RIGHT_BRACE) && !is_at_end()) {
+    skim_declaration();
+  }
+
+  consume(RIGHT_BRACE, "Expect '}' after block.");
+}
 
-shared_ptr<expr::Expr> Parser::call() {
-  auto expr = primary();
+Parser::Shape Parser::skim_precedence(Precedence min_precedence) {
+  Shape shape = skim_unary();
 
-  while (true) {
-    if (match({LEFT_PAREN})) {
-      expr = finish_call(expr);
-    } else if (match({DOT})) {
-      auto& name = consume(IDENTIFIER, "Expect property name after '.'.");
-      expr = make_shared<expr::Get>(expr, name);
-    } else {
+  for (;;) {
+    const auto& rule = helpers::s_infix_rules.m_rules[peek().m_type];
+    if (rule.m_precedence == PREC_NONE || rule.m_precedence < min_precedence) {
       break;
     }
+
+    Token oper = advance();
+
+    switch (rule.m_kind) {
+      case helpers::ASSIGN:
+        // right-associative
+        skim_precedence(PREC_ASSIGNMENT);
+        if (shape != SHAPE_TARGET) error(oper, "Invalid assigment target.");
+        shape = SHAPE_VALUE;
+        break;
+
+      case helpers::BINARY:
+      case helpers::LOGICAL:
+        skim_precedence(static_cast<Precedence>(rule.m_precedence + 1));
+        shape = SHAPE_VALUE;
+        break;
+
+      case helpers::CALL:
+        skim_call();
+        shape = SHAPE_VALUE;
+        break;
+
+      case helpers::GET:
+        consume(IDENTIFIER, "Expect property name after '.'.");
+        shape = SHAPE_TARGET;
+        break;
+
+      case helpers::INDEX:
+        shape = skim_index();
+        break;
+    }
   }
 
-  return expr;
+  return shape;
 }
 
-shared_ptr<expr::Expr> Parser::finish_call(shared_ptr<expr::Expr>& callee) {
-  vector<shared_ptr<expr::Expr>> args;
+Parser::Shape Parser::skim_unary() {
+  if (match({BANG, MINUS})) {
+    skim_precedence(PREC_UNARY);
+    return SHAPE_VALUE;
+  }
+
+  return skim_primary();
+}
+
+void Parser::skim_call() {
+  std::size_t args = 0;
 
   if (!check(RIGHT_PAREN)) {
     do {
-      if (args.size() >= 255) {
+      if (args++ >= 255) {
         m_reporter->error(peek(), "Can't have more than 255 arguments.");
       }
-      args.push_back(expression());
+      skim_precedence(PREC_ASSIGNMENT);
     } while (match({COMMA}));
   }
 
-  auto& paren = consume(RIGHT_PAREN, "Exprect ')' after arguments.");
-
-  return make_shared<expr::Call>(expr::Call(callee, paren, args));
+  consume(RIGHT_PAREN, "Exprect ')' after arguments.");
 }
 
-shared_ptr<expr::Expr> Parser::primary() {
-  if (match({FALSE})) return make_shared<expr::Literal>(expr::Literal(false));
-  if (match({TRUE})) return make_shared<expr::Literal>(expr::Literal(true));
-  if (match({NONE})) return make_shared<expr::Literal>(expr::Literal(nullptr));
+Parser::Shape Parser::skim_index() {
+  if (!check(COLON)) {
+    skim_precedence(PREC_ASSIGNMENT);
+  }
 
-  if (match({NUMBER, STRING})) {
-    return make_shared<expr::Literal>(expr::Literal(previous().m_literal));
+  if (match({COLON})) {
+    if (!check(RIGHT_BRACKET)) {
+      skim_precedence(PREC_ASSIGNMENT);
+    }
+
+    consume(RIGHT_BRACKET, "Expect ']' after slice.");
+    return SHAPE_VALUE;
   }
 
-  if (match({IDENTIFIER})) return make_shared<expr::Variable>(previous());
+  consume(RIGHT_BRACKET, "Expect ']' after index.");
+  return SHAPE_TARGET;
+}
+
+Parser::Shape Parser::skim_primary() {
+  if (match({FALSE, TRUE, NONE, NUMBER, STRING})) return SHAPE_VALUE;
+
+  if (match({IDENTIFIER})) {
+    const Token& name = previous();
+
+    // a name followed by '=' is assigned to, or the assignment is invalid
+    if (check(EQ)) {
+      m_body_assigned->push_back(name.m_lexeme);
+      return SHAPE_TARGET;
+    }
+
+    for (auto it = m_body_scopes.rbegin(); it != m_body_scopes.rend(); ++it) {
+      auto found = it->find(name.m_lexeme);
+
+      if (found != it->end() && found->second == false) {
+        m_reporter->error(name, "Can't read local variable in its own initializer.");
+        break;
+      }
+    }
+
+    return SHAPE_TARGET;
+  }
 
   if (match({LEFT_PAREN})) {
-    auto expr = expression();
+    skim_precedence(PREC_ASSIGNMENT);
     consume(RIGHT_PAREN, "Expect ')' after expression.");
-    return make_shared<expr::Grouping>(expr::Grouping(expr));
+    return SHAPE_VALUE;
+  }
+
+  if (match({LEFT_BRACKET})) {
+    if (!check(RIGHT_BRACKET)) {
+      do {
+        // a trailing comma is fine
+        if (check(RIGHT_BRACKET)) break;
+        skim_precedence(PREC_ASSIGNMENT);
+      } while (match({COMMA}));
+    }
+
+    consume(RIGHT_BRACKET, "Expect ']' after list elements.");
+    return SHAPE_VALUE;
+  }
+
+  if (match({LEFT_BRACE})) {
+    if (!check(RIGHT_BRACE)) {
+      do {
+        // a trailing comma is fine
+        if (check(RIGHT_BRACE)) break;
+        skim_precedence(PREC_ASSIGNMENT);
+        consume(COLON, "Expect ':' after map key.");
+        skim_precedence(PREC_ASSIGNMENT);
+      } while (match({COMMA}));
+    }
+
+    consume(RIGHT_BRACE, "Expect '}' after map entries.");
+    return SHAPE_VALUE;
   }
 
   throw error(peek(), "Expect expression.");
 }
 
+void Parser::skim_declare(const Token& name) {
+  auto& scope = m_body_scopes.back();
+
+  if (scope.find(name.m_lexeme) != scope.end()) {
+    m_reporter->error(name, "Already variable with this name in this scope.");
+  }
+
+  scope.insert_or_assign(name.m_lexeme, false);
+}
+
+void Parser::skim_define(const Token& name) {
+  m_body_scopes.back().insert_or_assign(name.m_lexeme, true);
+}
+
 // ------------------------ | HELPERS |
-bool Parser::match(const vector<TokenType>& types) {
+bool Parser::match(std::initializer_list<TokenType> types) {
   for (auto t : types) {
     if (check(t)) {
       advance();
@@ -398,24 +861,27 @@ bool Parser::match(const vector<TokenType>& types) {
   return false;
 }
 
-bool Parser::check(TokenType type) const {
+bool Parser::check(TokenType type) {
   return !is_at_end() && peek().m_type == type;
 }
 
-bool Parser::is_at_end() const {
+bool Parser::is_at_end() {
   return peek().m_type == END_OF_FILE;
 }
 
-const Token& Parser::peek() const {
-  return m_tokens[m_current];
+const Token& Parser::peek() {
+  return m_tokens.peek();
 }
 
 const Token& Parser::previous() const {
-  return m_tokens[m_current - 1];
+  return m_tokens.previous();
 }
 
 const Token& Parser::advance() {
-  if (!is_at_end()) ++m_current;
+  if (!is_at_end()) {
+    if (m_body_tokens) m_body_tokens->push_back(peek());
+    m_tokens.advance();
+  }
   return previous();
 }
 
@@ -443,6 +909,7 @@ void Parser::sync() {
       case LET:
       case FOR:
       case IF:
+      case IMPORT:
       case WHILE:
       case PRINT:
       case RETURN:
@@ -1,10 +1,13 @@
 #ifndef __SLANG_PARSER_HPP__
 #define __SLANG_PARSER_HPP__
 
+#include <initializer_list>
 #include <stdexcept>
+#include <unordered_map>
 #include <vector>
 
 #include "Token.hpp"
+#include "TokenStream.hpp"
 #include "Expr.hpp"
 #include "Stmt.hpp"
 #include "ErrorReporter.hpp"
@@ -17,19 +20,60 @@ using std::string;
 
 class Parser {
 public:
-  Parser(const vector<Token>& tokens, shared_ptr<ErrorReporter> reporter);
+  /// Pulls tokens from @scanner as it goes. Pre-parse mode when
+  /// @lazy_bodies is set: bodies of functions are only checked against
+  /// the grammar and parsed on their first call, see PreParsedBody.
+  Parser(Scanner& scanner, shared_ptr<ErrorReporter> reporter,
+         bool lazy_bodies = false);
+
+  /// Parses @chunks of tokens scanned ahead, see ParallelScanner.
+  Parser(vector<vector<Token>> chunks, shared_ptr<ErrorReporter> reporter,
+         bool lazy_bodies = false);
+
+  /// Parses the pre-parsed @tokens of a function body, declared where
+  /// a break is allowed when @is_break_allowed is set.
+  Parser(vector<Token> tokens, shared_ptr<ErrorReporter> reporter,
+         bool is_break_allowed);
+
   Parser(Parser &&) = default;
   Parser(const Parser &) = default;
-  Parser &operator=(Parser &&) = delete; // delete because of const member
+  Parser &operator=(Parser &&) = delete;
   Parser &operator=(const Parser &) = delete;
   ~Parser() = default;
 
   vector<shared_ptr<stmt::Stmt>> parse();
 
+  /// Parses the statements of a block whose '{' was already consumed.
+  vector<shared_ptr<stmt::Stmt>> parse_body();
+
+  /// Binding power of operators, from the loosest to the tightest.
+  enum Precedence {
+    PREC_NONE,
+    PREC_ASSIGNMENT,  // =
+    PREC_OR,          // or
+    PREC_AND,         // and
+    PREC_EQUALITY,    // == !=
+    PREC_COMPARISON,  // < > <= >=
+    PREC_TERM,        // + -
+    PREC_FACTOR,      // * /
+    PREC_UNARY,       // ! -
+    PREC_CALL,        // . () []
+  };
+
 private:
-  const vector<Token>& m_tokens;
-  std::size_t m_current = 0;
+  TokenStream m_tokens;
   shared_ptr<ErrorReporter> m_reporter;
+  bool m_lazy_bodies{false};
+
+  // where the body being pre-parsed goes, advance() copies every token
+  vector<Token>* m_body_tokens{nullptr};
+  vector<string>* m_body_assigned{nullptr};
+
+  // what the Resolver would see in the body being pre-parsed: the names
+  // declared in its scopes, defined or not yet, and whether a break is
+  // allowed, which is tracked while parsing the loops around it as well
+  vector<std::unordered_map<string, bool>> m_body_scopes{};
+  bool m_is_break_allowed{false};
 
   class ParserError : public std::runtime_error {
   public:
@@ -41,6 +85,7 @@ private:
   shared_ptr<stmt::Stmt> declaration();
   shared_ptr<stmt::Stmt> var_declaration();
   shared_ptr<stmt::Stmt> class_declaration();
+  shared_ptr<stmt::Stmt> import_statement();
   shared_ptr<stmt::Fn> function(const string& kind);
   shared_ptr<stmt::Stmt> statement();
   shared_ptr<stmt::Stmt> break_statement();
@@ -49,32 +94,51 @@ private:
   shared_ptr<stmt::Stmt> while_statement();
   shared_ptr<stmt::Stmt> for_statement();
   vector<shared_ptr<stmt::Stmt>> block();
+  shared_ptr<LazyBody> pre_parse_block(const vector<Token>& params);
   shared_ptr<stmt::Stmt> print_statement();
   shared_ptr<stmt::Stmt> expression_statement();
 
   shared_ptr<expr::Expr> expression();
-  shared_ptr<expr::Expr> assigment();
-  shared_ptr<expr::Expr> or_();
-  shared_ptr<expr::Expr> and_();
-  shared_ptr<expr::Expr> equality();
-  shared_ptr<expr::Expr> comprasion();
-  shared_ptr<expr::Expr> term();
-  shared_ptr<expr::Expr> factor();
+  /// Parses an expression whose operators bind at least as tight as
+  /// @min_precedence, driven by the infix rules table.
+  shared_ptr<expr::Expr> parse_precedence(Precedence min_precedence);
+  shared_ptr<expr::Expr> assigment(shared_ptr<expr::Expr>& target, const Token& equals);
   shared_ptr<expr::Expr> unary();
-  shared_ptr<expr::Expr> call();
   shared_ptr<expr::Expr> primary();
 
-  bool match(const vector<TokenType>& types);
-  bool check(TokenType type) const;
-  bool is_at_end() const;
+  /// What the pre-parser keeps of an expression: whether it may be
+  /// assigned to.
+  enum Shape { SHAPE_VALUE, SHAPE_TARGET };
+
+  // Recognizers of the pre-parse mode, the grammar of the rules above
+  // without building anything. Errors are reported the same way, along
+  // with the ones the Resolver reports in a body.
+  void skim_declaration();
+  void skim_var_declaration();
+  void skim_function(const string& kind);
+  void skim_statement();
+  void skim_block();
+  Shape skim_precedence(Precedence min_precedence);
+  Shape skim_unary();
+  Shape skim_primary();
+  void skim_call();
+  Shape skim_index();
+  void skim_declare(const Token& name);
+  void skim_define(const Token& name);
+
+  bool match(std::initializer_list<TokenType> types);
+  bool check(TokenType type);
+  bool is_at_end();
   const Token& previous() const;
-  const Token& peek() const;
+  const Token& peek();
   const Token& advance();
 
   const Token& consume(TokenType type, const string& msg);
   ParserError error(const Token& token, const string& msg);
 
   shared_ptr<expr::Expr> finish_call(shared_ptr<expr::Expr>& callee);
+  /// Parses `[index]` or `[start:end]` after @object.
+  shared_ptr<expr::Expr> finish_index(shared_ptr<expr::Expr>& object, const Token& bracket);
 
   void sync();
 
@@ -0,0 +1,43 @@
+#include <sstream>
+
+#include "Parser.hpp"
+#include "PreParsedBody.hpp"
+#include "Resolver.hpp"
+#include "TypeInferrer.hpp"
+
+namespace slang {
+
+PreParsedBody::PreParsedBody(vector<Token> tokens,
+                             shared_ptr<ErrorReporter> reporter)
+  : m_tokens(std::move(tokens)),
+    m_reporter(reporter)
+{}
+
+void PreParsedBody::compile(stmt::Fn& fn, Interpreter& interpreter) {
+  // the reports wait until what the script printed before is written
+  std::ostringstream reports;
+  auto reporter = std::make_shared<ErrorReporter>(reports);
+
+  Parser parser(m_tokens, reporter, m_is_break_allowed);
+  auto body = parser.parse_body();
+
+  if (!reporter->has_error()) {
+    fn.m_body = std::move(body);
+
+    Resolver resolver(interpreter, reporter);
+    resolver.resolve_body(fn, *this);
+  }
+
+  if (reporter->has_error()) {
+    fn.m_body.clear();
+    interpreter.output().flush();
+    m_reporter->relay(reports.str());
+    throw RuntimeError(fn.m_name, "Could not compile function '" + 
+                       fn.m_name.m_lexeme + "'.");
+  }
+
+  TypeInferrer inferrer;
+  inferrer.infer(fn);
+}
+
+} // namespace slang
@@ -0,0 +1,52 @@
+#ifndef __SLANG_PRE_PARSED_BODY_HPP__
+#define __SLANG_PRE_PARSED_BODY_HPP__
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ErrorReporter.hpp"
+#include "LazyBody.hpp"
+#include "Token.hpp"
+
+namespace slang {
+
+using std::vector;
+using std::shared_ptr;
+using std::string;
+using std::unordered_map;
+
+/// Function body the Parser only checked for errors, kept as
+/// a copy of its tokens. On the first call it is parsed, resolved in the
+/// scopes the Resolver saw at the declaration and type-inferred on its own.
+class PreParsedBody : public LazyBody {
+public:
+  /// @tokens follow the opening brace, up to the closing one.
+  PreParsedBody(vector<Token> tokens, shared_ptr<ErrorReporter> reporter);
+
+  PreParsedBody(PreParsedBody &&) = default;
+  PreParsedBody(const PreParsedBody &) = default;
+  PreParsedBody &operator=(PreParsedBody &&) = default;
+  PreParsedBody &operator=(const PreParsedBody &) = default;
+  ~PreParsedBody() = default;
+
+  void compile(stmt::Fn& fn, Interpreter& interpreter) override;
+
+  // names the body may assign to, the TypeInferrer must not
+  // track them in the enclosing code
+  vector<string> m_assigned{};
+
+  // Resolver state at the declaration
+  vector<unordered_map<string, bool>> m_scopes{};
+  bool m_is_method{false};
+  bool m_is_break_allowed{false};
+
+private:
+  vector<Token> m_tokens;
+  shared_ptr<ErrorReporter> m_reporter;
+};
+
+} // namespace slang
+
+#endif // !__SLANG_PRE_PARSED_BODY_HPP__
@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <map>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Prefork.hpp"
+
+namespace slang {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+// task:   sequence number, record size, record
+// result: sequence number, ok flag, text size, text
+static constexpr std::size_t TASK_HEADER_SIZE = sizeof(std::uint64_t) + sizeof(std::uint32_t);
+static constexpr std::size_t RESULT_HEADER_SIZE = TASK_HEADER_SIZE + 1;
+
+static void put_u64(std::string& out, std::uint64_t value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void put_u32(std::string& out, std::uint32_t value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+static T get(const char* data) {
+  T value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+/// Writes all of @data to the blocking @fd, returns false on an error.
+static bool write_all(int fd, const std::string& data) {
+  const char* current = data.data();
+  std::size_t size = data.size();
+
+  while (size > 0) {
+    ssize_t written = ::write(fd, current, size);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+
+    current += written;
+    size -= static_cast<std::size_t>(written);
+  }
+
+  return true;
+}
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+Prefork::Prefork(std::shared_ptr<const Script> script)
+  // no background writer, the process must have no threads when it forks
+  : m_isolate(std::make_unique<Isolate>(
+        script, std::make_shared<Output>(STDERR_FILENO, Output::LINE, false)))
+{
+  // fail before forking anything
+  m_isolate->function("handle");
+
+  // the workers only read most of what the top level code set up
+  m_isolate->pin();
+}
+
+bool Prefork::run(std::size_t count, int in_fd, int out_fd) {
+  m_isolate->output().flush();
+
+  std::vector<Worker> workers;
+  if (!start_workers(std::max<std::size_t>(count, 1), workers)) {
+    std::cerr << "Could not start the workers: " << std::strerror(errno) << std::endl;
+    stop_workers(workers, true);
+    return false;
+  }
+
+  // a dead worker shows up as EPIPE instead of killing the parent
+  auto old_sigpipe = std::signal(SIGPIPE, SIG_IGN);
+
+  bool ok = true;
+  bool workers_alive = true;
+  bool input_open = true;
+  std::string input;
+  std::size_t input_start = 0;
+  std::uint64_t next_task = 0;
+  std::uint64_t next_result = 0;
+  std::map<std::uint64_t, std::string> results;
+  std::string output;
+  std::vector<pollfd> fds;
+
+  while (workers_alive) {
+    // hand out every complete record, the last one may lack a newline
+    for (;;) {
+      auto worker = std::min_element(workers.begin(), workers.end(),
+          [](const Worker& lhs, const Worker& rhs) { return lhs.m_in_flight < rhs.m_in_flight; });
+      if (worker->m_in_flight >= MAX_IN_FLIGHT) break;
+
+      std::size_t end = input.find('\n', input_start);
+      if (end == std::string::npos) {
+        if (input_open || input_start == input.size()) break;
+        end = input.size();
+      }
+
+      std::size_t size = end - input_start;
+      helpers::put_u64(worker->m_pending, next_task++);
+      helpers::put_u32(worker->m_pending, static_cast<std::uint32_t>(size));
+      worker->m_pending.append(input, input_start, size);
+      ++worker->m_in_flight;
+
+      input_start = std::min(end + 1, input.size());
+    }
+    input.erase(0, input_start);
+    input_start = 0;
+
+    bool busy = std::any_of(workers.begin(), workers.end(),
+        [](const Worker& worker) { return worker.m_in_flight > 0; });
+    if (!input_open && input.empty() && !busy) break;
+
+    fds.clear();
+    bool room = std::any_of(workers.begin(), workers.end(),
+        [](const Worker& worker) { return worker.m_in_flight < MAX_IN_FLIGHT; });
+    if (input_open && room) {
+      fds.push_back({in_fd, POLLIN, 0});
+    }
+    for (auto& worker : workers) {
+      fds.push_back({worker.m_results, POLLIN, 0});
+      if (!worker.m_pending.empty()) {
+        fds.push_back({worker.m_tasks, POLLOUT, 0});
+      }
+    }
+
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) continue;
+      ok = workers_alive = false;
+      break;
+    }
+
+    for (auto& fd : fds) {
+      if (fd.revents == 0) continue;
+
+      if (fd.fd == in_fd) {
+        char chunk[64 * 1024];
+        ssize_t size = ::read(in_fd, chunk, sizeof(chunk));
+        if (size > 0) {
+          input.append(chunk, size);
+        } else if (size == 0 || errno != EINTR) {
+          input_open = false;
+        }
+        continue;
+      }
+
+      auto worker = std::find_if(workers.begin(), workers.end(), [&fd](const Worker& worker) {
+        return worker.m_tasks == fd.fd || worker.m_results == fd.fd;
+      });
+
+      if (fd.fd == worker->m_tasks) {
+        ssize_t written = ::write(worker->m_tasks, worker->m_pending.data(), worker->m_pending.size());
+        if (written > 0) {
+          worker->m_pending.erase(0, written);
+        } else if (written < 0 && errno != EAGAIN && errno != EINTR) {
+          workers_alive = false;
+        }
+        continue;
+      }
+
+      char chunk[64 * 1024];
+      ssize_t size = ::read(worker->m_results, chunk, sizeof(chunk));
+      if (size == 0 || (size < 0 && errno != EAGAIN && errno != EINTR)) {
+        workers_alive = false;
+        continue;
+      }
+      if (size < 0) continue;
+
+      std::string& received = worker->m_received;
+      received.append(chunk, size);
+
+      std::size_t start = 0;
+      while (received.size() - start >= helpers::RESULT_HEADER_SIZE) {
+        const char* header = received.data() + start;
+        auto seq = helpers::get<std::uint64_t>(header);
+        bool succeeded = header[sizeof(std::uint64_t)] != 0;
+        auto text_size = helpers::get<std::uint32_t>(header + sizeof(std::uint64_t) + 1);
+        if (received.size() - start - helpers::RESULT_HEADER_SIZE < text_size) break;
+
+        std::string text = received.substr(start + helpers::RESULT_HEADER_SIZE, text_size);
+        if (!succeeded) {
+          std::cerr << "Record " << seq + 1 << ": " << text << std::endl;
+          text.clear();
+          ok = false;
+        }
+
+        results.emplace(seq, std::move(text));
+        --worker->m_in_flight;
+        start += helpers::RESULT_HEADER_SIZE + text_size;
+      }
+      received.erase(0, start);
+    }
+
+    // results leave in the order the records came in
+    for (auto found = results.find(next_result); found != results.end();
+         found = results.find(next_result)) {
+      output += found->second;
+      output.push_back('\n');
+      results.erase(found);
+      ++next_result;
+    }
+
+    if (output.size() >= Output::BUFFER_SIZE) {
+      helpers::write_all(out_fd, output);
+      output.clear();
+    }
+  }
+
+  helpers::write_all(out_fd, output);
+
+  if (!workers_alive) {
+    std::cerr << "A worker exited before finishing its records." << std::endl;
+    ok = false;
+  }
+
+  stop_workers(workers, !workers_alive);
+  std::signal(SIGPIPE, old_sigpipe);
+  return ok;
+}
+
+// ------------------------ | PRIVATE |
+bool Prefork::start_workers(std::size_t count, std::vector<Worker>& workers) {
+  workers.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i) {
+    int tasks[2];
+    int results[2];
+    if (pipe(tasks) != 0) return false;
+    if (pipe(results) != 0) {
+      close(tasks[0]);
+      close(tasks[1]);
+      return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+      for (int fd : {tasks[0], tasks[1], results[0], results[1]}) {
+        close(fd);
+      }
+      return false;
+    }
+
+    if (pid == 0) {
+      // the parent's ends, a worker holding them would keep
+      // the other workers from ever seeing the end of their tasks
+      for (auto& worker : workers) {
+        close(worker.m_tasks);
+        close(worker.m_results);
+      }
+      close(tasks[1]);
+      close(results[0]);
+      work(tasks[0], results[1]);
+    }
+
+    close(tasks[0]);
+    close(results[1]);
+    fcntl(tasks[1], F_SETFL, fcntl(tasks[1], F_GETFL) | O_NONBLOCK);
+    fcntl(results[0], F_SETFL, fcntl(results[0], F_GETFL) | O_NONBLOCK);
+    workers.push_back(Worker{pid, tasks[1], results[0]});
+  }
+
+  return true;
+}
+
+void Prefork::stop_workers(std::vector<Worker>& workers, bool kill_them) {
+  for (auto& worker : workers) {
+    // the end of its tasks makes a worker exit
+    close(worker.m_tasks);
+    close(worker.m_results);
+    if (kill_them) {
+      kill(worker.m_pid, SIGTERM);
+    }
+  }
+
+  for (auto& worker : workers) {
+    while (waitpid(worker.m_pid, nullptr, 0) < 0 && errno == EINTR) {}
+  }
+
+  workers.clear();
+}
+
+void Prefork::work(int tasks, int results) {
+  Function handle = m_isolate->function("handle");
+  std::string received;
+  std::string done;
+
+  for (;;) {
+    std::size_t start = 0;
+    while (received.size() - start >= helpers::TASK_HEADER_SIZE) {
+      const char* header = received.data() + start;
+      auto seq = helpers::get<std::uint64_t>(header);
+      auto size = helpers::get<std::uint32_t>(header + sizeof(std::uint64_t));
+      if (received.size() - start - helpers::TASK_HEADER_SIZE < size) break;
+
+      std::string record = received.substr(start + helpers::TASK_HEADER_SIZE, size);
+      start += helpers::TASK_HEADER_SIZE + size;
+
+      std::string text;
+      bool succeeded = true;
+      try {
+        text = object_to_string(handle(std::move(record)));
+      } catch (const ScriptError& e) {
+        text = e.what();
+        succeeded = false;
+      }
+
+      helpers::put_u64(done, seq);
+      done.push_back(succeeded ? 1 : 0);
+      helpers::put_u32(done, static_cast<std::uint32_t>(text.size()));
+      done += text;
+    }
+    received.erase(0, start);
+
+    // about to wait for more, hand over what is done
+    m_isolate->output().flush();
+    if (!helpers::write_all(results, done)) break;
+    done.clear();
+
+    char chunk[64 * 1024];
+    ssize_t size = ::read(tasks, chunk, sizeof(chunk));
+    if (size < 0 && errno == EINTR) continue;
+    if (size <= 0) break;
+    received.append(chunk, size);
+  }
+
+  // freeing the heap would only copy its pages, the parent owns it
+  m_isolate->output().flush();
+  _exit(0);
+}
+
+} // namespace slang
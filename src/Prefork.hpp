@@ -0,0 +1,66 @@
+#ifndef __SLANG_PREFORK_HPP__
+#define __SLANG_PREFORK_HPP__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "Program.hpp"
+
+namespace slang {
+
+/// Batch mode of `slang --workers N`: the top level code of a script runs
+/// once, then N forked workers inherit the initialized heap copy-on-write,
+/// so a worker only copies the pages it writes to. The heap is pinned
+/// first, so reading an object in a worker does not write its reference
+/// count, see HeapPin.
+///
+/// Every line of the input is a record handed to the global function
+/// `handle` of the script, and what it returns is written as one line of
+/// the output, in the order of the input. The script prints to the
+/// standard error, since the output carries the results.
+class Prefork {
+public:
+  /// Runs the top level code of @script, throws ScriptError.
+  explicit Prefork(std::shared_ptr<const Script> script);
+
+  Prefork(Prefork &&) = delete;
+  Prefork(const Prefork &) = delete;
+  Prefork &operator=(Prefork &&) = delete;
+  Prefork &operator=(const Prefork &) = delete;
+  ~Prefork() = default;
+
+  /// Forks @workers workers and runs every record of @in_fd through them,
+  /// writing the results to @out_fd. Returns false if a record failed,
+  /// its result line is then empty, or if a worker died.
+  bool run(std::size_t workers, int in_fd, int out_fd);
+
+private:
+  /// Parent side of the pipes to a worker.
+  struct Worker {
+    pid_t m_pid;
+    int m_tasks;
+    int m_results;
+    std::string m_pending{};   // tasks not yet written to m_tasks
+    std::string m_received{};  // results not yet complete
+    std::size_t m_in_flight{0};
+  };
+
+  // records a worker may have queued before it gets no more
+  static constexpr std::size_t MAX_IN_FLIGHT = 1024;
+
+  std::unique_ptr<Isolate> m_isolate;
+
+  bool start_workers(std::size_t count, std::vector<Worker>& workers);
+  void stop_workers(std::vector<Worker>& workers, bool kill_them);
+
+  /// Main loop of a worker, never returns.
+  [[noreturn]] void work(int tasks, int results);
+};
+
+} // namespace slang
+
+#endif // !__SLANG_PREFORK_HPP__
@@ -0,0 +1,286 @@
+#include <cstdio>
+#include <fstream>
+
+#include <unistd.h>
+
+#include "HeapPin.hpp"
+#include "ICallable.hpp"
+#include "MappedFile.hpp"
+#include "ModuleLoader.hpp"
+#include "Parser.hpp"
+#include "Program.hpp"
+#include "Resolver.hpp"
+#include "Runtime.hpp"
+#include "Scanner.hpp"
+#include "SourceFile.hpp"
+#include "TypeInferrer.hpp"
+
+namespace slang {
+
+// ------------------------ | PUBLIC |
+std::shared_ptr<const Script> Script::compile(std::string_view src) {
+  return compile(src, "");
+}
+
+std::shared_ptr<const Script> Script::compile_file(const char* path) {
+  SourceFile file;
+  if (!file.open(path)) {
+    throw ScriptError("Could not open '" + std::string(path) + "'.");
+  }
+
+  if (file.is_mapped()) {
+    return compile(file.text(), path);
+  }
+
+  std::string src(std::istreambuf_iterator<char>(file.stream()),
+                  std::istreambuf_iterator<char>{});
+  return compile(src, path);
+}
+
+Isolate::Isolate(std::shared_ptr<const Script> script, std::shared_ptr<Output> output)
+  : Isolate(script, output, true)
+{}
+
+std::unique_ptr<Isolate> Isolate::from_image(const char* path,
+                                             std::shared_ptr<Output> output) {
+  MappedFile file;
+  if (!file.open(path)) {
+    throw ScriptError("Could not open '" + std::string(path) + "'.");
+  }
+
+  std::shared_ptr<Script> script(new Script());
+  std::unique_ptr<Isolate> isolate(new Isolate(script, output, false));
+
+  try {
+    HeapReader reader(file.data(), file.size());
+    script->m_statements = reader.read_program(isolate->m_interpreter);
+
+    isolate->m_heap = std::make_unique<LoadedHeap>();
+    reader.read_heap(*isolate->m_interpreter.get_global_environment(), *isolate->m_heap);
+  } catch (const CorruptImage&) {
+    throw ScriptError("'" + std::string(path) + "' is not a valid image.");
+  }
+
+  return isolate;
+}
+
+void Isolate::save_image(const char* path) {
+  // the writer only reads the statements
+  auto statements = m_script->m_statements;
+
+  std::string image;
+  try {
+    HeapWriter writer(m_interpreter);
+    writer.write(statements, *m_interpreter.get_global_environment(), image);
+  } catch (const std::runtime_error& e) {
+    throw ScriptError(e.what());
+  }
+
+  // processes starting from the image must never see a half written one
+  std::string tmp_path = std::string(path) + ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    out.write(image.data(), image.size());
+    if (!out) {
+      out.close();
+      std::remove(tmp_path.c_str());
+      throw ScriptError("Could not write '" + std::string(path) + "'.");
+    }
+  }
+
+  if (0 != std::rename(tmp_path.c_str(), path)) {
+    std::remove(tmp_path.c_str());
+    throw ScriptError("Could not write '" + std::string(path) + "'.");
+  }
+}
+
+Object Isolate::global(const std::string& name) const {
+  const Object* value = m_interpreter.get_global_environment()->find(name);
+  if (value == nullptr) {
+    throw ScriptError("Undefined variable '" + name + "'.");
+  }
+
+  return *value;
+}
+
+Function Isolate::function(const std::string& name) {
+  Object callee = global(name);
+  if (!std::holds_alternative<std::shared_ptr<ICallable>>(callee)
+      && !std::holds_alternative<ICallable*>(callee)) {
+    throw ScriptError("'" + name + "' is not a function.");
+  }
+
+  return Function(*this, callee);
+}
+
+void Isolate::snapshot() {
+  m_journal = std::make_unique<Journal>();
+  m_journal->track(*m_interpreter.get_global_environment());
+}
+
+void Isolate::pin() {
+  HeapPin pin;
+  pin.pin(*m_interpreter.get_global_environment());
+}
+
+void Isolate::reset() {
+  if (!m_journal) {
+    throw ScriptError("The isolate has no snapshot to reset to.");
+  }
+
+  m_journal->restore();
+  m_interpreter.output().flush();
+  m_reports.str("");
+  m_reporter->discard_error_state();
+}
+
+Object Function::call(std::vector<Object> args) const {
+  auto callee = std::get_if<std::shared_ptr<ICallable>>(&m_callee);
+  ICallable* fn = callee ? callee->get() : std::get<ICallable*>(m_callee);
+
+  if (args.size() != fn->arity()) {
+    throw ScriptError("Expected " + std::to_string(fn->arity())
+                      + " arguments, but got " + std::to_string(args.size()) + ".");
+  }
+
+  try {
+    return fn->call(m_isolate->m_interpreter, args);
+  } catch (const RuntimeError& e) {
+    m_isolate->m_reporter->runtime_error(e);
+    m_isolate->fail();
+  } catch (const NativeError& e) {
+    // a native called straight from C++, there is no call to report it at
+    throw ScriptError(e.what());
+  }
+}
+
+std::size_t Function::arity() const {
+  auto callee = std::get_if<std::shared_ptr<ICallable>>(&m_callee);
+  return callee ? callee->get()->arity() : std::get<ICallable*>(m_callee)->arity();
+}
+
+IsolatePool::IsolatePool(std::shared_ptr<const Script> script, std::size_t size) {
+  m_isolates.reserve(size);
+  m_free.reserve(size);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    m_isolates.push_back(std::make_unique<Isolate>(script));
+    m_isolates.back()->snapshot();
+    m_free.push_back(m_isolates.back().get());
+  }
+}
+
+IsolatePool::Lease IsolatePool::acquire() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cond.wait(lock, [this]() { return !m_free.empty(); });
+
+  Isolate* isolate = m_free.back();
+  m_free.pop_back();
+  return Lease(*this, isolate);
+}
+
+IsolatePool::Lease::Lease(Lease &&other) noexcept
+  : m_pool(other.m_pool),
+    m_isolate(other.m_isolate)
+{
+  other.m_isolate = nullptr;
+}
+
+IsolatePool::Lease::~Lease() {
+  if (m_isolate != nullptr) {
+    m_pool->release(m_isolate);
+  }
+}
+
+Program::Program(std::string_view src, std::shared_ptr<Output> output)
+  : Program(Script::compile(src), output)
+{}
+
+std::unique_ptr<Program> Program::from_file(const char* path,
+                                            std::shared_ptr<Output> output) {
+  return std::unique_ptr<Program>(new Program(Script::compile_file(path), output));
+}
+
+// ------------------------ | PRIVATE |
+std::shared_ptr<const Script> Script::compile(std::string_view src, const std::string& path) {
+  std::ostringstream reports;
+  auto reporter = std::make_shared<ErrorReporter>(reports);
+  auto fail = [&reports]() {
+    std::string report = reports.str();
+    if (!report.empty() && report.back() == '\n') {
+      report.pop_back();
+    }
+
+    throw ScriptError(report);
+  };
+
+  std::shared_ptr<Script> script(new Script());
+
+  Scanner scanner(src, reporter);
+  Parser parser(scanner, reporter);
+  script->m_statements = parser.parse();
+  if (reporter->has_error()) fail();
+
+  // only resolves into the script, never runs anything
+  Interpreter interpreter(reporter, nullptr, script->m_resolution);
+  Resolver resolver(interpreter, reporter);
+  resolver.resolve(script->m_statements);
+  if (reporter->has_error()) fail();
+
+  ModuleLoader modules(reporter);
+  if (!modules.load(path, script->m_statements, *script->m_resolution)) fail();
+
+  TypeInferrer inferrer;
+  inferrer.infer(script->m_statements);
+
+  return script;
+}
+
+Function::Function(Isolate& isolate, Object callee)
+  : m_isolate(&isolate),
+    m_callee(std::move(callee))
+{}
+
+Isolate::Isolate(std::shared_ptr<const Script> script, std::shared_ptr<Output> output, bool run)
+  : m_script(script),
+    m_reporter(std::make_shared<ErrorReporter>(m_reports)),
+    m_interpreter(m_reporter, output, script->m_resolution)
+{
+  if (run) {
+    m_interpreter.interpret(script->m_statements);
+    if (m_reporter->has_runtime_error()) fail();
+  }
+}
+
+void Isolate::fail() {
+  std::string reports = m_reports.str();
+  if (!reports.empty() && reports.back() == '\n') {
+    reports.pop_back();
+  }
+
+  m_reports.str("");
+  m_reporter->discard_error_state();
+  throw ScriptError(reports);
+}
+
+IsolatePool::Lease::Lease(IsolatePool& pool, Isolate* isolate)
+  : m_pool(&pool),
+    m_isolate(isolate)
+{}
+
+void IsolatePool::release(Isolate* isolate) {
+  // resets on the returning thread, so acquire() hands out ready isolates
+  isolate->reset();
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free.push_back(isolate);
+  }
+  m_cond.notify_one();
+}
+
+Program::Program(std::shared_ptr<const Script> script, std::shared_ptr<Output> output)
+  : Isolate(script, output)
+{}
+
+} // namespace slang
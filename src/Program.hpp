@@ -0,0 +1,277 @@
+#ifndef __SLANG_PROGRAM_HPP__
+#define __SLANG_PROGRAM_HPP__
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "ErrorReporter.hpp"
+#include "HeapImage.hpp"
+#include "Interpreter.hpp"
+#include "Journal.hpp"
+#include "Object.hpp"
+#include "Output.hpp"
+#include "Stmt.hpp"
+
+namespace slang {
+
+/// Compile or runtime error of a script run through the embedding API,
+/// the message is the report the command line would print.
+class ScriptError : public std::runtime_error {
+public:
+  explicit ScriptError(const std::string& report) : std::runtime_error(report) {}
+
+  ScriptError(ScriptError &&) = default;
+  ScriptError(const ScriptError &) = default;
+  ScriptError &operator=(ScriptError &&) = default;
+  ScriptError &operator=(const ScriptError &) = default;
+  ~ScriptError() = default;
+};
+
+/// Compiled code of a script: the resolved and type-inferred statements.
+/// Nothing changes it once compiled, so any number of Isolates share it
+/// and run it on different threads at the same time.
+class Script {
+public:
+  /// Compiles @src and the modules it imports, which are looked up
+  /// relative to the working directory, throws ScriptError. Function
+  /// bodies are always parsed up front, since a lazily parsed one
+  /// changes on its first call.
+  static std::shared_ptr<const Script> compile(std::string_view src);
+
+  /// Compiles the script at @path, its imports are looked up next to it,
+  /// see compile().
+  static std::shared_ptr<const Script> compile_file(const char* path);
+
+  Script(Script &&) = delete;
+  Script(const Script &) = delete;
+  Script &operator=(Script &&) = delete;
+  Script &operator=(const Script &) = delete;
+  ~Script() = default;
+
+private:
+  friend class Isolate;
+
+  Script() = default;
+
+  static std::shared_ptr<const Script> compile(std::string_view src, const std::string& path);
+
+  std::vector<std::shared_ptr<stmt::Stmt>> m_statements{};
+  std::shared_ptr<Resolution> m_resolution{std::make_shared<Resolution>()};
+};
+
+class Isolate;
+
+/// A global function or class of an Isolate, called from C++.
+class Function {
+public:
+  Function(Function &&) = default;
+  Function(const Function &) = default;
+  Function &operator=(Function &&) = default;
+  Function &operator=(const Function &) = default;
+  ~Function() = default;
+
+  /// Calls the function with @args, throws ScriptError.
+  Object call(std::vector<Object> args) const;
+
+  /// Calls the function with @args, each converted to an Object. String
+  /// literals and views are passed as strings.
+  template <typename... Args>
+  Object operator()(Args&&... args) const {
+    return call(std::vector<Object>{to_object(std::forward<Args>(args))...});
+  }
+
+  std::size_t arity() const;
+
+private:
+  friend class Isolate;
+
+  Function(Isolate& isolate, Object callee);
+
+  template <typename T>
+  static Object to_object(T&& value) {
+    using Arg = std::decay_t<T>;
+
+    // strings of C++ are not alternatives of Object
+    if constexpr (std::is_same_v<Arg, const char*> || std::is_same_v<Arg, char*>
+                  || std::is_same_v<Arg, std::string_view>) {
+      return SlangString(std::string_view(value));
+    } else {
+      return Object(std::forward<T>(value));
+    }
+  }
+
+  Isolate* m_isolate;
+  Object m_callee;
+};
+
+/// One running instance of a Script, with its own globals, objects,
+/// error reporter and output. Isolates share nothing that changes, so
+/// each can run on its own thread without any locking. An isolate itself,
+/// and the objects and functions it returns, belong to one thread at a time.
+class Isolate {
+public:
+  /// Runs the top level code of @script, which defines the globals.
+  /// Prints to @output, by default one of its own to where the
+  /// process wide Output writes. Throws ScriptError.
+  explicit Isolate(std::shared_ptr<const Script> script,
+                   std::shared_ptr<Output> output = Output::separate());
+
+  /// Starts from an image written by save_image(), mapping the file and
+  /// rebuilding the script and its globals without running any of its
+  /// top level code. Throws ScriptError.
+  static std::unique_ptr<Isolate> from_image(const char* path,
+                                             std::shared_ptr<Output> output = Output::separate());
+
+  // functions refer to the isolate
+  Isolate(Isolate &&) = delete;
+  Isolate(const Isolate &) = delete;
+  Isolate &operator=(Isolate &&) = delete;
+  Isolate &operator=(const Isolate &) = delete;
+  ~Isolate() = default;
+
+  bool has_global(const std::string& name) const {
+    return m_interpreter.get_global_environment()->find(name) != nullptr;
+  }
+
+  /// Value of the global variable @name, throws ScriptError if there is none.
+  Object global(const std::string& name) const;
+
+  /// The global function or class @name, throws ScriptError if there is none.
+  Function function(const std::string& name);
+
+  Output& output() { return m_interpreter.output(); }
+
+  /// Takes the globals, and every object, function and class reachable
+  /// from them, as the state reset() goes back to. Usually called once,
+  /// right after the top level code set everything up.
+  void snapshot();
+
+  /// Undoes every write to the state of the snapshot made since the
+  /// snapshot or the last reset. Takes time proportional to the number of
+  /// objects written, not to the size of the state. Objects created since
+  /// the snapshot are dropped. Throws ScriptError if there is no snapshot.
+  void reset();
+
+  /// Pins the globals, and every object, function and class reachable
+  /// from them, see HeapPin. For processes forked from this one, which
+  /// then copy fewer pages of the heap they inherit. Pinned objects are
+  /// never freed.
+  void pin();
+
+  /// Writes the script and the current globals, with every object,
+  /// function and class reachable from them, to the image file @path.
+  /// Throws ScriptError.
+  void save_image(const char* path);
+
+  /// Number of objects the next reset() restores.
+  std::size_t dirty() const { return m_journal ? m_journal->dirty() : 0; }
+
+private:
+  friend class Function;
+
+  std::shared_ptr<const Script> m_script;
+  std::ostringstream m_reports{};
+  std::shared_ptr<ErrorReporter> m_reporter;
+  // objects of the image the isolate started from, outlive the globals
+  std::unique_ptr<LoadedHeap> m_heap{};
+  Interpreter m_interpreter;
+  // refers to the interpreter's objects, so it goes first
+  std::unique_ptr<Journal> m_journal{};
+
+  /// Runs the top level code of @script only if @run.
+  Isolate(std::shared_ptr<const Script> script, std::shared_ptr<Output> output, bool run);
+
+  /// Throws the reports written since the last error as a ScriptError.
+  [[noreturn]] void fail();
+};
+
+/// A fixed number of Isolates of one Script, set up in advance, for
+/// running the script once per request without re-running its top level
+/// code. Every isolate is returned reset to the state right after its
+/// top level code ran, so each request sees fresh globals.
+///
+///   slang::IsolatePool pool(slang::Script::compile_file("handler.slang"), 8);
+///   // on any thread
+///   auto isolate = pool.acquire();
+///   isolate->function("handle")(request);
+class IsolatePool {
+public:
+  /// An isolate lent out by the pool, reset and given back on destruction.
+  class Lease {
+  public:
+    Lease(Lease &&other) noexcept;
+    Lease(const Lease &) = delete;
+    Lease &operator=(Lease &&) = delete;
+    Lease &operator=(const Lease &) = delete;
+    ~Lease();
+
+    Isolate& operator*() const { return *m_isolate; }
+    Isolate* operator->() const { return m_isolate; }
+
+  private:
+    friend class IsolatePool;
+
+    Lease(IsolatePool& pool, Isolate* isolate);
+
+    IsolatePool* m_pool;
+    Isolate* m_isolate;
+  };
+
+  /// Runs the top level code of @script in @size isolates, each printing
+  /// to an Output::separate(). Throws ScriptError.
+  IsolatePool(std::shared_ptr<const Script> script, std::size_t size);
+
+  // leases refer to the pool
+  IsolatePool(IsolatePool &&) = delete;
+  IsolatePool(const IsolatePool &) = delete;
+  IsolatePool &operator=(IsolatePool &&) = delete;
+  IsolatePool &operator=(const IsolatePool &) = delete;
+  ~IsolatePool() = default;
+
+  /// Lends out a free isolate, waits for one if all are lent out.
+  /// Safe to call from any thread.
+  Lease acquire();
+
+  std::size_t size() const { return m_isolates.size(); }
+
+private:
+  std::vector<std::unique_ptr<Isolate>> m_isolates{};
+  std::mutex m_mutex{};
+  std::condition_variable m_cond{};
+  std::vector<Isolate*> m_free{};
+
+  void release(Isolate* isolate);
+};
+
+/// Embedding API of libslang for a single thread: a script compiled once,
+/// whose global functions are then called any number of times without
+/// scanning, parsing or resolving anything again.
+///
+///   slang::Program program("fn add(a, b) => a + b;");
+///   auto add = program.function("add");
+///   slang::Object sum = add(1, 2);
+class Program : public Isolate {
+public:
+  /// Compiles @src and runs its top level code, printing to @output.
+  /// Throws ScriptError.
+  explicit Program(std::string_view src,
+                   std::shared_ptr<Output> output = Output::standard());
+
+  /// Compiles the script at @path, see Program().
+  static std::unique_ptr<Program> from_file(const char* path,
+                                            std::shared_ptr<Output> output = Output::standard());
+
+private:
+  Program(std::shared_ptr<const Script> script, std::shared_ptr<Output> output);
+};
+
+} // namespace slang
+
+#endif // !__SLANG_PROGRAM_HPP__
@@ -31,6 +31,13 @@ void Resolver::visitFnStmt(stmt::Fn &stmt) {
   resolve_function(stmt, FN_FUNCTION);
 }
 
+void Resolver::visitImportStmt(stmt::Import &stmt) {
+  // a module defines globals, there is nowhere to put them in a scope
+  if (!m_scopes.empty()) {
+    m_reporter->error(stmt.m_keyword, "Can only import at the top level.");
+  }
+}
+
 void Resolver::visitExpressionStmt(stmt::Expression &stmt) {
   resolve(*stmt.m_expression);
 }
@@ -54,6 +61,12 @@ void Resolver::visitReturnStmt(stmt::Return &stmt) {
 
   if (stmt.m_value != nullptr) {
     resolve(*stmt.m_value);
+
+    // `return f(...)` leaves nothing to do in the caller's frame
+    if (m_current_fn != FN_NONE
+        && dynamic_cast<expr::Call*>(stmt.m_value.get()) != nullptr) {
+      m_interpreter.mark_tail_call(stmt);
+    }
   }
 }
 
@@ -143,14 +156,51 @@ void Resolver::visitSetExpr(expr::Set &expr) {
   resolve(*expr.m_object);
 }
 
+void Resolver::visitListExpr(expr::List &expr) {
+  for (auto& element : expr.m_elements) {
+    resolve(*element);
+  }
+}
+
+void Resolver::visitMapExpr(expr::Map &expr) {
+  for (std::size_t i = 0; i < expr.m_keys.size(); ++i) {
+    resolve(*expr.m_keys[i]);
+    resolve(*expr.m_values[i]);
+  }
+}
+
+void Resolver::visitIndexExpr(expr::Index &expr) {
+  resolve(*expr.m_object);
+  resolve(*expr.m_index);
+}
+
+void Resolver::visitSetIndexExpr(expr::SetIndex &expr) {
+  resolve(*expr.m_object);
+  resolve(*expr.m_index);
+  resolve(*expr.m_value);
+}
+
+void Resolver::visitSliceExpr(expr::Slice &expr) {
+  resolve(*expr.m_object);
+  if (expr.m_start != nullptr) resolve(*expr.m_start);
+  if (expr.m_end != nullptr) resolve(*expr.m_end);
+}
+
 
-// ------------------------ | PRIVATE |
 void Resolver::resolve(vector<shared_ptr<stmt::Stmt>>& statements) {
   for (auto& s : statements) {
     resolve(*s);
   }
 }
 
+void Resolver::resolve_body(stmt::Fn& fn, PreParsedBody& lazy_body) {
+  m_scopes = lazy_body.m_scopes;
+  m_is_break_allowed = lazy_body.m_is_break_allowed;
+  resolve_function(fn, lazy_body.m_is_method ? FN_METHOD : FN_FUNCTION);
+}
+
+// ------------------------ | PRIVATE |
+
 void Resolver::resolve(stmt::Stmt& stmt) {
   stmt.accept(*this);
 }
@@ -169,6 +219,14 @@ void Resolver::resolve_local(expr::Expr& expr, const Token& name) {
 }
 
 void Resolver::resolve_function(stmt::Fn& fn, FnType fn_type) {
+  if (auto lazy_body = dynamic_cast<PreParsedBody*>(fn.m_lazy_body.get())) {
+    // the body is resolved when it is parsed, on the first call
+    lazy_body->m_scopes = m_scopes;
+    lazy_body->m_is_method = fn_type == FN_METHOD;
+    lazy_body->m_is_break_allowed = m_is_break_allowed;
+    return;
+  }
+
   FnType enclosing_fn = m_current_fn;
   m_current_fn = fn_type;
 
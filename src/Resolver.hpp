@@ -7,6 +7,7 @@
 #include "Expr.hpp"
 #include "Stmt.hpp"
 #include "Interpreter.hpp"
+#include "PreParsedBody.hpp"
 
 namespace slang {
 
@@ -26,6 +27,7 @@ public:
   void visitBlockStmt(stmt::Block &stmt) override;
   void visitVarStmt(stmt::Var &stmt) override;
   void visitFnStmt(stmt::Fn &stmt) override;
+  void visitImportStmt(stmt::Import &stmt) override;
   void visitExpressionStmt(stmt::Expression &stmt) override;
   void visitIfStmt(stmt::If &stmt) override;
   void visitPrintStmt(stmt::Print &stmt) override;
@@ -44,9 +46,18 @@ public:
   void visitUnaryExpr(expr::Unary &expr) override;
   void visitGetExpr(expr::Get &expr) override;
   void visitSetExpr(expr::Set &expr) override;
+  void visitMapExpr(expr::Map &expr) override;
+  void visitListExpr(expr::List &expr) override;
+  void visitIndexExpr(expr::Index &expr) override;
+  void visitSetIndexExpr(expr::SetIndex &expr) override;
+  void visitSliceExpr(expr::Slice &expr) override;
 
   void resolve(vector<shared_ptr<stmt::Stmt>>& statements);
 
+  /// Resolves the freshly parsed body of @fn in the scopes @lazy_body
+  /// saved at the declaration of the function.
+  void resolve_body(stmt::Fn& fn, PreParsedBody& lazy_body);
+
 private:
   enum FnType {
     FN_NONE, FN_FUNCTION, FN_METHOD
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "ICallable.hpp"
+#include "InterpreterExceptions.hpp"
+#include "Number.hpp"
+#include "Runtime.hpp"
+#include "SlangArray.hpp"
+#include "SlangInstance.hpp"
+#include "SlangList.hpp"
+#include "SlangMap.hpp"
+
+namespace slang {
+
+namespace runtime {
+
+// ------------------------ | HELPERS |
+static void check_number_operand(const Token& operator_,
+                                 const Object& operand) {
+  if (is_number(operand)) return;
+
+  throw RuntimeError(operator_, "Operand must be a number.");
+}
+
+static void check_number_operands(const Token& operator_,
+                                 const Object& left,
+                                 const Object& right) {
+  if (is_number(left) && is_number(right)) return;
+
+  throw RuntimeError(operator_, "Operands must be numbers.");
+}
+
+static void check_key(const Token& token, const Object& key) {
+  if (SlangMap::is_key(key)) return;
+
+  throw RuntimeError(token, "Map keys can not be NaN.");
+}
+
+/// Integer value of the string index @index, throws RuntimeError at @bracket
+/// for anything else.
+static std::int64_t string_index(const Token& bracket, const Object& index) {
+  if (auto pint = std::get_if<std::int64_t>(&index)) {
+    return *pint;
+  }
+
+  if (auto pdouble = std::get_if<double>(&index)) {
+    if (std::trunc(*pdouble) == *pdouble && std::fabs(*pdouble) < 9.2e18) {
+      return static_cast<std::int64_t>(*pdouble);
+    }
+  }
+
+  throw RuntimeError(bracket, "String index must be an integer.");
+}
+
+/// Byte at @index of @str, as a string of one byte.
+static SlangString string_at(const SlangString& str, const Object& index,
+                             const Token& bracket) {
+  auto size = static_cast<std::int64_t>(str.size());
+  std::int64_t at = string_index(bracket, index);
+  if (at < 0) at += size;
+
+  if (at < 0 || at >= size) {
+    throw RuntimeError(bracket, "String index out of range.");
+  }
+
+  return str.slice(at, at + 1);
+}
+
+/// Bytes of @str from @start up to @end, clamped to the string and
+/// sharing its buffer.
+static SlangString string_slice(const SlangString& str, const Object& start,
+                                const Object& end, const Token& bracket) {
+  auto size = static_cast<std::int64_t>(str.size());
+  auto bound = [&](const Object& value, std::int64_t otherwise) {
+    if (std::holds_alternative<std::nullptr_t>(value)) return otherwise;
+
+    std::int64_t at = string_index(bracket, value);
+    if (at < 0) at += size;
+    return std::clamp<std::int64_t>(at, 0, size);
+  };
+
+  return str.slice(bound(start, 0), bound(end, size));
+}
+
+// ------------------------ | PUBLIC |
+bool is_truthy(const Object& obj) {
+  if (std::holds_alternative<std::nullptr_t>(obj)
+      || (std::holds_alternative<double>(obj) && std::get<double>(obj) == 0)
+      || (std::holds_alternative<std::int64_t>(obj) && std::get<std::int64_t>(obj) == 0)) {
+    return false;
+  }
+
+  if (std::holds_alternative<bool>(obj)) {
+    return std::get<bool>(obj);
+  }
+
+  return true;
+}
+
+bool is_equal(const Object& left, const Object& right) {
+  // 1 == 1.0
+  if (is_number(left) && is_number(right)) {
+    return compare(EQ_EQ, Number::from_object(left), Number::from_object(right));
+  }
+
+  return left == right;
+}
+
+Object unary(const Token& oper, const Object& right) {
+  switch (oper.m_type) {
+    case MINUS:
+      check_number_operand(oper, right);
+      return negate(Number::from_object(right)).to_object();
+    case BANG:
+      return !is_truthy(right);
+    default:
+      return nullptr;
+  }
+}
+
+Object binary(const Token& oper, const Object& left, const Object& right) {
+  switch (oper.m_type) {
+    case GREATER:
+    case GREATER_EQ:
+    case LESS:
+    case LESS_EQ:
+    case SLASH:
+    case STAR:
+    case MINUS:
+      check_number_operands(oper, left, right);
+      return number_operation(oper.m_type,
+                              Number::from_object(left),
+                              Number::from_object(right));
+
+    case BANG_EQ:
+      return !is_equal(left, right);
+    case EQ_EQ:
+      return is_equal(left, right);
+
+    case PLUS:
+      if (is_number(left) && is_number(right)) {
+        return number_operation(PLUS,
+                                Number::from_object(left),
+                                Number::from_object(right));
+      } else if (std::holds_alternative<SlangString>(left) && std::holds_alternative<SlangString>(right)) {
+        return SlangString::concat(std::get<SlangString>(left), std::get<SlangString>(right));
+      }
+      throw RuntimeError(oper, "Operands must be two numbers or two strings.");
+
+    default:
+      return nullptr;
+  }
+}
+
+ICallable* as_callable(const Object& callee, const Token& paren) {
+  if (auto *f = std::get_if<std::shared_ptr<ICallable>>(&callee)) {
+    return f->get();
+  } else if (ICallable * const *f = std::get_if<ICallable*>(&callee)) {
+    return *f;
+  }
+
+  throw RuntimeError(paren, "Can only call functions.");
+}
+
+void check_arity(ICallable& fn, std::size_t argc, const Token& paren) {
+  if (argc != fn.arity()) {
+    throw RuntimeError(paren, "Expected " + 
+                       std::to_string(fn.arity()) + " arguments, but got " + 
+                       std::to_string(argc) + ".");
+  }
+}
+
+Object call(ICallable& fn, Interpreter& interpreter,
+            std::vector<Object>& args, const Token& paren) {
+  try {
+    return fn.call(interpreter, args);
+  } catch (const NativeError& e) {
+    throw RuntimeError(paren, e.what());
+  }
+}
+
+Object get_property(const Object& obj, const Token& name) {
+  if (auto pobj = std::get_if<std::shared_ptr<SlangInstance>>(&obj)) {
+    return pobj->get()->get_property(name);
+  }
+
+  throw RuntimeError(name, "Only instances have properties.");
+}
+
+SlangInstance* as_instance(const Object& obj, const Token& name) {
+  if (auto pobj = std::get_if<std::shared_ptr<SlangInstance>>(&obj)) {
+    return pobj->get();
+  }
+
+  throw RuntimeError(name, "Only instances have fields.");
+}
+
+Object make_list(std::vector<Object> items) {
+  return std::make_shared<SlangList>(std::move(items));
+}
+
+Object make_map(const std::vector<Object>& keys, const std::vector<Object>& values,
+                const Token& brace) {
+  auto map = std::make_shared<SlangMap>();
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    check_key(brace, keys[i]);
+    map->set(keys[i], values[i]);
+  }
+
+  return map;
+}
+
+Object get_index(const Object& obj, const Object& index, const Token& bracket) {
+  if (auto list = std::get_if<std::shared_ptr<SlangList>>(&obj)) {
+    return (*list)->get(bracket, index);
+  } else if (auto map = std::get_if<std::shared_ptr<SlangMap>>(&obj)) {
+    check_key(bracket, index);
+    return (*map)->get(index);
+  } else if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&obj)) {
+    return (*array)->get(bracket, index);
+  } else if (auto str = std::get_if<SlangString>(&obj)) {
+    return string_at(*str, index, bracket);
+  }
+
+  throw RuntimeError(bracket, "Only lists, maps, arrays and strings can be indexed.");
+}
+
+void set_index(const Object& obj, const Object& index,
+               const Object& value, const Token& bracket) {
+  if (auto list = std::get_if<std::shared_ptr<SlangList>>(&obj)) {
+    (*list)->set(bracket, index, value);
+    return;
+  } else if (auto map = std::get_if<std::shared_ptr<SlangMap>>(&obj)) {
+    check_key(bracket, index);
+    (*map)->set(index, value);
+    return;
+  } else if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&obj)) {
+    (*array)->set(bracket, index, value);
+    return;
+  } else if (std::holds_alternative<SlangString>(obj)) {
+    throw RuntimeError(bracket, "Strings can not be changed.");
+  }
+
+  throw RuntimeError(bracket, "Only lists, maps and arrays can be indexed.");
+}
+
+Object slice(const Object& obj, const Object& start,
+             const Object& end, const Token& bracket) {
+  if (auto list = std::get_if<std::shared_ptr<SlangList>>(&obj)) {
+    return (*list)->slice(bracket, start, end);
+  } else if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&obj)) {
+    return (*array)->slice(bracket, start, end);
+  } else if (auto str = std::get_if<SlangString>(&obj)) {
+    return string_slice(*str, start, end, bracket);
+  }
+
+  throw RuntimeError(bracket, "Only lists, arrays and strings can be sliced.");
+}
+
+} // namespace runtime
+
+} // namespace slang
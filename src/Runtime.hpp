@@ -0,0 +1,62 @@
+#ifndef __SLANG_RUNTIME_HPP__
+#define __SLANG_RUNTIME_HPP__
+
+#include <cstddef>
+#include <vector>
+
+#include "Object.hpp"
+#include "Token.hpp"
+
+namespace slang {
+
+class ICallable;
+class Interpreter;
+class SlangInstance;
+
+/// Dynamic semantics shared by the Interpreter and by the C++ emitted
+/// with `slang --emit-cpp`, so both report the same results and errors.
+namespace runtime {
+
+bool is_truthy(const Object& obj);
+bool is_equal(const Object& left, const Object& right);
+
+/// Applies unary operator @oper to @right, checking the operand type.
+Object unary(const Token& oper, const Object& right);
+
+/// Applies binary operator @oper to @left and @right,
+/// checking the operand types.
+Object binary(const Token& oper, const Object& left, const Object& right);
+
+ICallable* as_callable(const Object& callee, const Token& paren);
+void check_arity(ICallable& fn, std::size_t argc, const Token& paren);
+
+/// Calls @fn, reporting a NativeError of a native function at @paren.
+Object call(ICallable& fn, Interpreter& interpreter,
+            std::vector<Object>& args, const Token& paren);
+
+Object get_property(const Object& obj, const Token& name);
+
+/// Returns the instance whose field @name is about to be set.
+SlangInstance* as_instance(const Object& obj, const Token& name);
+
+Object make_list(std::vector<Object> items);
+
+/// Map of @keys to @values, the key of an entry is at the same index
+/// as its value. Errors are reported at @brace.
+Object make_map(const std::vector<Object>& keys, const std::vector<Object>& values,
+                const Token& brace);
+
+/// `obj[index]`, errors are reported at @bracket.
+Object get_index(const Object& obj, const Object& index, const Token& bracket);
+void set_index(const Object& obj, const Object& index,
+               const Object& value, const Token& bracket);
+
+/// `obj[start:end]`, a missing bound is none.
+Object slice(const Object& obj, const Object& start,
+             const Object& end, const Token& bracket);
+
+} // namespace runtime
+
+} // namespace slang
+
+#endif // !__SLANG_RUNTIME_HPP__
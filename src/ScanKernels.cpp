@@ -0,0 +1,258 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ScanKernels.hpp"
+
+namespace slang {
+
+namespace scan {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+enum Kind { IDENTIFIER, DIGITS, WHITESPACE, LINE, STRING };
+
+static bool is_digit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+static bool is_identifier(char c) {
+  return (c >= 'a' && c <= 'z') ||
+         (c >= 'A' && c <= 'Z') ||
+         is_digit(c) || c == '_';
+}
+
+#if defined(__SSE2__)
+/// Bytes of @v in ['@lo', '@hi'], for ASCII bounds only.
+static __m128i in_range(__m128i v, char lo, char hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)),
+                       _mm_cmplt_epi8(v, _mm_set1_epi8(hi + 1)));
+}
+
+static __m128i equals(__m128i v, char c) {
+  return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+}
+
+/// Mask of the bytes of @v that end a run of @kind.
+template <Kind kind>
+static std::uint32_t stop_mask(__m128i v) {
+  __m128i run;
+
+  if (kind == IDENTIFIER) {
+    __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    run = _mm_or_si128(_mm_or_si128(in_range(lower, 'a', 'z'), in_range(v, '0', '9')),
+                       equals(v, '_'));
+  } else if (kind == DIGITS) {
+    run = in_range(v, '0', '9');
+  } else if (kind == WHITESPACE) {
+    run = _mm_or_si128(_mm_or_si128(equals(v, ' '), equals(v, '\t')),
+                       _mm_or_si128(equals(v, '\r'), equals(v, '\n')));
+  } else if (kind == LINE) {
+    return _mm_movemask_epi8(equals(v, '\n'));
+  } else {
+    return _mm_movemask_epi8(equals(v, '"'));
+  }
+
+  return ~_mm_movemask_epi8(run) & 0xFFFF;
+}
+
+/// Skips blocks of 16 bytes up to the one that ends the run of @kind,
+/// counting newlines if @lines is given.
+template <Kind kind>
+static const char* run_end(const char*& p, const char* end, std::size_t* lines) {
+  for (; end - p >= 16; p += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    std::uint32_t stop = stop_mask<kind>(v);
+    std::uint32_t newlines = lines ? _mm_movemask_epi8(equals(v, '\n')) : 0;
+
+    if (stop != 0) {
+      unsigned i = __builtin_ctz(stop);
+      if (lines) *lines += __builtin_popcount(newlines & ((1u << i) - 1));
+      return p + i;
+    }
+
+    if (lines) *lines += __builtin_popcount(newlines);
+  }
+
+  return nullptr;
+}
+#endif
+
+} // namespace helpers
+
+// ------------------------ | SCALAR |
+namespace scalar {
+
+const char* identifier_end(const char* begin, const char* end) {
+  while (begin != end && helpers::is_identifier(*begin)) ++begin;
+  return begin;
+}
+
+const char* digits_end(const char* begin, const char* end) {
+  while (begin != end && helpers::is_digit(*begin)) ++begin;
+  return begin;
+}
+
+const char* whitespace_end(const char* begin, const char* end, std::size_t& lines) {
+  for (; begin != end; ++begin) {
+    char c = *begin;
+    if (c == '\n') {
+      ++lines;
+    } else if (c != ' ' && c != '\t' && c != '\r') {
+      break;
+    }
+  }
+
+  return begin;
+}
+
+const char* line_end(const char* begin, const char* end) {
+  while (begin != end && *begin != '\n') ++begin;
+  return begin;
+}
+
+const char* string_end(const char* begin, const char* end, std::size_t& lines) {
+  for (; begin != end && *begin != '"'; ++begin) {
+    lines += *begin == '\n';
+  }
+
+  return begin;
+}
+
+} // namespace scalar
+
+// ------------------------ | SSE2 |
+#if defined(__SSE2__)
+namespace sse2 {
+
+using namespace helpers;
+
+static const char* identifier_end(const char* begin, const char* end) {
+  const char* stop = run_end<IDENTIFIER>(begin, end, nullptr);
+  return stop ? stop : scalar::identifier_end(begin, end);
+}
+
+static const char* digits_end(const char* begin, const char* end) {
+  const char* stop = run_end<DIGITS>(begin, end, nullptr);
+  return stop ? stop : scalar::digits_end(begin, end);
+}
+
+static const char* whitespace_end(const char* begin, const char* end, std::size_t& lines) {
+  const char* stop = run_end<WHITESPACE>(begin, end, &lines);
+  return stop ? stop : scalar::whitespace_end(begin, end, lines);
+}
+
+static const char* line_end(const char* begin, const char* end) {
+  const char* stop = run_end<LINE>(begin, end, nullptr);
+  return stop ? stop : scalar::line_end(begin, end);
+}
+
+static const char* string_end(const char* begin, const char* end, std::size_t& lines) {
+  const char* stop = run_end<STRING>(begin, end, &lines);
+  return stop ? stop : scalar::string_end(begin, end, lines);
+}
+
+} // namespace sse2
+#endif
+
+// ------------------------ | DISPATCH |
+namespace helpers {
+
+struct Kernels {
+  const char* m_name;
+  const char* (*m_identifier_end)(const char*, const char*);
+  const char* (*m_digits_end)(const char*, const char*);
+  const char* (*m_whitespace_end)(const char*, const char*, std::size_t&);
+  const char* (*m_line_end)(const char*, const char*);
+  const char* (*m_string_end)(const char*, const char*, std::size_t&);
+};
+
+static const Kernels SCALAR = {
+  "scalar", scalar::identifier_end, scalar::digits_end,
+  scalar::whitespace_end, scalar::line_end, scalar::string_end
+};
+
+/// Picks the widest kernels the CPU runs, unless SLANG_SCAN_KERNELS
+/// asks for narrower ones ("sse2" or "scalar") to compare them.
+static Kernels select_kernels() {
+  const char* requested = std::getenv("SLANG_SCAN_KERNELS");
+  std::string_view name = requested != nullptr ? requested : "";
+
+  if (name == "scalar") return SCALAR;
+
+#ifdef SLANG_HAVE_AVX2
+  // runs from a static initializer
+  __builtin_cpu_init();
+  if (name != "sse2" && __builtin_cpu_supports("avx2")) {
+    return { "avx2", avx2::identifier_end, avx2::digits_end,
+             avx2::whitespace_end, avx2::line_end, avx2::string_end };
+  }
+#endif
+
+#if defined(__SSE2__)
+  return { "sse2", sse2::identifier_end, sse2::digits_end,
+           sse2::whitespace_end, sse2::line_end, sse2::string_end };
+#else
+  return SCALAR;
+#endif
+}
+
+static const Kernels s_kernels = select_kernels();
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+// Most identifiers, numbers and gaps between tokens are only a few bytes
+// long, the first bytes are checked in place before paying for a vector
+// search.
+static constexpr std::ptrdiff_t SHORT_RUN = 8;
+
+static const char* short_end(const char* begin, const char* end) {
+  return end - begin > SHORT_RUN ? begin + SHORT_RUN : end;
+}
+
+const char* identifier_end(const char* begin, const char* end) {
+  const char* limit = short_end(begin, end);
+  const char* stop = scalar::identifier_end(begin, limit);
+  return stop != limit || stop == end
+    ? stop : helpers::s_kernels.m_identifier_end(stop, end);
+}
+
+const char* digits_end(const char* begin, const char* end) {
+  const char* limit = short_end(begin, end);
+  const char* stop = scalar::digits_end(begin, limit);
+  return stop != limit || stop == end
+    ? stop : helpers::s_kernels.m_digits_end(stop, end);
+}
+
+const char* whitespace_end(const char* begin, const char* end, std::size_t& lines) {
+  const char* limit = short_end(begin, end);
+  const char* stop = scalar::whitespace_end(begin, limit, lines);
+  return stop != limit || stop == end
+    ? stop : helpers::s_kernels.m_whitespace_end(stop, end, lines);
+}
+
+const char* line_end(const char* begin, const char* end) {
+  return helpers::s_kernels.m_line_end(begin, end);
+}
+
+const char* string_end(const char* begin, const char* end, std::size_t& lines) {
+  const char* limit = short_end(begin, end);
+  const char* stop = scalar::string_end(begin, limit, lines);
+  return stop != limit || stop == end
+    ? stop : helpers::s_kernels.m_string_end(stop, end, lines);
+}
+
+const char* kernel_name() {
+  return helpers::s_kernels.m_name;
+}
+
+} // namespace scan
+
+} // namespace slang
@@ -0,0 +1,61 @@
+#ifndef __SLANG_SCAN_KERNELS_HPP__
+#define __SLANG_SCAN_KERNELS_HPP__
+
+#include <cstddef>
+
+namespace slang {
+
+/// Character-class searches the Scanner runs over the source, 16 bytes
+/// at a time with SSE2 or 32 with AVX2 when the CPU has them, one byte
+/// at a time otherwise. Each returns the first byte in [@begin, @end)
+/// that ends the run, or @end.
+namespace scan {
+
+/// Skips the letters, digits and underscores of an identifier.
+const char* identifier_end(const char* begin, const char* end);
+
+/// Skips decimal digits.
+const char* digits_end(const char* begin, const char* end);
+
+/// Skips spaces, tabs, carriage returns and newlines,
+/// adds the newlines to @lines.
+const char* whitespace_end(const char* begin, const char* end, std::size_t& lines);
+
+/// Finds the newline that ends a comment.
+const char* line_end(const char* begin, const char* end);
+
+/// Finds the closing quote of a string, adds the newlines before it to @lines.
+const char* string_end(const char* begin, const char* end, std::size_t& lines);
+
+/// Instruction set the searches use: "avx2", "sse2" or "scalar".
+const char* kernel_name();
+
+/// Byte at a time versions, also used for the tails shorter than a block.
+namespace scalar {
+
+const char* identifier_end(const char* begin, const char* end);
+const char* digits_end(const char* begin, const char* end);
+const char* whitespace_end(const char* begin, const char* end, std::size_t& lines);
+const char* line_end(const char* begin, const char* end);
+const char* string_end(const char* begin, const char* end, std::size_t& lines);
+
+} // namespace scalar
+
+#ifdef SLANG_HAVE_AVX2
+/// Built with -mavx2, only called when the CPU supports it.
+namespace avx2 {
+
+const char* identifier_end(const char* begin, const char* end);
+const char* digits_end(const char* begin, const char* end);
+const char* whitespace_end(const char* begin, const char* end, std::size_t& lines);
+const char* line_end(const char* begin, const char* end);
+const char* string_end(const char* begin, const char* end, std::size_t& lines);
+
+} // namespace avx2
+#endif
+
+} // namespace scan
+
+} // namespace slang
+
+#endif // !__SLANG_SCAN_KERNELS_HPP__
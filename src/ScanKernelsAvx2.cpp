@@ -0,0 +1,110 @@
+#include <cstdint>
+
+#include <immintrin.h>
+
+#include "ScanKernels.hpp"
+
+namespace slang {
+
+namespace scan {
+
+namespace avx2 {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+enum Kind { IDENTIFIER, DIGITS, WHITESPACE, LINE, STRING };
+
+/// Bytes of @v in ['@lo', '@hi'], for ASCII bounds only.
+static __m256i in_range(__m256i v, char lo, char hi) {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(lo - 1)),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), v));
+}
+
+static __m256i equals(__m256i v, char c) {
+  return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c));
+}
+
+static std::uint32_t movemask(__m256i v) {
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(v));
+}
+
+/// Mask of the bytes of @v that end a run of @kind.
+template <Kind kind>
+static std::uint32_t stop_mask(__m256i v) {
+  __m256i run;
+
+  if (kind == IDENTIFIER) {
+    __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+    run = _mm256_or_si256(_mm256_or_si256(in_range(lower, 'a', 'z'), in_range(v, '0', '9')),
+                          equals(v, '_'));
+  } else if (kind == DIGITS) {
+    run = in_range(v, '0', '9');
+  } else if (kind == WHITESPACE) {
+    run = _mm256_or_si256(_mm256_or_si256(equals(v, ' '), equals(v, '\t')),
+                          _mm256_or_si256(equals(v, '\r'), equals(v, '\n')));
+  } else if (kind == LINE) {
+    return movemask(equals(v, '\n'));
+  } else {
+    return movemask(equals(v, '"'));
+  }
+
+  return ~movemask(run);
+}
+
+/// Skips blocks of 32 bytes up to the one that ends the run of @kind,
+/// counting newlines if @lines is given.
+template <Kind kind>
+static const char* run_end(const char*& p, const char* end, std::size_t* lines) {
+  for (; end - p >= 32; p += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    std::uint32_t stop = stop_mask<kind>(v);
+    std::uint32_t newlines = lines ? movemask(equals(v, '\n')) : 0;
+
+    if (stop != 0) {
+      unsigned i = __builtin_ctz(stop);
+      if (lines) *lines += __builtin_popcount(newlines & ((1u << i) - 1));
+      return p + i;
+    }
+
+    if (lines) *lines += __builtin_popcount(newlines);
+  }
+
+  return nullptr;
+}
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+using namespace helpers;
+
+const char* identifier_end(const char* begin, const char* end) {
+  const char* stop = run_end<IDENTIFIER>(begin, end, nullptr);
+  return stop ? stop : scalar::identifier_end(begin, end);
+}
+
+const char* digits_end(const char* begin, const char* end) {
+  const char* stop = run_end<DIGITS>(begin, end, nullptr);
+  return stop ? stop : scalar::digits_end(begin, end);
+}
+
+const char* whitespace_end(const char* begin, const char* end, std::size_t& lines) {
+  const char* stop = run_end<WHITESPACE>(begin, end, &lines);
+  return stop ? stop : scalar::whitespace_end(begin, end, lines);
+}
+
+const char* line_end(const char* begin, const char* end) {
+  const char* stop = run_end<LINE>(begin, end, nullptr);
+  return stop ? stop : scalar::line_end(begin, end);
+}
+
+const char* string_end(const char* begin, const char* end, std::size_t& lines) {
+  const char* stop = run_end<STRING>(begin, end, &lines);
+  return stop ? stop : scalar::string_end(begin, end, lines);
+}
+
+} // namespace avx2
+
+} // namespace scan
+
+} // namespace slang
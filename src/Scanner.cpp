@@ -1,11 +1,20 @@
 #include "Scanner.hpp"
-#include <cctype>
-#include <cstdlib>
+#include "ScanKernels.hpp"
+#include <charconv>
+#include <cstdint>
+#include <limits>
 
 namespace slang {
 
-// ------------------------ | INIT STATICS |
-std::unordered_map<std::string, TokenType> Scanner::s_keywords{
+// ------------------------ | HELPERS |
+namespace helpers {
+
+struct Keyword {
+  std::string_view m_text;
+  TokenType m_type;
+};
+
+static constexpr Keyword KEYWORDS[] = {
   { "and",      AND },
   { "base",     BASE },
   { "break",    BREAK },
@@ -15,6 +24,7 @@ std::unordered_map<std::string, TokenType> Scanner::s_keywords{
   { "fn",       FN },
   { "for",      FOR },
   { "if",       IF },
+  { "import",   IMPORT },
   { "let",      LET },
   { "none",     NONE },
   { "or",       OR },
@@ -25,8 +35,97 @@ std::unordered_map<std::string, TokenType> Scanner::s_keywords{
   { "while",    WHILE }
 };
 
-// ------------------------ | HELPERS |
-namespace helpers {
+static constexpr std::size_t KEYWORD_SLOTS = 64;
+static constexpr std::size_t MAX_KEYWORD_SIZE = 6;
+
+/// Perfect hash of the keywords, checked below when the table is built.
+static constexpr std::size_t keyword_hash(std::string_view text) {
+  return (static_cast<unsigned char>(text.front())
+          + 2 * static_cast<unsigned char>(text.back())
+          + 4 * text.size()) % KEYWORD_SLOTS;
+}
+
+struct KeywordTable {
+  Keyword m_slots[KEYWORD_SLOTS]{};
+  bool m_is_perfect{true};
+
+  constexpr KeywordTable() {
+    for (const auto& keyword : KEYWORDS) {
+      auto& slot = m_slots[keyword_hash(keyword.m_text)];
+      m_is_perfect = m_is_perfect && slot.m_text.empty()
+                     && keyword.m_text.size() <= MAX_KEYWORD_SIZE;
+      slot = keyword;
+    }
+  }
+};
+
+static constexpr KeywordTable s_keywords{};
+static_assert(s_keywords.m_is_perfect,
+              "Keywords collide, pick another keyword_hash.");
+
+static TokenType identifier_type(std::string_view text) {
+  if (text.size() < 2 || text.size() > MAX_KEYWORD_SIZE) return IDENTIFIER;
+
+  const auto& slot = s_keywords.m_slots[keyword_hash(text)];
+  return slot.m_text == text ? slot.m_type : IDENTIFIER;
+}
+
+static bool is_digit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+/// Value of the digit @c in radixes up to 16, 16 for other characters.
+static int digit_value(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return 16;
+}
+
+/// Parses the digits of @text skipping '_' separators,
+/// returns false if the value does not fit into 64 bits.
+static bool parse_integer(std::string_view text, int radix, std::int64_t& value) {
+  constexpr std::uint64_t MAX = std::numeric_limits<std::int64_t>::max();
+  std::uint64_t result = 0;
+
+  for (char c : text) {
+    if (c == '_') continue;
+
+    std::uint64_t digit = digit_value(c);
+    if (result > (MAX - digit) / radix) return false;
+    result = result * radix + digit;
+  }
+
+  value = static_cast<std::int64_t>(result);
+  return true;
+}
+
+/// Parses the decimal @text skipping '_' separators, rounded exactly.
+static double parse_double(std::string_view text) {
+  double value = 0;
+
+  if (text.find('_') == std::string_view::npos) {
+    std::from_chars(text.data(), text.data() + text.size(), value);
+    return value;
+  }
+
+  // long literals are rare, only they need the heap
+  char buffer[128];
+  std::string long_digits;
+  char* digits = buffer;
+  if (text.size() > sizeof(buffer)) {
+    long_digits.resize(text.size());
+    digits = &long_digits[0];
+  }
+
+  char* digits_end = digits;
+  for (char c : text) {
+    if (c != '_') *digits_end++ = c;
+  }
+
+  std::from_chars(digits, digits_end, value);
+  return value;
+}
 
 static bool is_alpha(char c) {
   return (c >= 'a' && c <= 'z') ||
@@ -34,34 +133,70 @@ static bool is_alpha(char c) {
          c == '_';
 }
 
-static bool is_alpha_or_digit(char c) {
-  return is_alpha(c) || isdigit(c);
-}
-
 } // namespace helpers
 
 
 // ------------------------ | PUBLIC |
-Scanner::Scanner(const std::string& src, std::shared_ptr<ErrorReporter> reporter)
-    : m_src(src), m_reporter(reporter) 
+Scanner::Scanner(std::string_view src, std::shared_ptr<ErrorReporter> reporter,
+                 std::size_t first_line)
+    : m_src(src), m_reporter(reporter), m_line(first_line)
+{
+}
+
+Scanner::Scanner(std::istream& in, std::shared_ptr<ErrorReporter> reporter)
+    : m_in(&in), m_reporter(reporter)
 {
 }
 
 
 const std::vector<Token>& Scanner::scan_tokens() {
-  while (!is_at_end()) {
+  for (;;) {
+    m_tokens.push_back(next_token());
+    if (m_tokens.back().m_type == END_OF_FILE) break;
+  }
+
+  return m_tokens;
+}
+
+Token Scanner::next_token() {
+  m_has_token = false;
+
+  while (!m_has_token && !is_at_end()) {
     // new lexeme
     m_start = m_current;
     scan_token();
   }
 
-  m_tokens.push_back(Token(END_OF_FILE, "", nullptr, m_line));
-  return m_tokens;
+  if (!m_has_token) {
+    return Token(END_OF_FILE, "", nullptr, m_line);
+  }
+
+  return Token(m_token_type, std::string(m_src.substr(m_start, m_current - m_start)),
+               std::move(m_token_literal), m_line);
 }
 
 
 // ------------------------ | PRIVATE |
-bool Scanner::is_at_end() const { return m_current >= m_src.size(); }
+bool Scanner::is_at_end() {
+  return m_current >= m_src.size() && !fill();
+}
+
+bool Scanner::fill() {
+  if (m_in == nullptr || !*m_in) return false;
+
+  // drop the text of the tokens scanned so far
+  m_buffer.erase(0, m_start);
+  m_current -= m_start;
+  m_start = 0;
+
+  std::size_t size = m_buffer.size();
+  m_buffer.resize(size + CHUNK_SIZE);
+  m_in->read(&m_buffer[size], CHUNK_SIZE);
+  m_buffer.resize(size + m_in->gcount());
+  m_src = m_buffer;
+
+  return m_in->gcount() > 0;
+}
 
 void Scanner::scan_token() {
   char c = advance();
@@ -71,6 +206,9 @@ void Scanner::scan_token() {
     case ')': add_token(RIGHT_PAREN); break;
     case '{': add_token(LEFT_BRACE); break;
     case '}': add_token(RIGHT_BRACE); break;
+    case '[': add_token(LEFT_BRACKET); break;
+    case ']': add_token(RIGHT_BRACKET); break;
+    case ':': add_token(COLON); break;
     case ',': add_token(COMMA); break;
     case '.': add_token(DOT); break;
     case '-': add_token(MINUS); break;
@@ -108,17 +246,14 @@ void Scanner::scan_token() {
     case ' ':
     case '\r':
     case '\t':
-      // ignore whitespace
-      break;
-
     case '\n':
-      ++m_line;
+      skip_whitespace(c);
       break;
 
     case '"': process_string(); break;
 
     default: 
-      if (isdigit(c)) {
+      if (helpers::is_digit(c)) {
         process_number();
       } else if (helpers::is_alpha(c)) {
         process_identifier();
@@ -137,25 +272,34 @@ bool Scanner::match(char expected) {
   return true;
 }
 
-char Scanner::peek() const {
+char Scanner::peek() {
   if (is_at_end()) return '\0';
 
   return m_src[m_current];
 }
 
+void Scanner::skip_whitespace(char first) {
+  m_line += '\n' == first;
+
+  do {
+    const char* begin = m_src.data() + m_current;
+    m_current += scan::whitespace_end(begin, end(), m_line) - begin;
+  } while (m_current == m_src.size() && fill());
+}
+
 void Scanner::skip_comment() {
-  while(peek() != '\n' && !is_at_end()) {
-    advance();
-  }
+  do {
+    const char* begin = m_src.data() + m_current;
+    m_current += scan::line_end(begin, end()) - begin;
+  } while (m_current == m_src.size() && fill());
 }
 
 
 void Scanner::process_string() {
-  char c{};
-  while ((c = peek()) != '"' && !is_at_end()) {
-    m_line += '\n' == c;
-    advance();
-  }
+  do {
+    const char* begin = m_src.data() + m_current;
+    m_current += scan::string_end(begin, end(), m_line) - begin;
+  } while (m_current == m_src.size() && fill());
 
   if (is_at_end()) {
     m_reporter->error(m_line, "Unterminated string.");
@@ -165,50 +309,110 @@ void Scanner::process_string() {
   advance(); // closing "
 
   // trim the surrounding quotes
-  const std::string& literal = m_src.substr(m_start + 1, m_current - m_start - 2);
+  std::string literal(m_src.substr(m_start + 1, m_current - m_start - 2));
   add_token(STRING, literal);
 }
 
 void Scanner::process_number() {
-  while (isdigit(peek())) {
-    advance();
+  // 0x1F and 0b1010 integers
+  int radix = 10;
+  if (m_src[m_start] == '0' && (peek() == 'x' || peek() == 'X')
+      && helpers::digit_value(peek_next()) < 16) {
+    radix = 16;
+  } else if (m_src[m_start] == '0' && (peek() == 'b' || peek() == 'B')
+             && helpers::digit_value(peek_next()) < 2) {
+    radix = 2;
+  }
+
+  if (radix != 10) {
+    advance(); // x or b
+    skip_digits(radix);
+
+    std::int64_t literal = 0;
+    auto digits = m_src.substr(m_start + 2, m_current - m_start - 2);
+    if (!helpers::parse_integer(digits, radix, literal)) {
+      m_reporter->error(m_line, "Number literal does not fit into 64 bits.");
+    }
+
+    add_token(NUMBER, literal);
+    return;
   }
 
+  skip_digits();
+
+  bool is_integer = true;
+
   // fractional part
-  if (peek() == '.' && isdigit(peek_next())) {
+  if (peek() == '.' && helpers::is_digit(peek_next())) {
+    is_integer = false;
     advance(); // .
+    skip_digits();
+  }
 
-    while (isdigit(peek())) {
-      advance();
+  auto text = m_src.substr(m_start, m_current - m_start);
+
+  if (is_integer) {
+    std::int64_t literal = 0;
+
+    // literals that do not fit into 64 bits become doubles
+    if (helpers::parse_integer(text, 10, literal)) {
+      add_token(NUMBER, literal);
+      return;
     }
   }
 
-  double literal = std::strtod(m_src.substr(m_start, m_current - m_start).c_str(), NULL);
-  add_token(NUMBER, literal);
+  add_token(NUMBER, helpers::parse_double(text));
 }
 
 void Scanner::process_identifier() {
-  while (helpers::is_alpha_or_digit(peek())) {
+  do {
+    const char* begin = m_src.data() + m_current;
+    m_current += scan::identifier_end(begin, end()) - begin;
+  } while (m_current == m_src.size() && fill());
+
+  add_token(helpers::identifier_type(m_src.substr(m_start, m_current - m_start)));
+}
+
+void Scanner::skip_digits() {
+  for (;;) {
+    do {
+      const char* begin = m_src.data() + m_current;
+      m_current += scan::digits_end(begin, end()) - begin;
+    } while (m_current == m_src.size() && fill());
+
+    // '_' separates digits, 1_000_000
+    if (peek() != '_' || !helpers::is_digit(peek_next())) break;
     advance();
   }
+}
 
-  const std::string& text = m_src.substr(m_start, m_current - m_start);
-  auto it = s_keywords.find(text);
-  TokenType type = it == s_keywords.end() ? IDENTIFIER : it->second;
-  add_token(type);
+void Scanner::skip_digits(int radix) {
+  for (;;) {
+    if (helpers::digit_value(peek()) < radix) {
+      advance();
+    } else if (peek() == '_' && helpers::digit_value(peek_next()) < radix) {
+      advance();
+    } else {
+      break;
+    }
+  }
 }
 
-char Scanner::peek_next() const {
-  if (m_current + 1 >= m_src.size()) return '\0';
+char Scanner::peek_next() {
+  if (is_at_end()) return '\0';
+  if (m_current + 1 >= m_src.size() && !fill()) return '\0';
 
   return m_src[m_current + 1];
 }
 
 char Scanner::advance() { return m_src[m_current++]; }
 
+const char* Scanner::end() const { return m_src.data() + m_src.size(); }
+
 void Scanner::add_token(TokenType type, Object literal) {
-  std::string lexeme = m_src.substr(m_start, m_current - m_start);
-  m_tokens.push_back(Token(type, lexeme, literal, m_line));
+  m_has_token = true;
+  m_token_type = type;
+  m_token_literal = std::move(literal);
 }
 
 
@@ -1,9 +1,11 @@
 #ifndef __SLANG_SCANNER_HPP__
 #define __SLANG_SCANNER_HPP__
 
+#include <istream>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
 
 #include "Token.hpp"
 #include "ErrorReporter.hpp"
@@ -12,36 +14,60 @@ namespace slang {
 
 class Scanner {
 public:
-  Scanner(const std::string& src, std::shared_ptr<ErrorReporter> reporter);
+  /// Scans @src, which must outlive the scanner. Lines are numbered
+  /// from @first_line, for sources that are part of a larger file.
+  Scanner(std::string_view src, std::shared_ptr<ErrorReporter> reporter,
+          std::size_t first_line = 1);
 
-  Scanner(Scanner &&) = default;
-  Scanner(const Scanner &) = default;
+  /// Reads the source from @in a chunk at a time while scanning, only
+  /// the text of the token being scanned is kept in memory.
+  Scanner(std::istream& in, std::shared_ptr<ErrorReporter> reporter);
+
+  // deleted because m_src may point into m_buffer
+  Scanner(Scanner &&) = delete;
+  Scanner(const Scanner &) = delete;
   Scanner &operator=(Scanner &&) = delete;
   Scanner &operator=(const Scanner &) = delete;
   ~Scanner() = default;
 
   const std::vector<Token>& scan_tokens();
 
+  /// Scans the next token, END_OF_FILE once the source is exhausted.
+  Token next_token();
+
 private:
-  const std::string& m_src;
+  static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+  // the whole source, or the part of the stream read but not scanned yet
+  std::string_view m_src;
+  std::istream* m_in{nullptr};
+  std::string m_buffer{};
   std::shared_ptr<ErrorReporter> m_reporter;
   std::vector<Token> m_tokens{};
+  // the token scanned last, its lexeme is [m_start, m_current)
+  bool m_has_token{false};
+  TokenType m_token_type{END_OF_FILE};
+  Object m_token_literal{nullptr};
   std::size_t m_start = 0;
   std::size_t m_current = 0;
   std::size_t m_line = 1;
 
-  static std::unordered_map<std::string, TokenType> s_keywords;
-
-  bool is_at_end() const;
+  bool is_at_end();
+  bool fill();
   void scan_token();
   bool match(char expected);
-  char peek() const;
-  char peek_next() const;
+  char peek();
+  char peek_next();
+  void skip_whitespace(char first);
   void skip_comment();
+  void skip_digits();
+  /// Skips the digits of a 0x or 0b literal in @radix.
+  void skip_digits(int radix);
   void process_string();
   void process_number();
   void process_identifier();
   char advance();
+  const char* end() const;
   void add_token(TokenType type, Object literal = nullptr);
 
 };
@@ -0,0 +1,153 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <unistd.h>
+
+#include "AstSerializer.hpp"
+#include "MappedFile.hpp"
+#include "ScriptCache.hpp"
+
+namespace slang {
+
+// ------------------------ | HELPERS |
+struct ImageHeader {
+  char m_magic[4];
+  std::uint32_t m_version;
+  std::uint64_t m_src_hash;
+  std::uint64_t m_src_size;
+  // hash of the program after the header, a damaged image is recompiled
+  std::uint64_t m_payload_hash;
+  std::uint64_t m_payload_size;
+};
+
+static const char IMAGE_MAGIC[4] = {'S', 'L', 'G', 'C'};
+
+// ------------------------ | PUBLIC |
+ScriptCache::ScriptCache(const string& script_path, SourceFile& src)
+  : m_hash(0),
+    m_src_size(0),
+    m_enabled(std::getenv("SLANG_NO_CACHE") == nullptr)
+{
+  if (m_enabled && src.is_mapped()) {
+    m_hash = hash(src.text());
+    m_src_size = src.text().size();
+  } else if (m_enabled) {
+    // the script is compiled from the same stream on a cache miss,
+    // pipes can not be read twice
+    std::istream& stream = src.stream();
+    m_enabled = stream.tellg() == 0;
+
+    if (m_enabled) {
+      m_hash = hash(stream, m_src_size);
+      stream.clear();
+      m_enabled = static_cast<bool>(stream.seekg(0));
+    }
+  }
+
+  const char* cache_dir = std::getenv("SLANG_CACHE_DIR");
+  if (cache_dir != nullptr && *cache_dir != '\0') {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.slangc",
+                  static_cast<unsigned long long>(m_hash));
+    m_path = string(cache_dir) + "/" + name;
+  } else {
+    m_path = script_path + "c";
+  }
+}
+
+bool ScriptCache::load(Interpreter& interpreter,
+                       vector<shared_ptr<stmt::Stmt>>& statements) const {
+  if (!m_enabled) return false;
+
+  MappedFile image;
+  if (!image.open(m_path.c_str()) || image.size() < sizeof(ImageHeader)) {
+    return false;
+  }
+
+  ImageHeader header;
+  std::memcpy(&header, image.data(), sizeof(header));
+  if (0 != std::memcmp(header.m_magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC))
+      || header.m_version != VERSION
+      || header.m_src_hash != m_hash
+      || header.m_src_size != m_src_size) {
+    return false;
+  }
+
+  std::string_view payload(image.data() + sizeof(header), image.size() - sizeof(header));
+  if (header.m_payload_size != payload.size() || header.m_payload_hash != hash(payload)) {
+    return false;
+  }
+
+  try {
+    AstReader reader(interpreter, payload.data(), payload.size());
+    statements = reader.read();
+  } catch (const CorruptImage&) {
+    return false;
+  }
+
+  return true;
+}
+
+void ScriptCache::store(Interpreter& interpreter,
+                        vector<shared_ptr<stmt::Stmt>>& statements) const {
+  if (!m_enabled) return;
+
+  ImageHeader header;
+  std::memcpy(header.m_magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+  header.m_version = VERSION;
+  header.m_src_hash = m_hash;
+  header.m_src_size = m_src_size;
+
+  string image(sizeof(header), '\0');
+  AstWriter writer(interpreter);
+  writer.write(statements, image);
+
+  std::string_view payload(image.data() + sizeof(header), image.size() - sizeof(header));
+  header.m_payload_hash = hash(payload);
+  header.m_payload_size = payload.size();
+  std::memcpy(image.data(), &header, sizeof(header));
+
+  // concurrent runs of the same script must never see a half written image
+  string tmp_path = m_path + ".tmp" + std::to_string(getpid());
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out) return;
+
+    out.write(image.data(), image.size());
+    if (!out) {
+      out.close();
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+
+  if (0 != std::rename(tmp_path.c_str(), m_path.c_str())) {
+    std::remove(tmp_path.c_str());
+  }
+}
+
+std::uint64_t ScriptCache::hash(std::string_view src, std::uint64_t hash) {
+  for (unsigned char c : src) {
+    hash ^= c;
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+std::uint64_t ScriptCache::hash(std::istream& src, std::uint64_t& size) {
+  std::uint64_t result = FNV_OFFSET_BASIS;
+  char chunk[64 * 1024];
+  size = 0;
+
+  while (src.read(chunk, sizeof(chunk)) || src.gcount() > 0) {
+    result = hash(std::string_view(chunk, src.gcount()), result);
+    size += src.gcount();
+  }
+
+  return result;
+}
+
+} // namespace slang
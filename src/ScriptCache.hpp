@@ -0,0 +1,70 @@
+#ifndef __SLANG_SCRIPT_CACHE_HPP__
+#define __SLANG_SCRIPT_CACHE_HPP__
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Interpreter.hpp"
+#include "SourceFile.hpp"
+#include "Stmt.hpp"
+
+namespace slang {
+
+using std::vector;
+using std::shared_ptr;
+using std::string;
+
+/// On-disk cache of compiled scripts, lets `slang script.slang` skip
+/// scanning, parsing, resolving and type inference when the script
+/// has not changed since the last run.
+///
+/// The image is written next to the script as `<script>c`, or to
+/// `$SLANG_CACHE_DIR/<source hash>.slangc` when SLANG_CACHE_DIR is set.
+/// It is keyed by a hash of the source and by the image format version,
+/// so stale or foreign images are ignored and overwritten, and carries a
+/// hash of its contents, so truncated or damaged ones are too.
+/// Setting SLANG_NO_CACHE disables the cache.
+class ScriptCache {
+public:
+  /// Hashes the text of @src. A file that is not mapped is read through
+  /// and rewound, the cache is disabled if it can not be rewound.
+  ScriptCache(const string& script_path, SourceFile& src);
+
+  ScriptCache(ScriptCache &&) = default;
+  ScriptCache(const ScriptCache &) = default;
+  ScriptCache &operator=(ScriptCache &&) = default;
+  ScriptCache &operator=(const ScriptCache &) = default;
+  ~ScriptCache() = default;
+
+  /// Loads the compiled script into @statements and registers it with
+  /// @interpreter, returns false if there is no valid image.
+  bool load(Interpreter& interpreter, vector<shared_ptr<stmt::Stmt>>& statements) const;
+
+  /// Saves @statements as resolved for @interpreter, failures only
+  /// cost the next run a recompilation.
+  void store(Interpreter& interpreter, vector<shared_ptr<stmt::Stmt>>& statements) const;
+
+  /// 64-bit FNV-1a hash of @src, continues @hash for text hashed in parts.
+  static std::uint64_t hash(std::string_view src,
+                            std::uint64_t hash = FNV_OFFSET_BASIS);
+
+  /// Hash of what is left of @src, stores its length in @size.
+  static std::uint64_t hash(std::istream& src, std::uint64_t& size);
+
+private:
+  // bump whenever the image layout or the meaning of its contents changes
+  static constexpr std::uint32_t VERSION = 5;
+  static constexpr std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+
+  string m_path;
+  std::uint64_t m_hash;
+  std::uint64_t m_src_size;
+  bool m_enabled;
+};
+
+} // namespace slang
+
+#endif // !__SLANG_SCRIPT_CACHE_HPP__
@@ -1,16 +1,32 @@
 #ifndef __SLANG_SLANG_HPP__
 #define __SLANG_SLANG_HPP__
 
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <thread>
 #include <vector>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "Resolver.hpp"
 #include "Scanner.hpp"
+#include "ScanKernels.hpp"
 #include "Parser.hpp"
+#include "ModuleLoader.hpp"
+#include "ParallelScanner.hpp"
+#include "Prefork.hpp"
+#include "Program.hpp"
 #include "AstPrinter.hpp"
+#include "CppEmitter.hpp"
 #include "Interpreter.hpp"
+#include "ScriptCache.hpp"
+#include "SourceFile.hpp"
+#include "TypeInferrer.hpp"
 
 namespace slang {
 
@@ -23,23 +39,315 @@ public:
   Slang &operator=(const Slang &) = default;
   ~Slang() = default;
 
-  int run_file(const char *path) {
-    if (-1 == read_file(path)) {
+  /// With @lazy_bodies, function bodies are parsed on their first call
+  /// and the script is not cached, since it is only partially compiled.
+  int run_file(const char *path, bool lazy_bodies = false) {
+    SourceFile file;
+    if (!open_script(file, path)) {
+      return 74;
+    }
+
+    ScriptCache cache(path, file);
+    Interpreter interpreter(m_reporter);
+    vector<shared_ptr<stmt::Stmt>> statements;
+
+    if (!cache.load(interpreter, statements)) {
+      TypeInferrer inferrer;
+      if (int code = compile_file(file, interpreter, inferrer, statements, lazy_bodies)) {
+        return code;
+      }
+
+      if (!lazy_bodies) {
+        cache.store(interpreter, statements);
+      }
+    }
+
+    ModuleLoader modules(m_reporter);
+    if (!modules.load(path, statements, *interpreter.resolution())) {
+      return 65;
+    }
+
+    interpreter.interpret(statements);
+
+    return m_reporter->has_runtime_error() * 70;
+  }
+
+  /// Prints which functions of the script the TypeInferrer fully typed,
+  /// without running it.
+  int report_types(const char *path) {
+    SourceFile file;
+    if (!open_script(file, path)) {
+      return 74;
+    }
+
+    Interpreter interpreter(m_reporter);
+    TypeInferrer inferrer;
+    vector<shared_ptr<stmt::Stmt>> statements;
+    if (int code = compile_file(file, interpreter, inferrer, statements)) {
+      return code;
+    }
+
+    inferrer.report(std::cout);
+
+    return 0;
+  }
+
+  /// Translates the script at @path to a C++ program written to @out_path,
+  /// see CppEmitter.
+  int emit_cpp(const char *path, const char *out_path) {
+    SourceFile file;
+    if (!open_script(file, path)) {
+      return 74;
+    }
+
+    Interpreter interpreter(m_reporter);
+    TypeInferrer inferrer;
+    vector<shared_ptr<stmt::Stmt>> statements;
+    if (int code = compile_file(file, interpreter, inferrer, statements)) {
+      return code;
+    }
+
+    // compiled scripts are one file, imports only happen at the top level
+    for (auto& stmt : statements) {
+      if (auto import = dynamic_cast<stmt::Import*>(stmt.get())) {
+        m_reporter->error(import->m_keyword, "Compiled scripts can not import modules.");
+      }
+    }
+    if (m_reporter->has_error()) {
+      return 65;
+    }
+
+    std::ofstream out(out_path);
+    if (!out) {
+      std::cerr << "Could not open '" << out_path << "' for writing." << std::endl;
+      return 74;
+    }
+
+    CppEmitter emitter(interpreter);
+    emitter.emit(statements, path, out);
+
+    return 0;
+  }
+
+  /// Scans the script at @path repeatedly for about a second and prints
+  /// the throughput, the source is mapped into memory up front.
+  int bench_scanner(const char *path) {
+    SourceFile file;
+    if (!file.open(path) || !file.is_mapped()) {
+      std::cerr << "Could not map '" << path << "'." << std::endl;
       return 1;
     }
 
-    return run(m_src);
+    std::string_view src = file.text();
+    unsigned threads = ParallelScanner::threads_from_env();
+
+    using Clock = std::chrono::steady_clock;
+    std::size_t runs = 0;
+    std::size_t tokens = 0;
+    auto start = Clock::now();
+    std::chrono::duration<double> elapsed{};
+
+    do {
+      if (threads > 1) {
+        ParallelScanner scanner(src, m_reporter, threads);
+        for (auto& chunk : scanner.scan_tokens()) {
+          tokens += chunk.size();
+        }
+        --tokens; // END_OF_FILE
+      } else {
+        Scanner scanner(src, m_reporter);
+        while (scanner.next_token().m_type != END_OF_FILE) {
+          ++tokens;
+        }
+      }
+
+      ++runs;
+      elapsed = Clock::now() - start;
+    } while (elapsed.count() < 1.0);
+
+    double mb = static_cast<double>(src.size()) * runs / (1024 * 1024);
+    std::cout << "scanned " << mb << " MB (" << tokens / runs << " tokens x "
+              << runs << ") in " << elapsed.count() << " s: "
+              << mb / elapsed.count() << " MB/s with "
+              << scan::kernel_name() << " kernels on " << threads
+              << " thread(s)" << std::endl;
+
+    return m_reporter->has_error() * 65;
+  }
+
+  /// Runs the script at @path in isolates on 1, 2, 4... threads up to one
+  /// per CPU, or SLANG_BENCH_THREADS, for about a second each, and prints
+  /// how many runs per second each thread count achieves. The script is
+  /// compiled once and its output discarded.
+  int bench_isolates(const char *path) {
+    std::shared_ptr<const Script> script;
+    try {
+      script = Script::compile_file(path);
+    } catch (const ScriptError& e) {
+      std::cerr << e.what() << std::endl;
+      return 65;
+    }
+
+    int devnull = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (devnull < 0) return 74;
+    auto discard = std::make_shared<Output>(devnull, Output::SIZE, false, true);
+
+    unsigned max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    if (const char* threads = std::getenv("SLANG_BENCH_THREADS")) {
+      max_threads = std::max(std::atoi(threads), 1);
+    }
+    double single = 0;
+
+    for (unsigned threads = 1; ; threads = std::min(threads * 2, max_threads)) {
+      using Clock = std::chrono::steady_clock;
+      std::atomic<std::size_t> runs{0};
+      std::atomic<bool> failed{false};
+      auto end = Clock::now() + std::chrono::seconds(1);
+
+      auto worker = [&]() {
+        auto output = std::make_shared<Output>(devnull, Output::SIZE, false);
+        std::size_t own_runs = 0;
+        try {
+          do {
+            Isolate isolate(script, output);
+            ++own_runs;
+          } while (Clock::now() < end);
+        } catch (const ScriptError& e) {
+          if (!failed.exchange(true)) {
+            std::cerr << e.what() << std::endl;
+          }
+        }
+        runs += own_runs;
+      };
+
+      auto start = Clock::now();
+      vector<std::thread> workers;
+      for (unsigned i = 1; i < threads; ++i) {
+        workers.emplace_back(worker);
+      }
+      worker();
+      for (auto& w : workers) {
+        w.join();
+      }
+      std::chrono::duration<double> elapsed = Clock::now() - start;
+
+      if (failed) return 70;
+
+      double per_second = runs / elapsed.count();
+      if (threads == 1) single = per_second;
+      std::cout << threads << " thread(s): " << per_second << " runs/s, "
+                << per_second / single << "x" << std::endl;
+
+      if (threads == max_threads) break;
+    }
+
+    return 0;
   }
 
+  /// Runs the script at @path and saves the state its top level code
+  /// left behind to the image @image_path, see run_image().
+  int save_image(const char *path, const char *image_path) {
+    std::shared_ptr<const Script> script;
+    try {
+      script = Script::compile_file(path);
+    } catch (const ScriptError& e) {
+      std::cerr << e.what() << std::endl;
+      return 65;
+    }
+
+    try {
+      Isolate isolate(script, Output::standard());
+      isolate.save_image(image_path);
+    } catch (const ScriptError& e) {
+      std::cerr << e.what() << std::endl;
+      return 70;
+    }
+
+    return 0;
+  }
+
+  /// Starts from an image written by save_image() without running any top
+  /// level code, then calls the global function `main` if there is one.
+  int run_image(const char *image_path) {
+    try {
+      auto isolate = Isolate::from_image(image_path, Output::standard());
+      if (isolate->has_global("main")) {
+        isolate->function("main")();
+      }
+    } catch (const ScriptError& e) {
+      std::cerr << e.what() << std::endl;
+      return 70;
+    }
+
+    return 0;
+  }
+
+  /// Runs every line of the standard input through the function `handle`
+  /// of the script at @path on @workers forked workers, see Prefork.
+  int run_workers(const char *path, const char *workers) {
+    int count = std::atoi(workers);
+    if (count < 1) {
+      std::cerr << "--workers needs a positive number of workers." << std::endl;
+      return 64;
+    }
+
+    std::shared_ptr<const Script> script;
+    try {
+      script = Script::compile_file(path);
+    } catch (const ScriptError& e) {
+      std::cerr << e.what() << std::endl;
+      return 65;
+    }
+
+    try {
+      Prefork prefork(script);
+      return prefork.run(count, STDIN_FILENO, STDOUT_FILENO) ? 0 : 70;
+    } catch (const ScriptError& e) {
+      std::cerr << e.what() << std::endl;
+      return 70;
+    }
+  }
+
+  /// Runs a script read from the standard input as it arrives, for
+  /// scripts piped from a generator. Such scripts are never cached.
+  int run_stdin() {
+    Interpreter interpreter(m_reporter);
+    TypeInferrer inferrer;
+    vector<shared_ptr<stmt::Stmt>> statements;
+    Scanner scanner(std::cin, m_reporter);
+    if (int code = compile(scanner, interpreter, inferrer, statements)) {
+      return code;
+    }
+
+    ModuleLoader modules(m_reporter);
+    if (!modules.load("", statements, *interpreter.resolution())) {
+      return 65;
+    }
+
+    interpreter.interpret(statements);
+
+    return m_reporter->has_runtime_error() * 70;
+  }
+
+  /// Runs every line in one session, so globals, functions and classes
+  /// defined by a line are there for the following ones.
   int run_promt() {
+    Interpreter interpreter(m_reporter);
+    Resolver resolver(interpreter, m_reporter);
+    TypeInferrer inferrer;
+    // the interpreter refers to the statements of every line run so far
+    vector<shared_ptr<stmt::Stmt>> session;
+
     for (;;) {
-      std::cout << "> ";
+      // the prompt must follow what the previous line printed
+      Output::standard()->flush();
+      std::cout << "> " << std::flush;
       std::string line;
       std::getline(std::cin, line);
 
       if (0 == line.size()) break;
 
-      run(line);
+      run_line(line, interpreter, resolver, inferrer, session);
       m_reporter->discard_error_state();
     }
 
@@ -48,16 +356,85 @@ public:
 
   
 private:
-  std::string m_src;
   std::shared_ptr<ErrorReporter> m_reporter{new ErrorReporter};
 
-  int run(const std::string& src) {
-    Scanner scanner(src, m_reporter);
-    auto tokens = scanner.scan_tokens();
+  /// Opens the script at @path, reports on stderr if it can not be read.
+  bool open_script(SourceFile& file, const char *path) {
+    if (file.open(path)) return true;
+
+    std::cerr << "Could not read script '" << path << "'." << std::endl;
+    return false;
+  }
 
-    Parser parser(tokens, m_reporter);
+  /// Compiles @line against the state of the lines before it and runs it.
+  void run_line(const std::string& line, Interpreter& interpreter,
+                Resolver& resolver, TypeInferrer& inferrer,
+                vector<shared_ptr<stmt::Stmt>>& session) {
+    Scanner scanner(line, m_reporter);
+    Parser parser(scanner, m_reporter);
     auto statements = parser.parse();
 
+    // kept even when the line fails, its expressions may already be
+    // in the side tables of the interpreter
+    session.insert(session.end(), statements.begin(), statements.end());
+
+    if (m_reporter->has_error()) return;
+
+    resolver.resolve(statements);
+    if (m_reporter->has_error()) return;
+
+    ModuleLoader modules(m_reporter);
+    if (!modules.load("", statements, *interpreter.resolution())) return;
+
+    inferrer.infer_continuation(statements);
+    interpreter.interpret(statements);
+
+    if (m_reporter->has_runtime_error()) {
+      inferrer.forget_types();
+    }
+  }
+
+  /// Compiles a script file, scanning a mapped file in place and
+  /// streaming any other. SLANG_SCAN_THREADS asks for parallel scanning,
+  /// which needs the whole source in memory, see ParallelScanner.
+  int compile_file(SourceFile& file, Interpreter& interpreter,
+                   TypeInferrer& inferrer, vector<shared_ptr<stmt::Stmt>>& statements,
+                   bool lazy_bodies = false) {
+    unsigned threads = ParallelScanner::threads_from_env();
+
+    if (threads == 1 && file.is_mapped()) {
+      Scanner scanner(file.text(), m_reporter);
+      Parser parser(scanner, m_reporter, lazy_bodies);
+      return compile(parser, interpreter, inferrer, statements);
+    } else if (threads == 1) {
+      Scanner scanner(file.stream(), m_reporter);
+      Parser parser(scanner, m_reporter, lazy_bodies);
+      return compile(parser, interpreter, inferrer, statements);
+    }
+
+    std::string src;
+    if (!file.is_mapped()) {
+      src.assign(std::istreambuf_iterator<char>(file.stream()), std::istreambuf_iterator<char>());
+    }
+
+    ParallelScanner scanner(file.is_mapped() ? file.text() : src, m_reporter, threads);
+    Parser parser(scanner.scan_tokens(), m_reporter, lazy_bodies);
+    return compile(parser, interpreter, inferrer, statements);
+  }
+
+  int compile(Scanner& scanner, Interpreter& interpreter,
+              TypeInferrer& inferrer, vector<shared_ptr<stmt::Stmt>>& statements) {
+    Parser parser(scanner, m_reporter);
+    return compile(parser, interpreter, inferrer, statements);
+  }
+
+  /// Parses the tokens of @parser, then resolves and type-infers them
+  /// into @statements.
+  /// Returns 0 on success or the exit code of the failed stage.
+  int compile(Parser& parser, Interpreter& interpreter,
+              TypeInferrer& inferrer, vector<shared_ptr<stmt::Stmt>>& statements) {
+    statements = parser.parse();
+
     if (m_reporter->has_error()) {
       return 65;
     }
@@ -65,7 +442,6 @@ private:
     //AstPrinter printer;
     //std::cout << printer.print(statements) << std::endl;
 
-    Interpreter interpreter(m_reporter);
     Resolver resolver(interpreter, m_reporter);
 
     resolver.resolve(statements);
@@ -74,18 +450,8 @@ private:
       return 65;
     }
 
-    interpreter.interpret(statements);
-
-    return m_reporter->has_runtime_error() * 70;
-  }
-
-  int read_file(const char* path) {
-    std::ifstream file(path);
-    if (!file) {
-      return 1;
-    }
+    inferrer.infer(statements);
 
-    m_src = std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
     return 0;
   }
 
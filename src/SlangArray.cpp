@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <cmath>
+
+#include "ArrayKernels.hpp"
+#include "InterpreterExceptions.hpp"
+#include "Number.hpp"
+#include "SlangArray.hpp"
+#include "SlangList.hpp"
+
+namespace slang {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+static const char* const NOT_A_NUMBER = "Array elements must be numbers.";
+static const char* const NOT_AN_INTEGER = "Elements of an int64 array must be integers.";
+
+// 2^63, the first double past the int64 range
+static constexpr double INT64_END = 9223372036854775808.0;
+
+/// Integer value of @value, if it is an integer or an integral double.
+static bool to_integer(const Object& value, std::int64_t& result) {
+  if (auto pint = std::get_if<std::int64_t>(&value)) {
+    result = *pint;
+    return true;
+  }
+
+  if (auto pdouble = std::get_if<double>(&value)) {
+    if (std::trunc(*pdouble) == *pdouble && *pdouble >= -INT64_END && *pdouble < INT64_END) {
+      result = static_cast<std::int64_t>(*pdouble);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/// Slice bound @bound of an array of @size, clamped to the array.
+static std::int64_t slice_bound(const Token& bracket, const Object& bound,
+                                std::int64_t size, std::int64_t otherwise) {
+  if (std::holds_alternative<std::nullptr_t>(bound)) return otherwise;
+
+  std::int64_t value;
+  if (!to_integer(bound, value)) {
+    throw RuntimeError(bracket, "Array index must be an integer.");
+  }
+
+  if (value < 0) value += size;
+  return std::clamp<std::int64_t>(value, 0, size);
+}
+
+static double number_operand(const Object& value) {
+  if (!is_number(value)) {
+    throw NativeError("Operand must be a number.");
+  }
+
+  return Number::from_object(value).as_double();
+}
+
+static std::shared_ptr<SlangArray> filled(std::size_t size, std::int64_t flag) {
+  return std::make_shared<SlangArray>(vector<std::int64_t>(size, flag));
+}
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+SlangArray::SlangArray(ElementType type, std::size_t size) : m_type(type) {
+  if (type == FLOAT64) {
+    m_floats.resize(size);
+  } else {
+    m_ints.resize(size);
+  }
+}
+
+std::shared_ptr<SlangArray> SlangArray::make(ElementType type, const Object& source) {
+  std::int64_t size;
+  if (helpers::to_integer(source, size)) {
+    if (size < 0) {
+      throw NativeError("Array size can not be negative.");
+    }
+
+    return std::make_shared<SlangArray>(type, static_cast<std::size_t>(size));
+  }
+
+  auto list = std::get_if<std::shared_ptr<SlangList>>(&source);
+  if (list == nullptr) {
+    throw NativeError("Can only make an array of a size or of a list.");
+  }
+
+  const vector<Object>& items = (*list)->items();
+  auto array = std::make_shared<SlangArray>(type, items.size());
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    if (!is_number(items[i])) {
+      throw NativeError(helpers::NOT_A_NUMBER);
+    }
+
+    if (type == FLOAT64) {
+      array->m_floats[i] = Number::from_object(items[i]).as_double();
+    } else if (!helpers::to_integer(items[i], array->m_ints[i])) {
+      throw NativeError(helpers::NOT_AN_INTEGER);
+    }
+  }
+
+  return array;
+}
+
+string SlangArray::to_string() const {
+  string result = m_type == FLOAT64 ? "float64[" : "int64[";
+  for (std::size_t i = 0; i < size(); ++i) {
+    if (i != 0) result += ", ";
+    result += m_type == FLOAT64 ? object_to_string(m_floats[i]) : object_to_string(m_ints[i]);
+  }
+  result += "]";
+
+  return result;
+}
+
+Object SlangArray::get(const Token& bracket, const Object& index) const {
+  std::size_t at = position(bracket, index);
+  if (m_type == FLOAT64) return m_floats[at];
+
+  return m_ints[at];
+}
+
+void SlangArray::set(const Token& bracket, const Object& index, const Object& value) {
+  std::size_t at = position(bracket, index);
+  if (!is_number(value)) {
+    throw RuntimeError(bracket, helpers::NOT_A_NUMBER);
+  }
+
+  std::int64_t integer = 0;
+  if (m_type == INT64 && !helpers::to_integer(value, integer)) {
+    throw RuntimeError(bracket, helpers::NOT_AN_INTEGER);
+  }
+
+  before_write();
+  if (m_type == FLOAT64) {
+    m_floats[at] = Number::from_object(value).as_double();
+  } else {
+    m_ints[at] = integer;
+  }
+}
+
+std::shared_ptr<SlangArray> SlangArray::slice(const Token& bracket,
+                                              const Object& start, const Object& end) const {
+  auto count = static_cast<std::int64_t>(size());
+  std::int64_t from = helpers::slice_bound(bracket, start, count, 0);
+  std::int64_t to = std::max(from, helpers::slice_bound(bracket, end, count, count));
+
+  if (m_type == FLOAT64) {
+    return std::make_shared<SlangArray>(
+        vector<double>(m_floats.begin() + from, m_floats.begin() + to));
+  }
+
+  return std::make_shared<SlangArray>(
+      vector<std::int64_t>(m_ints.begin() + from, m_ints.begin() + to));
+}
+
+Object SlangArray::sum() const {
+  if (m_type == INT64) {
+    std::int64_t result;
+    if (bulk::sum_i64(m_ints.data(), m_ints.size(), result)) return result;
+  }
+
+  vector<double> scratch;
+  return bulk::sum_f64(as_floats(scratch), size());
+}
+
+Object SlangArray::min() const {
+  if (size() == 0) {
+    throw NativeError("Can not take the minimum of an empty array.");
+  }
+
+  if (m_type == INT64) return bulk::min_i64(m_ints.data(), m_ints.size());
+
+  return bulk::min_f64(m_floats.data(), m_floats.size());
+}
+
+Object SlangArray::max() const {
+  if (size() == 0) {
+    throw NativeError("Can not take the maximum of an empty array.");
+  }
+
+  if (m_type == INT64) return bulk::max_i64(m_ints.data(), m_ints.size());
+
+  return bulk::max_f64(m_floats.data(), m_floats.size());
+}
+
+Object SlangArray::dot(const SlangArray& other) const {
+  check_same_size(other);
+  if (m_type == INT64 && other.m_type == INT64) {
+    std::int64_t result;
+    if (bulk::dot_i64(m_ints.data(), other.m_ints.data(), size(), result)) return result;
+  }
+
+  vector<double> left_scratch, right_scratch;
+  return bulk::dot_f64(as_floats(left_scratch), other.as_floats(right_scratch), size());
+}
+
+std::shared_ptr<SlangArray> SlangArray::add(const SlangArray& other) const {
+  check_same_size(other);
+  if (m_type == INT64 && other.m_type == INT64) {
+    vector<std::int64_t> out(size());
+    if (bulk::add_i64(m_ints.data(), other.m_ints.data(), out.data(), out.size())) {
+      return std::make_shared<SlangArray>(std::move(out));
+    }
+  }
+
+  vector<double> left_scratch, right_scratch;
+  vector<double> out(size());
+  bulk::add_f64(as_floats(left_scratch), other.as_floats(right_scratch), out.data(), out.size());
+  return std::make_shared<SlangArray>(std::move(out));
+}
+
+std::shared_ptr<SlangArray> SlangArray::mul(const SlangArray& other) const {
+  check_same_size(other);
+  if (m_type == INT64 && other.m_type == INT64) {
+    vector<std::int64_t> out(size());
+    if (bulk::mul_i64(m_ints.data(), other.m_ints.data(), out.data(), out.size())) {
+      return std::make_shared<SlangArray>(std::move(out));
+    }
+  }
+
+  vector<double> left_scratch, right_scratch;
+  vector<double> out(size());
+  bulk::mul_f64(as_floats(left_scratch), other.as_floats(right_scratch), out.data(), out.size());
+  return std::make_shared<SlangArray>(std::move(out));
+}
+
+std::shared_ptr<SlangArray> SlangArray::scale(const Object& factor) const {
+  double float_factor = helpers::number_operand(factor);
+
+  auto int_factor = std::get_if<std::int64_t>(&factor);
+  if (m_type == INT64 && int_factor != nullptr) {
+    vector<std::int64_t> out(size());
+    if (bulk::scale_i64(m_ints.data(), *int_factor, out.data(), out.size())) {
+      return std::make_shared<SlangArray>(std::move(out));
+    }
+  }
+
+  vector<double> scratch;
+  vector<double> out(size());
+  bulk::scale_f64(as_floats(scratch), float_factor, out.data(), out.size());
+  return std::make_shared<SlangArray>(std::move(out));
+}
+
+std::shared_ptr<SlangArray> SlangArray::prefix_sum() const {
+  if (m_type == INT64) {
+    vector<std::int64_t> out(size());
+    if (bulk::prefix_sum_i64(m_ints.data(), out.data(), out.size())) {
+      return std::make_shared<SlangArray>(std::move(out));
+    }
+  }
+
+  vector<double> scratch;
+  vector<double> out(size());
+  bulk::prefix_sum_f64(as_floats(scratch), out.data(), out.size());
+  return std::make_shared<SlangArray>(std::move(out));
+}
+
+std::shared_ptr<SlangArray> SlangArray::greater(const Object& bound) const {
+  double float_bound = helpers::number_operand(bound);
+  vector<std::int64_t> out(size());
+
+  if (m_type == FLOAT64) {
+    bulk::greater_f64(m_floats.data(), float_bound, out.data(), out.size());
+  } else if (auto int_bound = std::get_if<std::int64_t>(&bound)) {
+    bulk::greater_i64(m_ints.data(), *int_bound, out.data(), out.size());
+  } else {
+    // an integer is greater than a double exactly when it is greater than its floor
+    double floor = std::floor(float_bound);
+    if (std::isnan(floor) || floor >= helpers::INT64_END) return helpers::filled(size(), 0);
+    if (floor < -helpers::INT64_END) return helpers::filled(size(), 1);
+
+    bulk::greater_i64(m_ints.data(), static_cast<std::int64_t>(floor), out.data(), out.size());
+  }
+
+  return std::make_shared<SlangArray>(std::move(out));
+}
+
+std::shared_ptr<SlangArray> SlangArray::less(const Object& bound) const {
+  double float_bound = helpers::number_operand(bound);
+  vector<std::int64_t> out(size());
+
+  if (m_type == FLOAT64) {
+    bulk::less_f64(m_floats.data(), float_bound, out.data(), out.size());
+  } else if (auto int_bound = std::get_if<std::int64_t>(&bound)) {
+    bulk::less_i64(m_ints.data(), *int_bound, out.data(), out.size());
+  } else {
+    double ceil = std::ceil(float_bound);
+    if (std::isnan(ceil) || ceil < -helpers::INT64_END) return helpers::filled(size(), 0);
+    if (ceil >= helpers::INT64_END) return helpers::filled(size(), 1);
+
+    bulk::less_i64(m_ints.data(), static_cast<std::int64_t>(ceil), out.data(), out.size());
+  }
+
+  return std::make_shared<SlangArray>(std::move(out));
+}
+
+std::shared_ptr<SlangArray> SlangArray::filter(const SlangArray& mask) const {
+  if (mask.m_type != INT64 || mask.size() != size()) {
+    throw NativeError("Filter mask must be an int64 array of the same length.");
+  }
+
+  // left uninitialized, the pages past the kept elements are never touched
+  if (m_type == FLOAT64) {
+    std::unique_ptr<double[]> out(new double[size()]);
+    std::size_t kept = bulk::filter_f64(m_floats.data(), mask.m_ints.data(), out.get(), size());
+    return std::make_shared<SlangArray>(vector<double>(out.get(), out.get() + kept));
+  }
+
+  std::unique_ptr<std::int64_t[]> out(new std::int64_t[size()]);
+  std::size_t kept = bulk::filter_i64(m_ints.data(), mask.m_ints.data(), out.get(), size());
+  return std::make_shared<SlangArray>(vector<std::int64_t>(out.get(), out.get() + kept));
+}
+
+// ------------------------ | PRIVATE |
+std::size_t SlangArray::position(const Token& bracket, const Object& index) const {
+  std::int64_t at;
+  if (!helpers::to_integer(index, at)) {
+    throw RuntimeError(bracket, "Array index must be an integer.");
+  }
+
+  auto count = static_cast<std::int64_t>(size());
+  if (at < 0) at += count;
+
+  if (at < 0 || at >= count) {
+    throw RuntimeError(bracket, "Array index out of range.");
+  }
+
+  return static_cast<std::size_t>(at);
+}
+
+const double* SlangArray::as_floats(vector<double>& scratch) const {
+  if (m_type == FLOAT64) return m_floats.data();
+
+  scratch.assign(m_ints.begin(), m_ints.end());
+  return scratch.data();
+}
+
+void SlangArray::check_same_size(const SlangArray& other) const {
+  if (size() != other.size()) {
+    throw NativeError("Arrays must have the same length.");
+  }
+}
+
+} // namespace slang
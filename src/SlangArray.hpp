@@ -0,0 +1,105 @@
+#ifndef __SLANG_ARRAY_HPP__
+#define __SLANG_ARRAY_HPP__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Journal.hpp"
+#include "Object.hpp"
+#include "Token.hpp"
+
+namespace slang {
+
+using std::string;
+using std::vector;
+
+/// Array of float64 or int64 numbers, packed in one buffer of raw
+/// doubles or integers instead of Objects.
+///
+/// The bulk operations run over the whole buffer with the kernels of
+/// ArrayKernels.hpp and throw NativeError for bad operands. An int64
+/// result that does not fit in 64 bits is computed in doubles instead,
+/// as integer arithmetic is promoted everywhere else.
+class SlangArray {
+public:
+  enum ElementType : std::uint8_t { FLOAT64, INT64 };
+
+  /// @size zeros of @type.
+  SlangArray(ElementType type, std::size_t size);
+  explicit SlangArray(vector<double> floats)
+    : m_type(FLOAT64), m_floats(std::move(floats)) {}
+  explicit SlangArray(vector<std::int64_t> ints)
+    : m_type(INT64), m_ints(std::move(ints)) {}
+
+  SlangArray(SlangArray &&) = default;
+  SlangArray(const SlangArray &) = default;
+  SlangArray &operator=(SlangArray &&) = default;
+  SlangArray &operator=(const SlangArray &) = default;
+  ~SlangArray() = default;
+
+  /// Array of @type from @source, either a number of zeros or a list of
+  /// numbers. Throws NativeError.
+  static std::shared_ptr<SlangArray> make(ElementType type, const Object& source);
+
+  string to_string() const;
+
+  ElementType type() const { return m_type; }
+  std::size_t size() const { return m_type == FLOAT64 ? m_floats.size() : m_ints.size(); }
+
+  /// Element at @index, negative indexes count from the end.
+  /// Throws RuntimeError at @bracket.
+  Object get(const Token& bracket, const Object& index) const;
+  void set(const Token& bracket, const Object& index, const Object& value);
+
+  /// Copy of the elements from @start up to @end, clamped to the array,
+  /// none standing for either end.
+  std::shared_ptr<SlangArray> slice(const Token& bracket,
+                                    const Object& start, const Object& end) const;
+
+  Object sum() const;
+  Object min() const;
+  Object max() const;
+  Object dot(const SlangArray& other) const;
+
+  /// Elementwise sum and product with an array of the same length.
+  std::shared_ptr<SlangArray> add(const SlangArray& other) const;
+  std::shared_ptr<SlangArray> mul(const SlangArray& other) const;
+  /// Every element times the number @factor.
+  std::shared_ptr<SlangArray> scale(const Object& factor) const;
+  std::shared_ptr<SlangArray> prefix_sum() const;
+
+  /// int64 mask with 1 for the elements greater, or less, than the number @bound.
+  std::shared_ptr<SlangArray> greater(const Object& bound) const;
+  std::shared_ptr<SlangArray> less(const Object& bound) const;
+  /// The elements whose element of the int64 @mask of the same length is not 0.
+  std::shared_ptr<SlangArray> filter(const SlangArray& mask) const;
+
+private:
+  friend class HeapReader;
+  friend class HeapWriter;
+  friend class Journal;
+
+  // only the buffer of m_type is used
+  ElementType m_type;
+  vector<double> m_floats{};
+  vector<std::int64_t> m_ints{};
+  JournalLink m_link{};
+
+  void before_write() {
+    if (m_link.m_journal != nullptr) {
+      m_link.m_journal->save(*this);
+    }
+  }
+
+  std::size_t position(const Token& bracket, const Object& index) const;
+
+  /// The elements as doubles, those of an int64 array converted into @scratch.
+  const double* as_floats(vector<double>& scratch) const;
+  void check_same_size(const SlangArray& other) const;
+};
+
+} // namespace slang
+
+#endif // !__SLANG_ARRAY_HPP__
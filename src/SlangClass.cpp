@@ -4,7 +4,7 @@
 namespace slang {
 
 SlangClass::SlangClass(const string& name,
-                       const std::unordered_map<string, shared_ptr<SlangFn>>& methods)
+                       const std::unordered_map<string, shared_ptr<ICallable>>& methods)
   : m_name(name),
     m_methods(methods)
 {}
@@ -18,12 +18,24 @@ Object SlangClass::call(Interpreter &interpreter, std::vector<Object> &args) {
   return instance;
 }
 
+void SlangClass::track(Journal& journal) {
+  for (auto& [name, method] : m_methods) {
+    journal.track(Object(method));
+  }
+}
+
+void SlangClass::pin(HeapPin& pin) {
+  for (auto& [name, method] : m_methods) {
+    pin.pin(method);
+  }
+}
+
 size_t SlangClass::arity() {
   return 0;
 }
 
 
-optional<shared_ptr<SlangFn>> SlangClass::find_method(const string& name) const {
+optional<shared_ptr<ICallable>> SlangClass::find_method(const string& name) const {
   auto found = m_methods.find(name);
   if (found != m_methods.end()) {
     return found->second;
@@ -17,7 +17,7 @@ using std::optional;
 class SlangClass : public ICallable {
 public:
   SlangClass(const string& name, 
-             const std::unordered_map<string, shared_ptr<SlangFn>>& methods);
+             const std::unordered_map<string, shared_ptr<ICallable>>& methods);
 
   SlangClass(SlangClass &&) = default;
   SlangClass(const SlangClass &) = default;
@@ -29,11 +29,16 @@ public:
   Object call(Interpreter &interpreter, std::vector<Object> &args) override;
   size_t arity() override;
 
-  optional<shared_ptr<SlangFn>> find_method(const string& name) const;
+  void track(Journal& journal) override;
+  void pin(HeapPin& pin) override;
+
+  optional<shared_ptr<ICallable>> find_method(const string& name) const;
 
 private:
+  friend class HeapWriter;
+
   string m_name;
-  std::unordered_map<string, shared_ptr<SlangFn>> m_methods;
+  std::unordered_map<string, shared_ptr<ICallable>> m_methods;
 
 };
 
@@ -4,33 +4,93 @@
 namespace slang {
 
 
-SlangFn::SlangFn(stmt::Fn& declaration, std::unique_ptr<Environment> closure)
+SlangFn::SlangFn(stmt::Fn& declaration, std::unique_ptr<Environment> closure,
+                 Environment* globals)
   : m_declaration(declaration),
-    m_closure(std::move(closure))
+    m_closure(std::move(closure)),
+    m_globals(globals)
 {
   m_closure->define(m_declaration.m_name.m_lexeme, this);
 }
 
 SlangFn::SlangFn(SlangFn&& other)
   : m_declaration(other.m_declaration),
-    m_closure(std::move(other.m_closure))
+    m_closure(std::move(other.m_closure)),
+    m_globals(other.m_globals)
 {
   m_closure->define(m_declaration.m_name.m_lexeme, this);
 }
 
 Object SlangFn::call(Interpreter &interpreter, std::vector<Object> &args) {
+  // tail calls unwind back to this frame and run the callee in the same
+  // environment, so neither the native stack nor the heap grows with them
+  SlangFn* fn = this;
+  Object tail_callee = nullptr;
+  std::vector<Object> tail_args;
+  std::vector<Object>* fn_args = &args;
+
   auto env = std::make_unique<Environment>(Environment(m_closure.get()));
-  for (size_t i = 0; i < m_declaration.m_params.size(); ++i) {
-    env->define(m_declaration.m_params[i].m_lexeme, args[i]);
-  }
 
-  try {
-    interpreter.executeBlock(m_declaration.m_body, env.get());
-  } catch (ReturnExc& ret) {
-    return ret.m_value;
+  /// Restores the caller's globals on destruction
+  class RestoreGlobals {
+  public:
+    RestoreGlobals(Interpreter& interpreter, Environment* globals)
+      : m_interpreter(interpreter),
+        m_caller_globals(interpreter.switch_globals(globals)) {}
+
+    ~RestoreGlobals() {
+      m_interpreter.switch_globals(m_caller_globals);
+    }
+
+  private:
+    Interpreter& m_interpreter;
+    Environment* m_caller_globals;
+  };
+
+  RestoreGlobals globals(interpreter, m_globals);
+
+  for (;;) {
+    auto& declaration = fn->m_declaration;
+    if (declaration.m_lazy_body != nullptr) {
+      // detached first, so the body is compiled as a parsed one
+      auto lazy_body = std::move(declaration.m_lazy_body);
+      try {
+        lazy_body->compile(declaration, interpreter);
+      } catch (const RuntimeError&) {
+        declaration.m_lazy_body = std::move(lazy_body);
+        throw;
+      }
+    }
+
+    auto& params = declaration.m_params;
+    for (size_t i = 0; i < params.size(); ++i) {
+      env->define(params[i].m_lexeme, (*fn_args)[i]);
+    }
+
+    try {
+      interpreter.executeBlock(declaration.m_body, env.get());
+      return nullptr;
+    } catch (ReturnExc& ret) {
+      return ret.m_value;
+    } catch (TailCallExc& tail) {
+      tail_callee = std::move(tail.m_callee);
+      tail_args = std::move(tail.m_args);
+      fn_args = &tail_args;
+      fn = tail.m_fn;
+      env->reset(fn->m_closure.get());
+      interpreter.switch_globals(fn->m_globals);
+    }
   }
+}
+
+void SlangFn::track(Journal& journal) {
+  journal.track(*m_closure);
+  journal.track(*m_globals);
+}
 
-  return nullptr;
+void SlangFn::pin(HeapPin& pin) {
+  pin.pin(*m_closure);
+  pin.pin(*m_globals);
 }
 
 size_t SlangFn::arity() {
@@ -8,7 +8,10 @@ namespace slang {
 
 class SlangFn : public ICallable {
 public:
-  SlangFn(stmt::Fn& declaration, std::unique_ptr<Environment> closure);
+  /// Looks up global variables in @globals, those of the module
+  /// the function was defined in.
+  SlangFn(stmt::Fn& declaration, std::unique_ptr<Environment> closure,
+          Environment* globals);
   SlangFn(SlangFn &&);
   SlangFn(const SlangFn &) = delete;
   SlangFn &operator=(SlangFn &&) = delete;
@@ -19,11 +22,17 @@ public:
 
   size_t arity() override;
 
+  void track(Journal& journal) override;
+  void pin(HeapPin& pin) override;
+
   std::string to_string() const override;
 
 private:
+  friend class HeapWriter;
+
   stmt::Fn& m_declaration;
   std::unique_ptr<Environment> m_closure;
+  Environment* m_globals;
   
 };
 
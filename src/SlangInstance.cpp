@@ -23,6 +23,10 @@ Object SlangInstance::get_property(const Token& name) {
 
 
 void SlangInstance::set_property(const Token& name, const Object& value) {
+  if (m_link.m_journal != nullptr) {
+    m_link.m_journal->save(*this);
+  }
+
   m_fields.insert_or_assign(name.m_lexeme, value);
 }
   
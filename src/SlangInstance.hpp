@@ -24,8 +24,14 @@ public:
   void set_property(const Token& name, const Object& value);
 
 private:
+  friend class HeapPin;
+  friend class HeapReader;
+  friend class HeapWriter;
+  friend class Journal;
+
   std::unordered_map<string, Object> m_fields{};
   const SlangClass* m_cls;
+  JournalLink m_link{};
 };
   
 } // namespace slang
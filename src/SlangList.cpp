@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cmath>
+
+#include "InterpreterExceptions.hpp"
+#include "SlangList.hpp"
+
+namespace slang {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+/// Integer value of @index, throws RuntimeError at @bracket for anything else.
+static std::int64_t integer_index(const Token& bracket, const Object& index) {
+  if (auto pint = std::get_if<std::int64_t>(&index)) {
+    return *pint;
+  }
+
+  // 2.0 is as good an index as 2
+  if (auto pdouble = std::get_if<double>(&index)) {
+    if (std::trunc(*pdouble) == *pdouble && std::fabs(*pdouble) < 9.2e18) {
+      return static_cast<std::int64_t>(*pdouble);
+    }
+  }
+
+  throw RuntimeError(bracket, "List index must be an integer.");
+}
+
+/// Slice bound @bound of a list of @size, clamped to the list.
+static std::int64_t slice_bound(const Token& bracket, const Object& bound,
+                                std::int64_t size, std::int64_t otherwise) {
+  if (std::holds_alternative<std::nullptr_t>(bound)) return otherwise;
+
+  std::int64_t value = integer_index(bracket, bound);
+  if (value < 0) value += size;
+  return std::clamp<std::int64_t>(value, 0, size);
+}
+
+// lists being printed on this thread, a list containing itself prints as [...]
+static thread_local vector<const SlangList*> s_printing{};
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+string SlangList::to_string() const {
+  if (std::find(helpers::s_printing.begin(), helpers::s_printing.end(), this)
+      != helpers::s_printing.end()) {
+    return "[...]";
+  }
+
+  helpers::s_printing.push_back(this);
+  string result = "[";
+  for (std::size_t i = 0; i < m_items.size(); ++i) {
+    if (i != 0) result += ", ";
+    result += object_to_string(m_items[i]);
+  }
+  result += "]";
+  helpers::s_printing.pop_back();
+
+  return result;
+}
+
+const Object& SlangList::get(const Token& bracket, const Object& index) const {
+  return m_items[position(bracket, index)];
+}
+
+void SlangList::set(const Token& bracket, const Object& index, const Object& value) {
+  std::size_t at = position(bracket, index);
+  before_write();
+  m_items[at] = value;
+}
+
+Object SlangList::pop() {
+  if (m_items.empty()) {
+    throw NativeError("Can not pop from an empty list.");
+  }
+
+  before_write();
+  Object last = std::move(m_items.back());
+  m_items.pop_back();
+  return last;
+}
+
+std::shared_ptr<SlangList> SlangList::slice(const Token& bracket,
+                                            const Object& start, const Object& end) const {
+  auto size = static_cast<std::int64_t>(m_items.size());
+  std::int64_t from = helpers::slice_bound(bracket, start, size, 0);
+  std::int64_t to = helpers::slice_bound(bracket, end, size, size);
+
+  if (from >= to) {
+    return std::make_shared<SlangList>();
+  }
+
+  return std::make_shared<SlangList>(
+      vector<Object>(m_items.begin() + from, m_items.begin() + to));
+}
+
+// ------------------------ | PRIVATE |
+std::size_t SlangList::position(const Token& bracket, const Object& index) const {
+  std::int64_t at = helpers::integer_index(bracket, index);
+  auto size = static_cast<std::int64_t>(m_items.size());
+  if (at < 0) at += size;
+
+  if (at < 0 || at >= size) {
+    throw RuntimeError(bracket, "List index out of range.");
+  }
+
+  return static_cast<std::size_t>(at);
+}
+
+} // namespace slang
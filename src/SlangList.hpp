@@ -0,0 +1,77 @@
+#ifndef __SLANG_LIST_HPP__
+#define __SLANG_LIST_HPP__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Journal.hpp"
+#include "Object.hpp"
+#include "Token.hpp"
+
+namespace slang {
+
+using std::string;
+using std::vector;
+
+/// Growable list of values, kept in one contiguous buffer, so indexing
+/// is a bounds check and an offset and appending is amortized O(1).
+/// Negative indexes count from the end, like in Python.
+class SlangList {
+public:
+  SlangList() = default;
+  explicit SlangList(vector<Object> items)
+    : m_items(std::move(items)) {}
+
+  SlangList(SlangList &&) = default;
+  SlangList(const SlangList &) = default;
+  SlangList &operator=(SlangList &&) = default;
+  SlangList &operator=(const SlangList &) = default;
+  ~SlangList() = default;
+
+  string to_string() const;
+
+  std::size_t size() const { return m_items.size(); }
+  const vector<Object>& items() const { return m_items; }
+
+  /// Element at @index, throws RuntimeError at @bracket
+  /// if it is not an integer within the list.
+  const Object& get(const Token& bracket, const Object& index) const;
+  void set(const Token& bracket, const Object& index, const Object& value);
+
+  void push(const Object& value) {
+    before_write();
+    m_items.push_back(value);
+  }
+
+  /// Removes the last element and returns it, throws NativeError
+  /// if the list is empty.
+  Object pop();
+
+  /// Copy of the elements from @start up to @end, either of them none
+  /// for the start or the end of the list. Bounds past the ends are
+  /// clamped to them.
+  std::shared_ptr<SlangList> slice(const Token& bracket,
+                                   const Object& start, const Object& end) const;
+
+private:
+  friend class HeapPin;
+  friend class HeapReader;
+  friend class HeapWriter;
+  friend class Journal;
+
+  vector<Object> m_items{};
+  JournalLink m_link{};
+
+  void before_write() {
+    if (m_link.m_journal != nullptr) {
+      m_link.m_journal->save(*this);
+    }
+  }
+
+  std::size_t position(const Token& bracket, const Object& index) const;
+};
+
+} // namespace slang
+
+#endif // !__SLANG_LIST_HPP__
@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#include "ICallable.hpp"
+#include "Number.hpp"
+#include "SlangMap.hpp"
+
+namespace slang {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+/// Finalizer of MurmurHash3, spreads every input bit over the whole hash,
+/// the probing takes the low bits and the buckets keep the high ones.
+static std::uint64_t mix(std::uint64_t value) {
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdull;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ull;
+  value ^= value >> 33;
+  return value;
+}
+
+static const ICallable* as_callable(const Object& value) {
+  if (auto callable = std::get_if<std::shared_ptr<ICallable>>(&value)) {
+    return callable->get();
+  } else if (auto callable = std::get_if<ICallable*>(&value)) {
+    return *callable;
+  }
+
+  return nullptr;
+}
+
+// maps being printed on this thread, a map containing itself prints as {...}
+static thread_local vector<const SlangMap*> s_printing{};
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+string SlangMap::to_string() const {
+  if (std::find(helpers::s_printing.begin(), helpers::s_printing.end(), this)
+      != helpers::s_printing.end()) {
+    return "{...}";
+  }
+
+  helpers::s_printing.push_back(this);
+  string result = "{";
+  bool first = true;
+  for (const Entry& entry : m_entries) {
+    if (entry.m_removed) continue;
+
+    if (!first) result += ", ";
+    first = false;
+    result += object_to_string(entry.m_key);
+    result += ": ";
+    result += object_to_string(entry.m_value);
+  }
+  result += "}";
+  helpers::s_printing.pop_back();
+
+  return result;
+}
+
+bool SlangMap::is_key(const Object& key) {
+  auto pdouble = std::get_if<double>(&key);
+  return pdouble == nullptr || !std::isnan(*pdouble);
+}
+
+Object SlangMap::get(const Object& key) const {
+  std::size_t at = find(key, hash(key));
+  if (at == NOT_FOUND) return nullptr;
+
+  return m_entries[m_buckets[at].m_entry].m_value;
+}
+
+bool SlangMap::has(const Object& key) const {
+  return find(key, hash(key)) != NOT_FOUND;
+}
+
+void SlangMap::set(const Object& key, const Object& value) {
+  std::uint64_t key_hash = hash(key);
+  std::size_t at = find(key, key_hash);
+
+  before_write();
+  if (at != NOT_FOUND) {
+    m_entries[m_buckets[at].m_entry].m_value = value;
+    return;
+  }
+
+  // at most 7/8 of the buckets are taken
+  if ((m_size + 1) * 8 > m_buckets.size() * 7) {
+    rehash((m_size + 1) * 2);
+  }
+
+  m_entries.push_back(Entry{key, value, key_hash, false});
+  place(Bucket{1, static_cast<std::uint32_t>(key_hash >> 32),
+               static_cast<std::uint32_t>(m_entries.size() - 1)},
+        key_hash & (m_buckets.size() - 1));
+  ++m_size;
+}
+
+Object SlangMap::remove(const Object& key) {
+  std::size_t at = find(key, hash(key));
+  if (at == NOT_FOUND) return nullptr;
+
+  before_write();
+  Entry& entry = m_entries[m_buckets[at].m_entry];
+  Object value = std::move(entry.m_value);
+  entry.m_key = nullptr;
+  entry.m_value = nullptr;
+  entry.m_removed = true;
+  --m_size;
+
+  // shifts the buckets after it back, so no lookup has to skip a hole
+  std::size_t mask = m_buckets.size() - 1;
+  for (std::size_t next = (at + 1) & mask;
+       m_buckets[next].m_distance > 1;
+       at = next, next = (next + 1) & mask) {
+    m_buckets[at] = m_buckets[next];
+    --m_buckets[at].m_distance;
+  }
+  m_buckets[at] = Bucket{0, 0, 0};
+
+  // removed entries are only dropped once they outnumber the live ones
+  if (m_entries.size() > 2 * m_size + MIN_BUCKETS) {
+    rehash(m_size);
+  }
+
+  return value;
+}
+
+vector<Object> SlangMap::keys() const {
+  vector<Object> keys;
+  keys.reserve(m_size);
+  for (const Entry& entry : m_entries) {
+    if (!entry.m_removed) keys.push_back(entry.m_key);
+  }
+
+  return keys;
+}
+
+vector<Object> SlangMap::values() const {
+  vector<Object> values;
+  values.reserve(m_size);
+  for (const Entry& entry : m_entries) {
+    if (!entry.m_removed) values.push_back(entry.m_value);
+  }
+
+  return values;
+}
+
+// ------------------------ | PRIVATE |
+std::uint64_t SlangMap::hash(const Object& key) {
+  if (auto pint = std::get_if<std::int64_t>(&key)) {
+    return helpers::mix(static_cast<std::uint64_t>(*pint));
+  } else if (auto pdouble = std::get_if<double>(&key)) {
+    // integral doubles hash like the integers they are equal to
+    std::int64_t integer;
+    if (to_exact_int(*pdouble, integer)) {
+      return helpers::mix(static_cast<std::uint64_t>(integer));
+    }
+
+    std::uint64_t bits;
+    std::memcpy(&bits, pdouble, sizeof(bits));
+    return helpers::mix(bits);
+  } else if (auto pstr = std::get_if<SlangString>(&key)) {
+    return helpers::mix(std::hash<std::string_view>{}(pstr->view()));
+  } else if (auto pbool = std::get_if<bool>(&key)) {
+    return helpers::mix(*pbool ? 0x2545f4914f6cdd1dull : 0x9e3779b97f4a7c15ull);
+  } else if (std::holds_alternative<std::nullptr_t>(key)) {
+    return helpers::mix(0x632be59bd9b4e019ull);
+  } else if (auto callable = helpers::as_callable(key)) {
+    return helpers::mix(reinterpret_cast<std::uintptr_t>(callable));
+  } else if (auto instance = std::get_if<std::shared_ptr<SlangInstance>>(&key)) {
+    return helpers::mix(reinterpret_cast<std::uintptr_t>(instance->get()));
+  } else if (auto list = std::get_if<std::shared_ptr<SlangList>>(&key)) {
+    return helpers::mix(reinterpret_cast<std::uintptr_t>(list->get()));
+  } else if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&key)) {
+    return helpers::mix(reinterpret_cast<std::uintptr_t>(array->get()));
+  }
+
+  return helpers::mix(reinterpret_cast<std::uintptr_t>(
+      std::get<std::shared_ptr<SlangMap>>(key).get()));
+}
+
+bool SlangMap::keys_equal(const Object& left, const Object& right) {
+  // like ==, exactly, so keys equal to each other share a hash
+  if (is_number(left) && is_number(right)) {
+    return compare(EQ_EQ, Number::from_object(left), Number::from_object(right));
+  }
+
+  // a function referring to itself holds a plain pointer to it
+  if (auto callable = helpers::as_callable(left)) {
+    return callable == helpers::as_callable(right);
+  }
+
+  return left == right;
+}
+
+std::size_t SlangMap::find(const Object& key, std::uint64_t hash) const {
+  if (m_buckets.empty()) return NOT_FOUND;
+
+  std::size_t mask = m_buckets.size() - 1;
+  auto fingerprint = static_cast<std::uint32_t>(hash >> 32);
+
+  for (std::size_t at = hash & mask, distance = 1;; at = (at + 1) & mask, ++distance) {
+    const Bucket& bucket = m_buckets[at];
+    // an empty bucket, or one closer to its home than the key would be
+    if (bucket.m_distance < distance) return NOT_FOUND;
+
+    if (bucket.m_hash == fingerprint
+        && keys_equal(m_entries[bucket.m_entry].m_key, key)) {
+      return at;
+    }
+  }
+}
+
+void SlangMap::place(Bucket bucket, std::size_t at) {
+  std::size_t mask = m_buckets.size() - 1;
+
+  // takes the place of any bucket closer to its home
+  for (;; at = (at + 1) & mask, ++bucket.m_distance) {
+    Bucket& current = m_buckets[at];
+    if (current.m_distance == 0) {
+      current = bucket;
+      return;
+    }
+
+    if (current.m_distance < bucket.m_distance) {
+      std::swap(current, bucket);
+    }
+  }
+}
+
+void SlangMap::rehash(std::size_t capacity) {
+  if (m_entries.size() != m_size) {
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                   [](const Entry& entry) { return entry.m_removed; }),
+                    m_entries.end());
+  }
+
+  std::size_t bucket_count = MIN_BUCKETS;
+  while (bucket_count * 7 < capacity * 8) {
+    bucket_count *= 2;
+  }
+
+  m_buckets.assign(bucket_count, Bucket{0, 0, 0});
+  for (std::size_t i = 0; i < m_entries.size(); ++i) {
+    std::uint64_t entry_hash = m_entries[i].m_hash;
+    place(Bucket{1, static_cast<std::uint32_t>(entry_hash >> 32), static_cast<std::uint32_t>(i)},
+          entry_hash & (bucket_count - 1));
+  }
+}
+
+} // namespace slang
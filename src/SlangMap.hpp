@@ -0,0 +1,108 @@
+#ifndef __SLANG_MAP_HPP__
+#define __SLANG_MAP_HPP__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Journal.hpp"
+#include "Object.hpp"
+
+namespace slang {
+
+using std::string;
+using std::vector;
+
+/// Hash map from values to values.
+///
+/// The entries are kept in insertion order in one array, and an open
+/// addressing table with Robin Hood probing maps hashes to them. A bucket
+/// holds the distance from its home slot, part of the hash and the
+/// entry's index, 12 bytes, so a probe scans a few buckets of one cache
+/// line and compares a key only when its hash matches. The longest probe
+/// stays short even at a high load factor, and a lookup stops as soon as
+/// it passes the buckets its key could be in.
+///
+/// Numbers, strings, booleans and none are keys by value, 1 and 1.0 being
+/// the same key. Instances, lists, maps, arrays and functions are keys by
+/// identity.
+class SlangMap {
+public:
+  SlangMap() = default;
+  SlangMap(SlangMap &&) = default;
+  SlangMap(const SlangMap &) = default;
+  SlangMap &operator=(SlangMap &&) = default;
+  SlangMap &operator=(const SlangMap &) = default;
+  ~SlangMap() = default;
+
+  string to_string() const;
+
+  std::size_t size() const { return m_size; }
+
+  /// Whether @key can be a key, only NaN can not.
+  static bool is_key(const Object& key);
+
+  /// Value of @key, none if there is no such key.
+  /// @key must be a key, see is_key().
+  Object get(const Object& key) const;
+  bool has(const Object& key) const;
+
+  void set(const Object& key, const Object& value);
+
+  /// Removes @key and returns its value, none if there was no such key.
+  Object remove(const Object& key);
+
+  /// Keys and values in insertion order.
+  vector<Object> keys() const;
+  vector<Object> values() const;
+
+private:
+  friend class HeapPin;
+  friend class HeapReader;
+  friend class HeapWriter;
+  friend class Journal;
+
+  struct Entry {
+    Object m_key;
+    Object m_value;
+    std::uint64_t m_hash;
+    bool m_removed;
+  };
+
+  struct Bucket {
+    // 0 for an empty bucket, the distance from the home slot plus one otherwise
+    std::uint32_t m_distance;
+    std::uint32_t m_hash;
+    std::uint32_t m_entry;
+  };
+
+  static constexpr std::size_t NOT_FOUND = SIZE_MAX;
+  static constexpr std::size_t MIN_BUCKETS = 8;
+
+  vector<Entry> m_entries{};
+  vector<Bucket> m_buckets{};
+  std::size_t m_size{0};
+  JournalLink m_link{};
+
+  void before_write() {
+    if (m_link.m_journal != nullptr) {
+      m_link.m_journal->save(*this);
+    }
+  }
+
+  static std::uint64_t hash(const Object& key);
+  static bool keys_equal(const Object& left, const Object& right);
+
+  /// Index of the bucket of @key, NOT_FOUND if there is none.
+  std::size_t find(const Object& key, std::uint64_t hash) const;
+  /// Puts @bucket into the table, probing from slot @at.
+  void place(Bucket bucket, std::size_t at);
+
+  /// Rebuilds the buckets for @capacity entries, dropping removed ones.
+  void rehash(std::size_t capacity);
+};
+
+} // namespace slang
+
+#endif // !__SLANG_MAP_HPP__
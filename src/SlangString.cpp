@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "SlangString.hpp"
+
+namespace slang {
+
+/// Buffer shared by the long strings. A flat node holds its bytes in
+/// m_bytes and never changes again. A rope node stands for m_left,
+/// then m_right, then m_bytes, until view() flattens it.
+///
+/// A rope grows in place: concat() of a string that covers the whole
+/// node with a short one appends to m_bytes. Strings that covered the
+/// node before keep their size, so they still see the same bytes.
+struct SlangString::Node {
+  std::atomic<std::size_t> m_refs{1};
+  std::size_t m_size;
+  bool m_is_rope;
+  std::string m_bytes;
+  SlangString m_left{};
+  SlangString m_right{};
+
+  Node(std::string bytes, bool is_rope)
+    : m_size(bytes.size()), m_is_rope(is_rope), m_bytes(std::move(bytes)) {}
+};
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+/// Strings up to this size are copied into a rope, longer ones are shared.
+static constexpr std::size_t COPY_LIMIT = 4096;
+
+/// Reference count of a pinned node, far above any real count.
+static constexpr std::size_t PINNED = SIZE_MAX / 2;
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+SlangString::SlangString(std::string str) : m_size(str.size()) {
+  if (is_inline()) {
+    std::memcpy(m_inline, str.data(), m_size);
+  } else {
+    m_shared.m_node = new Node(std::move(str), false);
+    m_shared.m_offset = 0;
+  }
+}
+
+SlangString::SlangString(std::string_view str) : m_size(str.size()) {
+  if (is_inline()) {
+    std::memcpy(m_inline, str.data(), m_size);
+  } else {
+    m_shared.m_node = new Node(std::string(str), false);
+    m_shared.m_offset = 0;
+  }
+}
+
+SlangString::SlangString(SlangString &&other) noexcept : m_size(other.m_size) {
+  if (is_inline()) {
+    std::memcpy(m_inline, other.m_inline, m_size);
+  } else {
+    m_shared = other.m_shared;
+    other.m_size = 0;
+  }
+}
+
+SlangString::SlangString(const SlangString &other) : m_size(other.m_size) {
+  if (is_inline()) {
+    std::memcpy(m_inline, other.m_inline, m_size);
+  } else {
+    m_shared = other.m_shared;
+    retain(m_shared.m_node);
+  }
+}
+
+SlangString &SlangString::operator=(SlangString &&other) noexcept {
+  if (this != &other) {
+    if (!is_inline()) release(m_shared.m_node);
+
+    m_size = other.m_size;
+    if (is_inline()) {
+      std::memcpy(m_inline, other.m_inline, m_size);
+    } else {
+      m_shared = other.m_shared;
+      other.m_size = 0;
+    }
+  }
+
+  return *this;
+}
+
+SlangString &SlangString::operator=(const SlangString &other) {
+  if (this != &other) {
+    *this = SlangString(other);
+  }
+
+  return *this;
+}
+
+std::string_view SlangString::view() const {
+  if (is_inline()) {
+    return std::string_view(m_inline, m_size);
+  }
+
+  Node* node = m_shared.m_node;
+  if (node->m_is_rope) {
+    flatten(node);
+  }
+
+  return std::string_view(node->m_bytes.data() + m_shared.m_offset, m_size);
+}
+
+SlangString SlangString::concat(const SlangString& left, const SlangString& right) {
+  if (right.empty()) return left;
+  if (left.empty()) return right;
+
+  std::size_t size = left.m_size + right.m_size;
+  if (size <= INLINE_CAPACITY) {
+    SlangString result;
+    std::memcpy(result.m_inline, left.m_inline, left.m_size);
+    std::memcpy(result.m_inline + left.m_size, right.m_inline, right.m_size);
+    result.m_size = size;
+    return result;
+  }
+
+  std::string_view copied{};
+  if (right.m_size <= helpers::COPY_LIMIT) {
+    // taken before the checks below, it may flatten the node of left
+    copied = right.view();
+  }
+
+  SlangString result;
+  result.m_size = size;
+  result.m_shared.m_offset = 0;
+
+  if (!left.is_inline() && left.m_shared.m_node->m_is_rope
+      && left.m_shared.m_node->m_size == left.m_size && copied.size() != 0) {
+    Node* node = left.m_shared.m_node;
+    node->m_bytes.append(copied);
+    node->m_size = size;
+    retain(node);
+    result.m_shared.m_node = node;
+    return result;
+  }
+
+  Node* node;
+  if (left.m_size <= helpers::COPY_LIMIT && copied.size() != 0) {
+    std::string bytes(left.view());
+    bytes.append(copied);
+    node = new Node(std::move(bytes), true);
+  } else {
+    node = new Node(std::string(copied), true);
+    node->m_left = left;
+    if (copied.size() == 0) {
+      node->m_right = right;
+    }
+    node->m_size = size;
+  }
+
+  result.m_shared.m_node = node;
+  return result;
+}
+
+SlangString SlangString::slice(std::size_t start, std::size_t end) const {
+  if (end <= start) return SlangString();
+
+  std::size_t size = end - start;
+  if (size <= INLINE_CAPACITY) {
+    return SlangString(view().substr(start, size));
+  }
+
+  // flattened first, a rope has no offsets
+  view();
+
+  SlangString result;
+  result.m_size = size;
+  result.m_shared.m_node = m_shared.m_node;
+  result.m_shared.m_offset = m_shared.m_offset + start;
+  retain(result.m_shared.m_node);
+  return result;
+}
+
+void SlangString::pin() const {
+  if (is_inline()) return;
+
+  // a flat node never changes again
+  view();
+  m_shared.m_node->m_refs.store(helpers::PINNED, std::memory_order_relaxed);
+}
+
+// ------------------------ | PRIVATE |
+void SlangString::retain(Node* node) {
+  // only read, the page of a pinned node is never written
+  if (node->m_refs.load(std::memory_order_relaxed) >= helpers::PINNED) return;
+
+  node->m_refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SlangString::release(Node* node) {
+  std::vector<Node*> dead{};
+  while (true) {
+    // a pinned node is never freed, and its count is never written
+    bool pinned = node->m_refs.load(std::memory_order_relaxed) >= helpers::PINNED;
+    if (!pinned && node->m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      // the children are taken over here, so their nodes are not
+      // released by a recursive destructor
+      for (SlangString* child : {&node->m_left, &node->m_right}) {
+        if (!child->is_inline()) {
+          dead.push_back(child->m_shared.m_node);
+          child->m_size = 0;
+        }
+      }
+      delete node;
+    }
+
+    if (dead.empty()) break;
+    node = dead.back();
+    dead.pop_back();
+  }
+}
+
+void SlangString::flatten(Node* node) {
+  if (node->m_left.empty() && node->m_right.empty()) {
+    node->m_is_rope = false;
+    return;
+  }
+
+  // pieces still to append, a rope string is expanded into its children,
+  // the last piece of a string covering only a prefix of its node is cut
+  struct Piece {
+    const SlangString* m_str;
+    std::string_view m_bytes;
+    std::size_t m_size;
+  };
+
+  std::string bytes;
+  bytes.reserve(node->m_size);
+
+  std::vector<Piece> pieces{};
+  pieces.push_back({nullptr, node->m_bytes, node->m_bytes.size()});
+  pieces.push_back({&node->m_right, {}, node->m_right.m_size});
+  pieces.push_back({&node->m_left, {}, node->m_left.m_size});
+
+  while (!pieces.empty()) {
+    Piece piece = pieces.back();
+    pieces.pop_back();
+
+    if (piece.m_str == nullptr) {
+      bytes.append(piece.m_bytes.data(), piece.m_size);
+      continue;
+    }
+
+    const SlangString& str = *piece.m_str;
+    if (str.is_inline()) {
+      bytes.append(str.m_inline, piece.m_size);
+      continue;
+    }
+
+    const Node* child = str.m_shared.m_node;
+    if (!child->m_is_rope) {
+      bytes.append(child->m_bytes.data() + str.m_shared.m_offset, piece.m_size);
+      continue;
+    }
+
+    std::size_t left = std::min(piece.m_size, child->m_left.m_size);
+    std::size_t right = std::min(piece.m_size - left, child->m_right.m_size);
+    pieces.push_back({nullptr, child->m_bytes, piece.m_size - left - right});
+    pieces.push_back({&child->m_right, {}, right});
+    pieces.push_back({&child->m_left, {}, left});
+  }
+
+  node->m_bytes = std::move(bytes);
+  node->m_left = SlangString();
+  node->m_right = SlangString();
+  node->m_is_rope = false;
+}
+
+} // namespace slang
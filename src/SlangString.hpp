@@ -0,0 +1,87 @@
+#ifndef __SLANG_STRING_HPP__
+#define __SLANG_STRING_HPP__
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace slang {
+
+/// Immutable string value of slang.
+///
+/// Strings of up to INLINE_CAPACITY bytes are kept in the value itself,
+/// so copying them touches no shared memory. Longer ones refer to a
+/// reference counted buffer, copying them is an increment, and a slice
+/// is a view into the same buffer.
+///
+/// concat() of long strings makes a rope node holding both sides and
+/// copies nothing. The rope is flattened into one buffer by the first
+/// read of its bytes, so a string built by appending in a loop is copied
+/// once, when it is used. Flattening writes to the shared node: like
+/// every object of an isolate, a rope belongs to one thread at a time.
+class SlangString {
+public:
+  static constexpr std::size_t INLINE_CAPACITY = 16;
+
+  SlangString() : m_inline{}, m_size(0) {}
+  // implicit, a std::string converts to an Object
+  SlangString(std::string str);
+  explicit SlangString(std::string_view str);
+
+  SlangString(SlangString &&other) noexcept;
+  SlangString(const SlangString &other);
+  SlangString &operator=(SlangString &&other) noexcept;
+  SlangString &operator=(const SlangString &other);
+  ~SlangString() { if (!is_inline()) release(m_shared.m_node); }
+
+  std::size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  /// The bytes, valid as long as this value. Flattens a rope.
+  std::string_view view() const;
+  std::string str() const { return std::string(view()); }
+
+  /// @left followed by @right.
+  static SlangString concat(const SlangString& left, const SlangString& right);
+
+  /// The bytes from @start up to @end, sharing the buffer of a long string.
+  SlangString slice(std::size_t start, std::size_t end) const;
+
+  /// Makes the buffer of a long string immortal: copies of it no longer
+  /// write its reference count and it is never freed. Flattens a rope.
+  void pin() const;
+
+  friend bool operator==(const SlangString& left, const SlangString& right) {
+    return left.m_size == right.m_size && left.view() == right.view();
+  }
+
+  friend bool operator!=(const SlangString& left, const SlangString& right) {
+    return !(left == right);
+  }
+
+private:
+  struct Node;
+
+  // a long string is a view of m_size bytes from m_offset into m_node
+  union {
+    struct {
+      Node* m_node;
+      std::size_t m_offset;
+    } m_shared;
+    char m_inline[INLINE_CAPACITY];
+  };
+  std::size_t m_size;
+
+  bool is_inline() const { return m_size <= INLINE_CAPACITY; }
+
+  static void retain(Node* node);
+  /// Drops a reference to @node, and frees the nodes of a rope
+  /// without recursing, however deep it is.
+  static void release(Node* node);
+  /// Copies the leaves of the rope @node into one buffer and drops them.
+  static void flatten(Node* node);
+};
+
+} // namespace slang
+
+#endif // !__SLANG_STRING_HPP__
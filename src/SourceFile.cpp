@@ -0,0 +1,24 @@
+#include <sys/stat.h>
+
+#include "SourceFile.hpp"
+
+namespace slang {
+
+bool SourceFile::open(const char* path) {
+  m_is_mapped = m_mapping.open(path);
+  if (m_is_mapped) {
+    m_mapping.advise_sequential();
+    return true;
+  }
+
+  // a stream opens a directory, only reading it fails
+  struct stat st;
+  if (::stat(path, &st) == 0 && S_ISDIR(st.st_mode)) {
+    return false;
+  }
+
+  m_stream.open(path, std::ios::binary);
+  return static_cast<bool>(m_stream);
+}
+
+} // namespace slang
@@ -0,0 +1,43 @@
+#ifndef __SLANG_SOURCE_FILE_HPP__
+#define __SLANG_SOURCE_FILE_HPP__
+
+#include <fstream>
+#include <string_view>
+
+#include "MappedFile.hpp"
+
+namespace slang {
+
+/// Script file as the front end reads it. Regular files are mapped into
+/// memory and scanned in place, without copying them. Anything else,
+/// like pipes and devices, is read through a stream a chunk at a time.
+class SourceFile {
+public:
+  SourceFile() = default;
+  SourceFile(SourceFile &&) = delete;
+  SourceFile(const SourceFile &) = delete;
+  SourceFile &operator=(SourceFile &&) = delete;
+  SourceFile &operator=(const SourceFile &) = delete;
+  ~SourceFile() = default;
+
+  /// Opens the file at @path, returns false if it can not be read,
+  /// like a missing file or a directory.
+  bool open(const char* path);
+
+  bool is_mapped() const { return m_is_mapped; }
+
+  /// Whole text of a mapped file.
+  std::string_view text() const { return { m_mapping.data(), m_mapping.size() }; }
+
+  /// Stream of a file that could not be mapped.
+  std::istream& stream() { return m_stream; }
+
+private:
+  MappedFile m_mapping{};
+  bool m_is_mapped{false};
+  std::ifstream m_stream{};
+};
+
+} // namespace slang
+
+#endif // !__SLANG_SOURCE_FILE_HPP__
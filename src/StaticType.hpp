@@ -0,0 +1,28 @@
+#ifndef __SLANG_STATIC_TYPE_HPP__
+#define __SLANG_STATIC_TYPE_HPP__
+
+namespace slang {
+
+/// Type of an expression proven by the TypeInferrer.
+/// TYPE_BOTTOM means "no value seen yet", TYPE_ANY means "not proven",
+/// TYPE_NUMBER is either an integer or a double.
+enum StaticType {
+  TYPE_BOTTOM, TYPE_INT, TYPE_DOUBLE, TYPE_NUMBER,
+  TYPE_STRING, TYPE_BOOL, TYPE_NONE, TYPE_ANY
+};
+
+inline bool is_numeric_type(StaticType type) {
+  return type == TYPE_INT || type == TYPE_DOUBLE || type == TYPE_NUMBER;
+}
+
+inline StaticType join_types(StaticType a, StaticType b) {
+  if (a == TYPE_BOTTOM) return b;
+  if (b == TYPE_BOTTOM || a == b) return a;
+  if (is_numeric_type(a) && is_numeric_type(b)) return TYPE_NUMBER;
+
+  return TYPE_ANY;
+}
+
+} // namespace slang
+
+#endif // __SLANG_STATIC_TYPE_HPP__
@@ -6,6 +6,7 @@
 
 #include "Token.hpp"
 #include "Expr.hpp"
+#include "LazyBody.hpp"
 
 namespace slang {
 
@@ -16,6 +17,7 @@ class Class;
 class Break;
 class Expression;
 class If;
+class Import;
 class Fn;
 class Print;
 class Return;
@@ -36,6 +38,7 @@ public:
   virtual void visitBreakStmt(Break& stmt) = 0;
   virtual void visitExpressionStmt(Expression& stmt) = 0;
   virtual void visitIfStmt(If& stmt) = 0;
+  virtual void visitImportStmt(Import& stmt) = 0;
   virtual void visitFnStmt(Fn& stmt) = 0;
   virtual void visitPrintStmt(Print& stmt) = 0;
   virtual void visitReturnStmt(Return& stmt) = 0;
@@ -191,13 +194,37 @@ public:
 
 };
 
+class Import : public Stmt {
+public:
+  Import(const Token& keyword, const Token& path) :
+    Stmt(),
+    m_keyword(keyword),
+    m_path(path)
+  {}
+
+  Import(const Import&) = default;
+  Import(Import&&) = default;
+  Import& operator=(const Import&) = default;
+  Import& operator=(Import&&) = default;
+  virtual ~Import() = default;
+
+  void accept(IVisitor& visitor) override {
+    visitor.visitImportStmt(*this);
+  }
+
+  Token m_keyword;
+  Token m_path;
+
+};
+
 class Fn : public Stmt {
 public:
-  Fn(const Token& name, const std::vector<Token>& params, const std::vector<std::shared_ptr<Stmt>>& body) :
+  Fn(const Token& name, const std::vector<Token>& params, const std::vector<std::shared_ptr<Stmt>>& body, const std::shared_ptr<LazyBody>& lazy_body) :
     Stmt(),
     m_name(name),
     m_params(params),
-    m_body(body)
+    m_body(body),
+    m_lazy_body(lazy_body)
   {}
 
   Fn(const Fn&) = default;
@@ -213,6 +240,7 @@ public:
   Token m_name;
   std::vector<Token> m_params;
   std::vector<std::shared_ptr<Stmt>> m_body;
+  std::shared_ptr<LazyBody> m_lazy_body;
 
 };
 
@@ -9,7 +9,8 @@ namespace slang {
 enum TokenType {
   // single-character tokens
   LEFT_PAREN, RIGHT_PAREN, LEFT_BRACE, RIGHT_BRACE,
-  COMMA, DOT, MINUS, PLUS, SEMICOLON, SLASH, STAR,
+  LEFT_BRACKET, RIGHT_BRACKET,
+  COLON, COMMA, DOT, MINUS, PLUS, SEMICOLON, SLASH, STAR,
 
   // one or two characer tokens
   BANG, BANG_EQ, EQ, EQ_EQ,
@@ -20,7 +21,7 @@ enum TokenType {
   IDENTIFIER, STRING, NUMBER,
 
   // keywords
-  AND, BASE, BREAK, CLASS, ELSE, FALSE, FOR, FN, IF, LET,
+  AND, BASE, BREAK, CLASS, ELSE, FALSE, FOR, FN, IF, IMPORT, LET,
   NONE, OR, PRINT, RETURN, SELF, TRUE, WHILE,
 
   END_OF_FILE
@@ -28,8 +29,8 @@ enum TokenType {
 
 class Token {
 public:
-  Token(TokenType type, const std::string& lexeme, Object literal, int line)
-    : m_type(type), m_lexeme(lexeme), m_literal(literal), m_line(line) {}
+  Token(TokenType type, std::string lexeme, Object literal, int line)
+    : m_type(type), m_lexeme(std::move(lexeme)), m_literal(std::move(literal)), m_line(line) {}
 
   Token(Token &&) = default;
   Token(const Token &) = default;
@@ -0,0 +1,58 @@
+#include "TokenStream.hpp"
+
+namespace slang {
+
+// ------------------------ | PUBLIC |
+TokenStream::TokenStream(Scanner& scanner)
+  : m_scanner(&scanner)
+{}
+
+TokenStream::TokenStream(vector<Token> tokens)
+{
+  m_chunks.push_back(std::move(tokens));
+}
+
+TokenStream::TokenStream(vector<vector<Token>> chunks)
+  : m_chunks(std::move(chunks))
+{}
+
+const Token& TokenStream::peek(std::size_t ahead) {
+  while (m_end <= m_current + ahead) {
+    m_ring[m_end % CAPACITY].emplace(pull());
+    ++m_end;
+  }
+
+  return *m_ring[(m_current + ahead) % CAPACITY];
+}
+
+const Token& TokenStream::previous() const {
+  return *m_ring[(m_current - 1) % CAPACITY];
+}
+
+void TokenStream::advance() {
+  peek();
+  ++m_current;
+}
+
+// ------------------------ | PRIVATE |
+Token TokenStream::pull() {
+  if (m_scanner != nullptr) {
+    return m_scanner->next_token();
+  }
+
+  while (m_next_token == m_chunks[m_chunk].size()
+         && m_chunk + 1 < m_chunks.size()) {
+    ++m_chunk;
+    m_next_token = 0;
+  }
+
+  // keep repeating END_OF_FILE like the scanner does
+  auto& chunk = m_chunks[m_chunk];
+  if (m_next_token + 1 < chunk.size() || m_chunk + 1 < m_chunks.size()) {
+    return chunk[m_next_token++];
+  }
+
+  return chunk.back();
+}
+
+} // namespace slang
@@ -0,0 +1,61 @@
+#ifndef __SLANG_TOKEN_STREAM_HPP__
+#define __SLANG_TOKEN_STREAM_HPP__
+
+#include <optional>
+#include <vector>
+
+#include "Scanner.hpp"
+#include "Token.hpp"
+
+namespace slang {
+
+using std::vector;
+
+/// Tokens as the Parser reads them, pulled from the Scanner one at a time.
+/// Only the previous token and a short lookahead are kept, in a ring
+/// buffer, so parsing never needs all tokens of the source at once.
+class TokenStream {
+public:
+  /// Most tokens the Parser may look ahead of the current one.
+  static constexpr std::size_t MAX_LOOKAHEAD = 1;
+
+  explicit TokenStream(Scanner& scanner);
+
+  /// Reads @tokens instead of a scanner, they must end with END_OF_FILE.
+  explicit TokenStream(vector<Token> tokens);
+
+  /// Reads the tokens of @chunks one chunk after another,
+  /// the last one must end with END_OF_FILE.
+  explicit TokenStream(vector<vector<Token>> chunks);
+
+  TokenStream(TokenStream &&) = default;
+  TokenStream(const TokenStream &) = default;
+  TokenStream &operator=(TokenStream &&) = delete;
+  TokenStream &operator=(const TokenStream &) = delete;
+  ~TokenStream() = default;
+
+  /// Returns the token @ahead tokens after the current one.
+  const Token& peek(std::size_t ahead = 0);
+  const Token& previous() const;
+  void advance();
+
+private:
+  // the previous, the current and the lookahead tokens
+  static constexpr std::size_t CAPACITY = MAX_LOOKAHEAD + 2;
+
+  Scanner* m_scanner{nullptr};
+  vector<vector<Token>> m_chunks{};
+  std::size_t m_chunk{0};
+  std::size_t m_next_token{0};
+
+  std::optional<Token> m_ring[CAPACITY];
+  // number of the current token and of the next one to be pulled
+  std::size_t m_current{0};
+  std::size_t m_end{0};
+
+  Token pull();
+};
+
+} // namespace slang
+
+#endif // !__SLANG_TOKEN_STREAM_HPP__
@@ -0,0 +1,675 @@
+#include <unordered_set>
+
+#include "PreParsedBody.hpp"
+#include "TypeInferrer.hpp"
+
+namespace slang {
+
+// ------------------------ | HELPERS |
+namespace helpers {
+
+/// join_types where nullopt, an undeclared variable, takes the other type.
+static std::optional<StaticType> join_optional(std::optional<StaticType> a,
+                                               std::optional<StaticType> b) {
+  if (!a) return b;
+  if (!b) return a;
+
+  return join_types(*a, *b);
+}
+
+} // namespace helpers
+
+// ------------------------ | PUBLIC |
+void TypeInferrer::infer(vector<shared_ptr<stmt::Stmt>>& statements) {
+  // variables assigned from closures can only be found after seeing the
+  // whole program, so the first walk collects them and the second infers
+  m_collecting = true;
+  walk(statements);
+
+  m_collecting = false;
+  walk(statements);
+
+  for (auto& [expr, type] : m_types) {
+    expr->m_static_type = type == TYPE_BOTTOM ? TYPE_ANY : type;
+  }
+}
+
+void TypeInferrer::infer_continuation(vector<shared_ptr<stmt::Stmt>>& statements) {
+  if (m_scopes.empty()) {
+    reset();
+  }
+
+  // both walks start from the globals as the previous statements left them
+  auto globals = m_scopes.front();
+  auto state = m_state;
+
+  m_collecting = true;
+  continue_walk(statements);
+
+  m_scopes = {globals};
+  m_state = std::move(state);
+  m_collecting = false;
+  continue_walk(statements);
+
+  for (auto& [expr, type] : m_types) {
+    expr->m_static_type = type == TYPE_BOTTOM ? TYPE_ANY : type;
+  }
+}
+
+void TypeInferrer::forget_types() {
+  m_state.clear();
+}
+
+void TypeInferrer::infer(stmt::Fn& fn) {
+  m_collecting = true;
+  reset();
+  analyse_function(fn);
+
+  m_collecting = false;
+  reset();
+  analyse_function(fn);
+
+  for (auto& [expr, type] : m_types) {
+    expr->m_static_type = type == TYPE_BOTTOM ? TYPE_ANY : type;
+  }
+}
+
+void TypeInferrer::report(std::ostream& out) const {
+  for (auto& fn : m_fns) {
+    std::size_t proven = 0;
+    for (auto op : fn.m_operations) {
+      proven += is_proven(*op);
+    }
+
+    if (fn.m_name != nullptr) {
+      out << "fn " << fn.m_name->m_lexeme << " [line " << fn.m_name->m_line << "]: ";
+    } else {
+      out << "<script>: ";
+    }
+
+    if (proven == fn.m_operations.size()) {
+      out << "fully inferred\n";
+    } else {
+      out << proven << "/" << fn.m_operations.size()
+          << " checked operations proven\n";
+    }
+  }
+}
+
+bool TypeInferrer::is_proven(const expr::Expr& expr) {
+  if (auto unary = dynamic_cast<const expr::Unary*>(&expr)) {
+    return is_numeric_type(unary->m_right->m_static_type);
+  }
+
+  if (auto binary = dynamic_cast<const expr::Binary*>(&expr)) {
+    auto left = binary->m_left->m_static_type;
+    auto right = binary->m_right->m_static_type;
+
+    if (binary->m_oper.m_type == PLUS && left == TYPE_STRING) {
+      return right == TYPE_STRING;
+    }
+
+    return is_numeric_type(left) && is_numeric_type(right);
+  }
+
+  return false;
+}
+
+// ------------------------ | EXPRESSIONS |
+void TypeInferrer::visitAssignExpr(expr::Assign &expr) {
+  auto type = infer(*expr.m_value);
+  assign(expr.m_name, type);
+  Return(record(expr, type));
+}
+
+void TypeInferrer::visitBinaryExpr(expr::Binary &expr) {
+  auto left = infer(*expr.m_left);
+  auto right = infer(*expr.m_right);
+
+  StaticType type = TYPE_ANY;
+  switch (expr.m_oper.m_type) {
+    case MINUS:
+    case SLASH:
+    case STAR:
+      add_operation(expr);
+      type = arithmetic_type(left, right);
+      break;
+
+    case GREATER:
+    case GREATER_EQ:
+    case LESS:
+    case LESS_EQ:
+      add_operation(expr);
+      type = TYPE_BOOL;
+      break;
+
+    case BANG_EQ:
+    case EQ_EQ:
+      type = TYPE_BOOL;
+      break;
+
+    case PLUS:
+      // anything but two numbers or two strings is a runtime error
+      add_operation(expr);
+      if (is_numeric_type(left) || is_numeric_type(right)) {
+        type = arithmetic_type(left, right);
+      } else if (left == TYPE_STRING || right == TYPE_STRING) {
+        type = TYPE_STRING;
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  Return(record(expr, type));
+}
+
+void TypeInferrer::visitCallExpr(expr::Call &expr) {
+  infer(*expr.m_callee);
+  for (auto& arg : expr.m_args) {
+    infer(*arg);
+  }
+
+  Return(record(expr, TYPE_ANY));
+}
+
+void TypeInferrer::visitGetExpr(expr::Get &expr) {
+  infer(*expr.m_object);
+  Return(record(expr, TYPE_ANY));
+}
+
+void TypeInferrer::visitGroupingExpr(expr::Grouping &expr) {
+  Return(record(expr, infer(*expr.m_expression)));
+}
+
+void TypeInferrer::visitLiteralExpr(expr::Literal &expr) {
+  StaticType type = TYPE_ANY;
+  if (std::holds_alternative<std::int64_t>(expr.m_value)) {
+    type = TYPE_INT;
+  } else if (std::holds_alternative<double>(expr.m_value)) {
+    type = TYPE_DOUBLE;
+  } else if (std::holds_alternative<SlangString>(expr.m_value)) {
+    type = TYPE_STRING;
+  } else if (std::holds_alternative<bool>(expr.m_value)) {
+    type = TYPE_BOOL;
+  } else if (std::holds_alternative<std::nullptr_t>(expr.m_value)) {
+    type = TYPE_NONE;
+  }
+
+  Return(record(expr, type));
+}
+
+void TypeInferrer::visitLogicalExpr(expr::Logical &expr) {
+  auto left = infer(*expr.m_left);
+
+  // the right operand may be skipped
+  auto mark = open_branch();
+  auto right = infer(*expr.m_right);
+  Delta evaluated = changes_since(mark);
+  undo(mark);
+  join_paths({evaluated, {}});
+
+  Return(record(expr, join_types(left, right)));
+}
+
+void TypeInferrer::visitSetExpr(expr::Set &expr) {
+  infer(*expr.m_object);
+  Return(record(expr, infer(*expr.m_value)));
+}
+
+void TypeInferrer::visitListExpr(expr::List &expr) {
+  for (auto& element : expr.m_elements) {
+    infer(*element);
+  }
+
+  Return(record(expr, TYPE_ANY));
+}
+
+void TypeInferrer::visitMapExpr(expr::Map &expr) {
+  for (std::size_t i = 0; i < expr.m_keys.size(); ++i) {
+    infer(*expr.m_keys[i]);
+    infer(*expr.m_values[i]);
+  }
+
+  Return(record(expr, TYPE_ANY));
+}
+
+void TypeInferrer::visitIndexExpr(expr::Index &expr) {
+  infer(*expr.m_object);
+  infer(*expr.m_index);
+  Return(record(expr, TYPE_ANY));
+}
+
+void TypeInferrer::visitSetIndexExpr(expr::SetIndex &expr) {
+  infer(*expr.m_object);
+  infer(*expr.m_index);
+  Return(record(expr, infer(*expr.m_value)));
+}
+
+void TypeInferrer::visitSliceExpr(expr::Slice &expr) {
+  infer(*expr.m_object);
+  if (expr.m_start != nullptr) infer(*expr.m_start);
+  if (expr.m_end != nullptr) infer(*expr.m_end);
+  Return(record(expr, TYPE_ANY));
+}
+
+void TypeInferrer::visitUnaryExpr(expr::Unary &expr) {
+  auto right = infer(*expr.m_right);
+
+  StaticType type = TYPE_ANY;
+  if (expr.m_oper.m_type == MINUS) {
+    // negating the smallest integer overflows into a double
+    add_operation(expr);
+    type = right == TYPE_DOUBLE ? TYPE_DOUBLE : TYPE_NUMBER;
+  } else if (expr.m_oper.m_type == BANG) {
+    type = TYPE_BOOL;
+  }
+
+  Return(record(expr, type));
+}
+
+void TypeInferrer::visitVariableExpr(expr::Variable &expr) {
+  StaticType type = TYPE_ANY;
+
+  std::size_t scope = 0;
+  auto decl = lookup(expr.m_name.m_lexeme, scope);
+  if (decl != nullptr && is_tracked(expr.m_name, decl, scope)) {
+    auto found = m_state.find(decl);
+    if (found != m_state.end()) {
+      type = found->second;
+    }
+  }
+
+  Return(record(expr, type));
+}
+
+// ------------------------ | STATEMENTS |
+void TypeInferrer::visitBlockStmt(stmt::Block &stmt) {
+  begin_scope();
+  for (auto& s : stmt.m_statements) {
+    s->accept(*this);
+  }
+  end_scope();
+}
+
+void TypeInferrer::visitClassStmt(stmt::Class &stmt) {
+  declare(stmt.m_name, TYPE_ANY);
+
+  for (auto& method : stmt.m_methods) {
+    analyse_function(*method);
+  }
+}
+
+void TypeInferrer::visitBreakStmt(stmt::Break &) {
+  m_break_states.push_back(changes_since(m_loop_mark));
+}
+
+void TypeInferrer::visitExpressionStmt(stmt::Expression &stmt) {
+  infer(*stmt.m_expression);
+}
+
+void TypeInferrer::visitIfStmt(stmt::If &stmt) {
+  infer(*stmt.m_condition);
+
+  auto mark = open_branch();
+  stmt.m_then_branch->accept(*this);
+  Delta then_path = changes_since(mark);
+  undo(mark);
+
+  Delta else_path{};
+  if (stmt.m_else_branch != nullptr) {
+    mark = open_branch();
+    stmt.m_else_branch->accept(*this);
+    else_path = changes_since(mark);
+    undo(mark);
+  }
+
+  join_paths({then_path, else_path});
+}
+
+void TypeInferrer::visitFnStmt(stmt::Fn &stmt) {
+  declare(stmt.m_name, TYPE_ANY);
+  analyse_function(stmt);
+}
+
+void TypeInferrer::visitImportStmt(stmt::Import &) {
+  // the module may define any global anew
+  if (m_scopes.empty()) return;
+
+  for (const auto& [name, decl] : m_scopes.front()) {
+    if (m_state.find(decl) != m_state.end()) {
+      set_type(decl, TYPE_ANY);
+    }
+  }
+}
+
+void TypeInferrer::visitPrintStmt(stmt::Print &stmt) {
+  infer(*stmt.m_expression);
+}
+
+void TypeInferrer::visitReturnStmt(stmt::Return &stmt) {
+  if (stmt.m_value != nullptr) {
+    infer(*stmt.m_value);
+  }
+}
+
+void TypeInferrer::visitVarStmt(stmt::Var &stmt) {
+  StaticType type = TYPE_NONE;
+  if (stmt.m_initializer != nullptr) {
+    type = infer(*stmt.m_initializer);
+  }
+
+  declare(stmt.m_name, type);
+}
+
+void TypeInferrer::visitWhileStmt(stmt::While &stmt) {
+  auto enclosing_breaks = std::move(m_break_states);
+  auto enclosing_mark = m_loop_mark;
+  m_break_states.clear();
+
+  // iterate the body until the types at the loop head stop widening,
+  // the lattice is shallow so this takes a couple of rounds at most
+  Delta after_cond;
+  for (;;) {
+    m_loop_mark = open_branch();
+    infer(*stmt.m_condition);
+    after_cond = changes_since(m_loop_mark);
+
+    stmt.m_then_branch->accept(*this);
+    Delta body_path = changes_since(m_loop_mark);
+    undo(m_loop_mark);
+
+    bool widened = false;
+    for (auto& [decl, type] : body_path) {
+      auto found = m_state.find(decl);
+      std::optional<StaticType> head{};
+      if (found != m_state.end()) head = found->second;
+
+      auto joined = helpers::join_optional(head, type);
+      if (joined != head) {
+        set_type(decl, joined);
+        widened = true;
+      }
+    }
+
+    if (!widened) break;
+  }
+
+  // breaks of earlier rounds left narrower types, which the join absorbs
+  vector<Delta> exits = std::move(m_break_states);
+  exits.push_back(after_cond);
+
+  if (stmt.m_else_branch != nullptr) {
+    auto mark = open_branch();
+    for (auto& [decl, type] : after_cond) {
+      set_type(decl, type);
+    }
+    stmt.m_else_branch->accept(*this);
+    exits.push_back(changes_since(mark));
+    undo(mark);
+  }
+
+  join_paths(exits);
+  m_break_states = std::move(enclosing_breaks);
+  m_loop_mark = enclosing_mark;
+}
+
+// ------------------------ | PRIVATE |
+void TypeInferrer::reset() {
+  m_scopes.clear();
+  begin_scope();
+  m_fn_base = 0;
+  m_state.clear();
+  m_undo.clear();
+  m_open_branches = 0;
+  m_loop_mark = 0;
+  m_break_states.clear();
+  m_types.clear();
+  m_analysed_fns.clear();
+  m_fns.clear();
+  m_fns.push_back(FnInfo{nullptr, {}});
+  m_current_fn = 0;
+}
+
+void TypeInferrer::walk(vector<shared_ptr<stmt::Stmt>>& statements) {
+  reset();
+  for (auto& s : statements) {
+    s->accept(*this);
+  }
+}
+
+void TypeInferrer::continue_walk(vector<shared_ptr<stmt::Stmt>>& statements) {
+  m_fn_base = 0;
+  m_undo.clear();
+  m_open_branches = 0;
+  m_loop_mark = 0;
+  m_break_states.clear();
+  m_types.clear();
+  m_analysed_fns.clear();
+  m_fns.clear();
+  m_fns.push_back(FnInfo{nullptr, {}});
+  m_current_fn = 0;
+
+  for (auto& s : statements) {
+    s->accept(*this);
+  }
+}
+
+void TypeInferrer::analyse_function(stmt::Fn& fn) {
+  // a function body does not depend on the state it is declared in,
+  // since everything outside of it is untracked
+  if (!m_analysed_fns.insert(&fn).second) return;
+
+  if (auto lazy_body = dynamic_cast<PreParsedBody*>(fn.m_lazy_body.get())) {
+    // not parsed yet, inferred on its own once it is;
+    // until then it may assign anything it mentions
+    if (m_collecting) {
+      for (auto& name : lazy_body->m_assigned) {
+        escape(name);
+      }
+    }
+    return;
+  }
+
+  auto enclosing_state = std::move(m_state);
+  auto enclosing_undo = std::move(m_undo);
+  auto enclosing_branches = m_open_branches;
+  auto enclosing_mark = m_loop_mark;
+  auto enclosing_breaks = std::move(m_break_states);
+  auto enclosing_base = m_fn_base;
+  auto enclosing_fn = m_current_fn;
+
+  m_state.clear();
+  m_undo.clear();
+  m_open_branches = 0;
+  m_loop_mark = 0;
+  m_break_states.clear();
+  m_fn_base = m_scopes.size();
+  m_fns.push_back(FnInfo{&fn.m_name, {}});
+  m_current_fn = m_fns.size() - 1;
+
+  begin_scope();
+  for (auto& param : fn.m_params) {
+    declare(param, TYPE_ANY);
+  }
+  for (auto& s : fn.m_body) {
+    s->accept(*this);
+  }
+  end_scope();
+
+  m_state = std::move(enclosing_state);
+  m_undo = std::move(enclosing_undo);
+  m_open_branches = enclosing_branches;
+  m_loop_mark = enclosing_mark;
+  m_break_states = std::move(enclosing_breaks);
+  m_fn_base = enclosing_base;
+  m_current_fn = enclosing_fn;
+}
+
+StaticType TypeInferrer::infer(expr::Expr& expr) {
+  return GetValue(expr);
+}
+
+StaticType TypeInferrer::record(expr::Expr& expr, StaticType type) {
+  auto& seen = m_types[&expr];
+  seen = join_types(seen, type);
+  return type;
+}
+
+void TypeInferrer::add_operation(expr::Expr& expr) {
+  // loops are walked more than once
+  if (m_types.find(&expr) != m_types.end()) return;
+
+  m_fns[m_current_fn].m_operations.push_back(&expr);
+}
+
+void TypeInferrer::begin_scope() {
+  m_scopes.push_back({});
+}
+
+void TypeInferrer::end_scope() {
+  m_scopes.pop_back();
+}
+
+void TypeInferrer::declare(const Token& name, StaticType type) {
+  m_scopes.back()[name.m_lexeme] = &name;
+  set_type(&name, type);
+}
+
+const Token* TypeInferrer::lookup(const string& name, std::size_t& scope) const {
+  for (std::size_t i = m_scopes.size(); i-- > 0;) {
+    auto found = m_scopes[i].find(name);
+    if (found != m_scopes[i].end()) {
+      scope = i;
+      return found->second;
+    }
+  }
+
+  return nullptr;
+}
+
+bool TypeInferrer::is_tracked(const Token& name, const Token* decl,
+                              std::size_t scope) const {
+  if (scope < m_fn_base) return false;
+  if (m_escaped_locals.count(decl) != 0) return false;
+
+  return scope != 0 || m_escaped_globals.count(name.m_lexeme) == 0;
+}
+
+void TypeInferrer::assign(const Token& name, StaticType type) {
+  std::size_t scope = 0;
+  auto decl = lookup(name.m_lexeme, scope);
+
+  if (decl == nullptr || scope < m_fn_base) {
+    // assigned from a nested function
+    if (m_collecting && m_fn_base != 0) {
+      escape(name.m_lexeme);
+    }
+    return;
+  }
+
+  if (is_tracked(name, decl, scope)) {
+    set_type(decl, type);
+  }
+}
+
+void TypeInferrer::escape(const string& name) {
+  std::size_t scope = 0;
+  auto decl = lookup(name, scope);
+
+  if (decl == nullptr || scope == 0) {
+    m_escaped_globals.insert(name);
+  } else {
+    m_escaped_locals.insert(decl);
+  }
+}
+
+StaticType TypeInferrer::arithmetic_type(StaticType left, StaticType right) {
+  // a double operand makes the result a double, integer results
+  // are promoted to doubles when they overflow or do not divide evenly
+  if (left == TYPE_DOUBLE || right == TYPE_DOUBLE) return TYPE_DOUBLE;
+
+  return TYPE_NUMBER;
+}
+
+void TypeInferrer::set_type(const Token* decl, std::optional<StaticType> type) {
+  auto found = m_state.find(decl);
+
+  if (m_open_branches != 0) {
+    std::optional<StaticType> previous{};
+    if (found != m_state.end()) previous = found->second;
+    m_undo.emplace_back(decl, previous);
+  }
+
+  if (!type) {
+    if (found != m_state.end()) m_state.erase(found);
+  } else if (found != m_state.end()) {
+    found->second = *type;
+  } else {
+    m_state.emplace(decl, *type);
+  }
+}
+
+std::size_t TypeInferrer::open_branch() {
+  ++m_open_branches;
+  return m_undo.size();
+}
+
+TypeInferrer::Delta TypeInferrer::changes_since(std::size_t mark) const {
+  Delta changes;
+  std::unordered_set<const Token*> seen;
+  for (std::size_t i = mark; i < m_undo.size(); ++i) {
+    auto decl = m_undo[i].first;
+    if (!seen.insert(decl).second) continue;
+
+    auto found = m_state.find(decl);
+    std::optional<StaticType> type{};
+    if (found != m_state.end()) type = found->second;
+    changes.emplace_back(decl, type);
+  }
+
+  return changes;
+}
+
+void TypeInferrer::undo(std::size_t mark) {
+  for (std::size_t i = m_undo.size(); i-- > mark;) {
+    auto& [decl, type] = m_undo[i];
+    if (type) {
+      m_state[decl] = *type;
+    } else {
+      m_state.erase(decl);
+    }
+  }
+
+  m_undo.resize(mark);
+  --m_open_branches;
+}
+
+void TypeInferrer::join_paths(const vector<Delta>& paths) {
+  // joined type and the number of paths writing each variable,
+  // the others leave it as it is now
+  unordered_map<const Token*, std::pair<std::optional<StaticType>, std::size_t>> joined;
+  for (auto& path : paths) {
+    for (auto& [decl, type] : path) {
+      auto [entry, inserted] = joined.try_emplace(decl, type, 0);
+      if (!inserted) {
+        entry->second.first = helpers::join_optional(entry->second.first, type);
+      }
+      ++entry->second.second;
+    }
+  }
+
+  for (auto& [decl, entry] : joined) {
+    auto type = entry.first;
+    if (entry.second < paths.size()) {
+      auto found = m_state.find(decl);
+      if (found != m_state.end()) {
+        type = helpers::join_optional(type, found->second);
+      }
+    }
+    set_type(decl, type);
+  }
+}
+
+} // namespace slang
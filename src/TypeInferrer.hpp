@@ -0,0 +1,164 @@
+#ifndef __SLANG_TYPE_INFERRER_HPP__
+#define __SLANG_TYPE_INFERRER_HPP__
+
+#include <optional>
+#include <ostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Expr.hpp"
+#include "Stmt.hpp"
+#include "StaticType.hpp"
+
+namespace slang {
+
+using std::vector;
+using std::shared_ptr;
+using std::string;
+using std::unordered_map;
+using std::unordered_set;
+
+/// Flow-sensitive type inference over the resolved AST.
+/// Writes the proven type of every expression into Expr::m_static_type,
+/// so the interpreter can skip tag checks on numbers and strings.
+///
+/// Only variables that are local to the code being analysed are tracked:
+/// variables of enclosing functions and variables assigned from nested
+/// functions (closures) may change behind our back and are always TYPE_ANY.
+class TypeInferrer : public expr::ValueGetter<TypeInferrer, expr::Expr, StaticType>,
+                     public expr::IVisitor,
+                     public stmt::IVisitor {
+public:
+  TypeInferrer() = default;
+  TypeInferrer(TypeInferrer &&) = default;
+  TypeInferrer(const TypeInferrer &) = default;
+  TypeInferrer &operator=(TypeInferrer &&) = default;
+  TypeInferrer &operator=(const TypeInferrer &) = default;
+  ~TypeInferrer() = default;
+
+  void infer(vector<shared_ptr<stmt::Stmt>>& statements);
+
+  /// Infers @statements as the continuation of the ones inferred by the
+  /// previous calls, as the REPL runs them: globals declared before keep
+  /// their types and the functions assigning them stay known.
+  void infer_continuation(vector<shared_ptr<stmt::Stmt>>& statements);
+
+  /// Forgets the types of all variables, after a runtime error stopped
+  /// the inferred statements at an unknown point.
+  void forget_types();
+
+  /// Infers the body of a function parsed after the rest of the program,
+  /// everything outside of the function is untracked.
+  void infer(stmt::Fn& fn);
+
+  /// Lists every function with the number of checked operations
+  /// (arithmetic, comparison, negation) whose operand types were proven.
+  void report(std::ostream& out) const;
+
+  void visitAssignExpr(expr::Assign &expr) override;
+  void visitBinaryExpr(expr::Binary &expr) override;
+  void visitCallExpr(expr::Call &expr) override;
+  void visitGetExpr(expr::Get &expr) override;
+  void visitGroupingExpr(expr::Grouping &expr) override;
+  void visitLiteralExpr(expr::Literal &expr) override;
+  void visitLogicalExpr(expr::Logical &expr) override;
+  void visitSetExpr(expr::Set &expr) override;
+  void visitMapExpr(expr::Map &expr) override;
+  void visitListExpr(expr::List &expr) override;
+  void visitIndexExpr(expr::Index &expr) override;
+  void visitSetIndexExpr(expr::SetIndex &expr) override;
+  void visitSliceExpr(expr::Slice &expr) override;
+  void visitUnaryExpr(expr::Unary &expr) override;
+  void visitVariableExpr(expr::Variable &expr) override;
+
+  void visitBlockStmt(stmt::Block &stmt) override;
+  void visitClassStmt(stmt::Class &stmt) override;
+  void visitBreakStmt(stmt::Break &stmt) override;
+  void visitExpressionStmt(stmt::Expression &stmt) override;
+  void visitIfStmt(stmt::If &stmt) override;
+  void visitFnStmt(stmt::Fn &stmt) override;
+  void visitImportStmt(stmt::Import &stmt) override;
+  void visitPrintStmt(stmt::Print &stmt) override;
+  void visitReturnStmt(stmt::Return &stmt) override;
+  void visitVarStmt(stmt::Var &stmt) override;
+  void visitWhileStmt(stmt::While &stmt) override;
+
+  /// Returns true if the operands of a checked operation are proven.
+  static bool is_proven(const expr::Expr& expr);
+
+private:
+  using State = unordered_map<const Token*, StaticType>;
+  // types of the variables written on one path of a branch,
+  // nullopt for a variable the path left undeclared
+  using Delta = vector<std::pair<const Token*, std::optional<StaticType>>>;
+
+  struct FnInfo {
+    const Token* m_name;
+    vector<expr::Expr*> m_operations;
+  };
+
+  // name -> declaring token, index 0 is the global scope
+  vector<unordered_map<string, const Token*>> m_scopes;
+  // scope index where the function being analysed starts
+  std::size_t m_fn_base{0};
+  // types of the tracked variables at the current program point
+  State m_state;
+  // previous types of the variables written since the innermost open
+  // branch, so each path is undone instead of copying the whole state
+  Delta m_undo;
+  std::size_t m_open_branches{0};
+  // m_undo position at the head of the innermost loop
+  std::size_t m_loop_mark{0};
+  vector<Delta> m_break_states;
+
+  // first pass only collects variables assigned from nested functions
+  bool m_collecting{false};
+  unordered_set<const Token*> m_escaped_locals;
+  unordered_set<string> m_escaped_globals;
+
+  unordered_map<expr::Expr*, StaticType> m_types;
+  unordered_set<stmt::Fn*> m_analysed_fns;
+  vector<FnInfo> m_fns;
+  std::size_t m_current_fn{0};
+
+  void reset();
+  void walk(vector<shared_ptr<stmt::Stmt>>& statements);
+  /// Walks @statements keeping the scopes and the state of the walk before.
+  void continue_walk(vector<shared_ptr<stmt::Stmt>>& statements);
+  void analyse_function(stmt::Fn& fn);
+  StaticType infer(expr::Expr& expr);
+  StaticType record(expr::Expr& expr, StaticType type);
+  void add_operation(expr::Expr& expr);
+
+  void begin_scope();
+  void end_scope();
+  void declare(const Token& name, StaticType type);
+
+  /// Finds the declaration of @name and the index of its scope.
+  const Token* lookup(const string& name, std::size_t& scope) const;
+  bool is_tracked(const Token& name, const Token* decl, std::size_t scope) const;
+  void assign(const Token& name, StaticType type);
+  /// Marks @name as assigned from a function nested in the current code.
+  void escape(const string& name);
+
+  /// Sets the type of @decl, or forgets it when @type is nullopt,
+  /// logging the previous type while a branch is open.
+  void set_type(const Token* decl, std::optional<StaticType> type);
+
+  /// Opens a branch, its writes can be undone back to the returned mark.
+  std::size_t open_branch();
+  /// The current types of the variables written since @mark.
+  Delta changes_since(std::size_t mark) const;
+  /// Undoes the writes since @mark and closes the branch opened there.
+  void undo(std::size_t mark);
+  /// Joins the types @paths leave behind, each starting from the current
+  /// state, into the current state.
+  void join_paths(const vector<Delta>& paths);
+
+  static StaticType arithmetic_type(StaticType left, StaticType right);
+};
+
+} // namespace slang
+
+#endif // !__SLANG_TYPE_INFERRER_HPP__
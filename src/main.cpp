@@ -1,10 +1,30 @@
+#include <cstring>
+
 #include "Slang.hpp"
 #include "Token.hpp"
 
 int main (int argc, char *argv[]) {
   slang::Slang slang;
 
-  if (argc > 2) {
+  if (argc == 3 && 0 == std::strcmp(argv[1], "--type-report")) {
+    return slang.report_types(argv[2]);
+  } else if (argc == 4 && 0 == std::strcmp(argv[1], "--emit-cpp")) {
+    return slang.emit_cpp(argv[2], argv[3]);
+  } else if (argc == 3 && 0 == std::strcmp(argv[1], "--bench-scanner")) {
+    return slang.bench_scanner(argv[2]);
+  } else if (argc == 3 && 0 == std::strcmp(argv[1], "--bench-isolates")) {
+    return slang.bench_isolates(argv[2]);
+  } else if (argc == 4 && 0 == std::strcmp(argv[1], "--save-image")) {
+    return slang.save_image(argv[2], argv[3]);
+  } else if (argc == 3 && 0 == std::strcmp(argv[1], "--image")) {
+    return slang.run_image(argv[2]);
+  } else if (argc == 4 && 0 == std::strcmp(argv[1], "--workers")) {
+    return slang.run_workers(argv[3], argv[2]);
+  } else if (argc == 3 && 0 == std::strcmp(argv[1], "--lazy")) {
+    return slang.run_file(argv[2], true);
+  } else if (argc == 2 && 0 == std::strcmp(argv[1], "-")) {
+    return slang.run_stdin();
+  } else if (argc > 2) {
     return 64;
   } else if (argc == 2) {
     return slang.run_file(argv[1]);
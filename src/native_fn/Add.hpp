@@ -0,0 +1,45 @@
+#ifndef __SLANG_NATIVE_ADD_HPP__
+#define __SLANG_NATIVE_ADD_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `add(left, right)`, a new array of the sums of the elements of
+/// two arrays of the same length.
+class Add : public ICallable {
+public:
+  Add() = default;
+  Add(Add &&) = default;
+  Add(const Add &) = default;
+  Add &operator=(Add &&) = default;
+  Add &operator=(const Add &) = default;
+  ~Add() = default;
+
+  size_t arity() override { return 2; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    auto left = std::get_if<std::shared_ptr<SlangArray>>(&args[0]);
+    auto right = std::get_if<std::shared_ptr<SlangArray>>(&args[1]);
+    if (left != nullptr && right != nullptr) {
+      return (*left)->add(**right);
+    }
+
+    throw NativeError("Can only add two arrays.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Add>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_ADD_HPP__
@@ -0,0 +1,45 @@
+#ifndef __SLANG_NATIVE_DOT_HPP__
+#define __SLANG_NATIVE_DOT_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `dot(left, right)`, the sum of the products of the elements of
+/// two arrays of the same length.
+class Dot : public ICallable {
+public:
+  Dot() = default;
+  Dot(Dot &&) = default;
+  Dot(const Dot &) = default;
+  Dot &operator=(Dot &&) = default;
+  Dot &operator=(const Dot &) = default;
+  ~Dot() = default;
+
+  size_t arity() override { return 2; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    auto left = std::get_if<std::shared_ptr<SlangArray>>(&args[0]);
+    auto right = std::get_if<std::shared_ptr<SlangArray>>(&args[1]);
+    if (left != nullptr && right != nullptr) {
+      return (*left)->dot(**right);
+    }
+
+    throw NativeError("Can only take the dot product of two arrays.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Dot>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_DOT_HPP__
@@ -0,0 +1,45 @@
+#ifndef __SLANG_NATIVE_FILTER_HPP__
+#define __SLANG_NATIVE_FILTER_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `filter(array, mask)`, a new array of the elements of @array whose
+/// element of the int64 array @mask is not 0.
+class Filter : public ICallable {
+public:
+  Filter() = default;
+  Filter(Filter &&) = default;
+  Filter(const Filter &) = default;
+  Filter &operator=(Filter &&) = default;
+  Filter &operator=(const Filter &) = default;
+  ~Filter() = default;
+
+  size_t arity() override { return 2; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    auto left = std::get_if<std::shared_ptr<SlangArray>>(&args[0]);
+    auto right = std::get_if<std::shared_ptr<SlangArray>>(&args[1]);
+    if (left != nullptr && right != nullptr) {
+      return (*left)->filter(**right);
+    }
+
+    throw NativeError("Can only filter an array by an array.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Filter>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_FILTER_HPP__
@@ -0,0 +1,38 @@
+#ifndef __SLANG_NATIVE_FLOAT64_ARRAY_HPP__
+#define __SLANG_NATIVE_FLOAT64_ARRAY_HPP__
+
+#include "../ICallable.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `float64_array(source)`, an array of doubles, either @source zeros
+/// or the numbers of the list @source.
+class Float64Array : public ICallable {
+public:
+  Float64Array() = default;
+  Float64Array(Float64Array &&) = default;
+  Float64Array(const Float64Array &) = default;
+  Float64Array &operator=(Float64Array &&) = default;
+  Float64Array &operator=(const Float64Array &) = default;
+  ~Float64Array() = default;
+
+  size_t arity() override { return 1; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    return SlangArray::make(SlangArray::FLOAT64, args[0]);
+  }
+
+  std::string to_string() const override {
+    return "<native fn Float64Array>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_FLOAT64_ARRAY_HPP__
@@ -0,0 +1,39 @@
+#ifndef __SLANG_NATIVE_FLUSH_HPP__
+#define __SLANG_NATIVE_FLUSH_HPP__
+
+#include "../ICallable.hpp"
+#include "../Interpreter.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// Writes out what the script printed so far,
+/// for the "explicit" SLANG_OUTPUT_FLUSH policy.
+class Flush : public ICallable {
+public:
+  Flush() = default;
+  Flush(Flush &&) = default;
+  Flush(const Flush &) = default;
+  Flush &operator=(Flush &&) = default;
+  Flush &operator=(const Flush &) = default;
+  ~Flush() = default;
+
+  size_t arity() override { return 0; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)args;
+    interpreter.output().flush();
+    return nullptr;
+  }
+
+  std::string to_string() const override {
+    return "<native fn Flush>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_FLUSH_HPP__
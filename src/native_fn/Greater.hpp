@@ -0,0 +1,43 @@
+#ifndef __SLANG_NATIVE_GREATER_HPP__
+#define __SLANG_NATIVE_GREATER_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `greater(array, bound)`, an int64 array with 1 for the elements of @array
+/// greater than @bound and 0 for the others.
+class Greater : public ICallable {
+public:
+  Greater() = default;
+  Greater(Greater &&) = default;
+  Greater(const Greater &) = default;
+  Greater &operator=(Greater &&) = default;
+  Greater &operator=(const Greater &) = default;
+  ~Greater() = default;
+
+  size_t arity() override { return 2; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&args[0])) {
+      return (*array)->greater(args[1]);
+    }
+
+    throw NativeError("Can only compare the elements of an array.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Greater>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_GREATER_HPP__
@@ -0,0 +1,46 @@
+#ifndef __SLANG_NATIVE_HAS_HPP__
+#define __SLANG_NATIVE_HAS_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangMap.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `has(map, key)`, whether @map has @key.
+class Has : public ICallable {
+public:
+  Has() = default;
+  Has(Has &&) = default;
+  Has(const Has &) = default;
+  Has &operator=(Has &&) = default;
+  Has &operator=(const Has &) = default;
+  ~Has() = default;
+
+  size_t arity() override { return 2; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto map = std::get_if<std::shared_ptr<SlangMap>>(&args[0])) {
+      if (!SlangMap::is_key(args[1])) {
+        throw NativeError("Map keys can not be NaN.");
+      }
+
+      return (*map)->has(args[1]);
+    }
+
+    throw NativeError("Can only look up keys in a map.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Has>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_HAS_HPP__
@@ -0,0 +1,38 @@
+#ifndef __SLANG_NATIVE_INT64_ARRAY_HPP__
+#define __SLANG_NATIVE_INT64_ARRAY_HPP__
+
+#include "../ICallable.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `int64_array(source)`, an array of integers, either @source zeros
+/// or the numbers of the list @source.
+class Int64Array : public ICallable {
+public:
+  Int64Array() = default;
+  Int64Array(Int64Array &&) = default;
+  Int64Array(const Int64Array &) = default;
+  Int64Array &operator=(Int64Array &&) = default;
+  Int64Array &operator=(const Int64Array &) = default;
+  ~Int64Array() = default;
+
+  size_t arity() override { return 1; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    return SlangArray::make(SlangArray::INT64, args[0]);
+  }
+
+  std::string to_string() const override {
+    return "<native fn Int64Array>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_INT64_ARRAY_HPP__
@@ -0,0 +1,43 @@
+#ifndef __SLANG_NATIVE_KEYS_HPP__
+#define __SLANG_NATIVE_KEYS_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangList.hpp"
+#include "../SlangMap.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `keys(map)`, a list of the keys of @map in insertion order.
+class Keys : public ICallable {
+public:
+  Keys() = default;
+  Keys(Keys &&) = default;
+  Keys(const Keys &) = default;
+  Keys &operator=(Keys &&) = default;
+  Keys &operator=(const Keys &) = default;
+  ~Keys() = default;
+
+  size_t arity() override { return 1; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto map = std::get_if<std::shared_ptr<SlangMap>>(&args[0])) {
+      return std::make_shared<SlangList>((*map)->keys());
+    }
+
+    throw NativeError("Can only take the keys of a map.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Keys>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_KEYS_HPP__
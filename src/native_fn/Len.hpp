@@ -0,0 +1,51 @@
+#ifndef __SLANG_NATIVE_LEN_HPP__
+#define __SLANG_NATIVE_LEN_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+#include "../SlangList.hpp"
+#include "../SlangMap.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `len(value)`, the number of elements of a list or an array,
+/// of entries of a map or of bytes of a string.
+class Len : public ICallable {
+public:
+  Len() = default;
+  Len(Len &&) = default;
+  Len(const Len &) = default;
+  Len &operator=(Len &&) = default;
+  Len &operator=(const Len &) = default;
+  ~Len() = default;
+
+  size_t arity() override { return 1; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto list = std::get_if<std::shared_ptr<SlangList>>(&args[0])) {
+      return static_cast<std::int64_t>((*list)->size());
+    } else if (auto map = std::get_if<std::shared_ptr<SlangMap>>(&args[0])) {
+      return static_cast<std::int64_t>((*map)->size());
+    } else if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&args[0])) {
+      return static_cast<std::int64_t>((*array)->size());
+    } else if (auto str = std::get_if<SlangString>(&args[0])) {
+      return static_cast<std::int64_t>(str->size());
+    }
+
+    throw NativeError("Can only take the length of lists, maps, arrays and strings.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Len>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_LEN_HPP__
@@ -0,0 +1,43 @@
+#ifndef __SLANG_NATIVE_LESS_HPP__
+#define __SLANG_NATIVE_LESS_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `less(array, bound)`, an int64 array with 1 for the elements of @array
+/// less than @bound and 0 for the others.
+class Less : public ICallable {
+public:
+  Less() = default;
+  Less(Less &&) = default;
+  Less(const Less &) = default;
+  Less &operator=(Less &&) = default;
+  Less &operator=(const Less &) = default;
+  ~Less() = default;
+
+  size_t arity() override { return 2; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&args[0])) {
+      return (*array)->less(args[1]);
+    }
+
+    throw NativeError("Can only compare the elements of an array.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Less>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_LESS_HPP__
@@ -0,0 +1,42 @@
+#ifndef __SLANG_NATIVE_MAX_HPP__
+#define __SLANG_NATIVE_MAX_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `max(array)`, the largest element of @array.
+class Max : public ICallable {
+public:
+  Max() = default;
+  Max(Max &&) = default;
+  Max(const Max &) = default;
+  Max &operator=(Max &&) = default;
+  Max &operator=(const Max &) = default;
+  ~Max() = default;
+
+  size_t arity() override { return 1; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&args[0])) {
+      return (*array)->max();
+    }
+
+    throw NativeError("Can only take the maximum of an array.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Max>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_MAX_HPP__
@@ -0,0 +1,42 @@
+#ifndef __SLANG_NATIVE_MIN_HPP__
+#define __SLANG_NATIVE_MIN_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `min(array)`, the smallest element of @array.
+class Min : public ICallable {
+public:
+  Min() = default;
+  Min(Min &&) = default;
+  Min(const Min &) = default;
+  Min &operator=(Min &&) = default;
+  Min &operator=(const Min &) = default;
+  ~Min() = default;
+
+  size_t arity() override { return 1; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&args[0])) {
+      return (*array)->min();
+    }
+
+    throw NativeError("Can only take the minimum of an array.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Min>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_MIN_HPP__
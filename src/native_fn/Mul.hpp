@@ -0,0 +1,45 @@
+#ifndef __SLANG_NATIVE_MUL_HPP__
+#define __SLANG_NATIVE_MUL_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `mul(left, right)`, a new array of the products of the elements of
+/// two arrays of the same length.
+class Mul : public ICallable {
+public:
+  Mul() = default;
+  Mul(Mul &&) = default;
+  Mul(const Mul &) = default;
+  Mul &operator=(Mul &&) = default;
+  Mul &operator=(const Mul &) = default;
+  ~Mul() = default;
+
+  size_t arity() override { return 2; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    auto left = std::get_if<std::shared_ptr<SlangArray>>(&args[0]);
+    auto right = std::get_if<std::shared_ptr<SlangArray>>(&args[1]);
+    if (left != nullptr && right != nullptr) {
+      return (*left)->mul(**right);
+    }
+
+    throw NativeError("Can only multiply two arrays.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Mul>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_MUL_HPP__
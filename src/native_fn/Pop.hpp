@@ -0,0 +1,42 @@
+#ifndef __SLANG_NATIVE_POP_HPP__
+#define __SLANG_NATIVE_POP_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangList.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `pop(list)`, removes the last element of @list and returns it.
+class Pop : public ICallable {
+public:
+  Pop() = default;
+  Pop(Pop &&) = default;
+  Pop(const Pop &) = default;
+  Pop &operator=(Pop &&) = default;
+  Pop &operator=(const Pop &) = default;
+  ~Pop() = default;
+
+  size_t arity() override { return 1; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto list = std::get_if<std::shared_ptr<SlangList>>(&args[0])) {
+      return (*list)->pop();
+    }
+
+    throw NativeError("Can only pop from a list.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Pop>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_POP_HPP__
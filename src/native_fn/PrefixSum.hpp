@@ -0,0 +1,42 @@
+#ifndef __SLANG_NATIVE_PREFIX_SUM_HPP__
+#define __SLANG_NATIVE_PREFIX_SUM_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `prefix_sum(array)`, a new array of the running totals of @array.
+class PrefixSum : public ICallable {
+public:
+  PrefixSum() = default;
+  PrefixSum(PrefixSum &&) = default;
+  PrefixSum(const PrefixSum &) = default;
+  PrefixSum &operator=(PrefixSum &&) = default;
+  PrefixSum &operator=(const PrefixSum &) = default;
+  ~PrefixSum() = default;
+
+  size_t arity() override { return 1; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&args[0])) {
+      return (*array)->prefix_sum();
+    }
+
+    throw NativeError("Can only take the prefix sum of an array.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn PrefixSum>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_PREFIX_SUM_HPP__
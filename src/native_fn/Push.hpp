@@ -0,0 +1,43 @@
+#ifndef __SLANG_NATIVE_PUSH_HPP__
+#define __SLANG_NATIVE_PUSH_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangList.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `push(list, value)`, appends @value to the end of @list.
+class Push : public ICallable {
+public:
+  Push() = default;
+  Push(Push &&) = default;
+  Push(const Push &) = default;
+  Push &operator=(Push &&) = default;
+  Push &operator=(const Push &) = default;
+  ~Push() = default;
+
+  size_t arity() override { return 2; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto list = std::get_if<std::shared_ptr<SlangList>>(&args[0])) {
+      (*list)->push(args[1]);
+      return nullptr;
+    }
+
+    throw NativeError("Can only push to a list.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Push>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_PUSH_HPP__
@@ -0,0 +1,47 @@
+#ifndef __SLANG_NATIVE_REMOVE_HPP__
+#define __SLANG_NATIVE_REMOVE_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangMap.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `remove(map, key)`, removes @key from @map and returns its value,
+/// none if there was no such key.
+class Remove : public ICallable {
+public:
+  Remove() = default;
+  Remove(Remove &&) = default;
+  Remove(const Remove &) = default;
+  Remove &operator=(Remove &&) = default;
+  Remove &operator=(const Remove &) = default;
+  ~Remove() = default;
+
+  size_t arity() override { return 2; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto map = std::get_if<std::shared_ptr<SlangMap>>(&args[0])) {
+      if (!SlangMap::is_key(args[1])) {
+        throw NativeError("Map keys can not be NaN.");
+      }
+
+      return (*map)->remove(args[1]);
+    }
+
+    throw NativeError("Can only remove keys from a map.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Remove>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_REMOVE_HPP__
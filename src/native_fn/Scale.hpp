@@ -0,0 +1,42 @@
+#ifndef __SLANG_NATIVE_SCALE_HPP__
+#define __SLANG_NATIVE_SCALE_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `scale(array, factor)`, a new array of the elements of @array times @factor.
+class Scale : public ICallable {
+public:
+  Scale() = default;
+  Scale(Scale &&) = default;
+  Scale(const Scale &) = default;
+  Scale &operator=(Scale &&) = default;
+  Scale &operator=(const Scale &) = default;
+  ~Scale() = default;
+
+  size_t arity() override { return 2; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&args[0])) {
+      return (*array)->scale(args[1]);
+    }
+
+    throw NativeError("Can only scale an array.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Scale>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_SCALE_HPP__
@@ -0,0 +1,42 @@
+#ifndef __SLANG_NATIVE_SUM_HPP__
+#define __SLANG_NATIVE_SUM_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangArray.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `sum(array)`, the sum of the elements of @array.
+class Sum : public ICallable {
+public:
+  Sum() = default;
+  Sum(Sum &&) = default;
+  Sum(const Sum &) = default;
+  Sum &operator=(Sum &&) = default;
+  Sum &operator=(const Sum &) = default;
+  ~Sum() = default;
+
+  size_t arity() override { return 1; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto array = std::get_if<std::shared_ptr<SlangArray>>(&args[0])) {
+      return (*array)->sum();
+    }
+
+    throw NativeError("Can only sum an array.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Sum>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_SUM_HPP__
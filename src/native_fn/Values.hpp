@@ -0,0 +1,43 @@
+#ifndef __SLANG_NATIVE_VALUES_HPP__
+#define __SLANG_NATIVE_VALUES_HPP__
+
+#include "../ICallable.hpp"
+#include "../InterpreterExceptions.hpp"
+#include "../SlangList.hpp"
+#include "../SlangMap.hpp"
+
+namespace slang {
+
+namespace native_fn {
+
+/// `values(map)`, a list of the values of @map in insertion order.
+class Values : public ICallable {
+public:
+  Values() = default;
+  Values(Values &&) = default;
+  Values(const Values &) = default;
+  Values &operator=(Values &&) = default;
+  Values &operator=(const Values &) = default;
+  ~Values() = default;
+
+  size_t arity() override { return 1; }
+
+  Object call(Interpreter &interpreter, std::vector<Object> &args) override {
+    (void)interpreter;
+    if (auto map = std::get_if<std::shared_ptr<SlangMap>>(&args[0])) {
+      return std::make_shared<SlangList>((*map)->values());
+    }
+
+    throw NativeError("Can only take the values of a map.");
+  }
+
+  std::string to_string() const override {
+    return "<native fn Values>";
+  }
+};
+
+} // namespace slang
+
+} // namespace slang
+
+#endif // !__SLANG_NATIVE_VALUES_HPP__
@@ -88,7 +88,7 @@ def define_type(header_file: io.TextIOWrapper, base_name: str, class_name: str,
 
 def define_ast(output_dir: str, base_name: str, 
                includes_std: list[str], includes_user: list[str],
-               types: list[str]) -> None:
+               types: list[str], base_fields: list[str] = []) -> None:
     path = output_dir + "/" + base_name + ".hpp"
 
     with open(path, "w", encoding="UTF-8") as header_file:
@@ -124,6 +124,10 @@ def define_ast(output_dir: str, base_name: str,
         define_boilerplate_methods(header_file, base_name)
         header_file.write("  virtual ~" + base_name + "() = default;\n\n")
         header_file.write("  virtual void accept(IVisitor& visitor) = 0;\n\n")
+        for field in base_fields:
+            header_file.write(f"  {field};\n")
+        if base_fields:
+            header_file.write("\n")
         header_file.write("};\n\n")
 
         # ValueGetter
@@ -149,7 +153,7 @@ def main() -> None:
     output_dir = sys.argv[1]
     define_ast(output_dir, "Expr",
         ["memory", "vector"],
-        ["Token.hpp"],
+        ["Token.hpp", "StaticType.hpp"],
         [
         "Assign     with Token name, std::shared_ptr<Expr> value",
         "Binary     with std::shared_ptr<Expr> left, Token oper, std::shared_ptr<Expr> right",
@@ -157,16 +161,25 @@ def main() -> None:
                     "std::vector<std::shared_ptr<Expr>> args",
         "Get        with std::shared_ptr<Expr> object, Token name",
         "Grouping   with std::shared_ptr<Expr> expression",
+        "Index      with std::shared_ptr<Expr> object, Token bracket, std::shared_ptr<Expr> index",
+        "List       with Token bracket, std::vector<std::shared_ptr<Expr>> elements",
         "Literal    with Object value",
         "Logical    with std::shared_ptr<Expr> left, Token oper, std::shared_ptr<Expr> right",
+        "Map        with Token brace, std::vector<std::shared_ptr<Expr>> keys, " +
+                    "std::vector<std::shared_ptr<Expr>> values",
         "Set        with std::shared_ptr<Expr> object, Token name, std::shared_ptr<Expr> value",
+        "SetIndex   with std::shared_ptr<Expr> object, Token bracket, " +
+                    "std::shared_ptr<Expr> index, std::shared_ptr<Expr> value",
+        "Slice      with std::shared_ptr<Expr> object, Token bracket, " +
+                    "std::shared_ptr<Expr> start, std::shared_ptr<Expr> end",
         "Unary      with Token oper, std::shared_ptr<Expr> right",
         "Variable   with Token name"
-        ])
+        ],
+        ["StaticType m_static_type{TYPE_ANY}"])
 
     define_ast(output_dir, "Stmt", 
         ["memory", "vector"],
-        ["Token.hpp", "Expr.hpp"],
+        ["Token.hpp", "Expr.hpp", "LazyBody.hpp"],
         [
         "Block      with std::vector<std::shared_ptr<Stmt>> statements",
         "Class      with Token name, std::vector<std::shared_ptr<stmt::Fn>> methods",
@@ -175,8 +188,10 @@ def main() -> None:
         "If         with std::shared_ptr<expr::Expr> condition, " + 
                     "std::shared_ptr<Stmt> then_branch, " +
                     "std::shared_ptr<Stmt> else_branch",
+        "Import     with Token keyword, Token path",
         "Fn         with Token name, std::vector<Token> params, " +
-                    "std::vector<std::shared_ptr<Stmt>> body",
+                    "std::vector<std::shared_ptr<Stmt>> body, " +
+                    "std::shared_ptr<LazyBody> lazy_body",
         "Print      with std::shared_ptr<expr::Expr> expression",
         "Return     with Token keyword, std::shared_ptr<expr::Expr> value",
         "Var        with Token name, std::shared_ptr<expr::Expr> initializer",